@@ -42,13 +42,75 @@
 extern "C" {
 #endif
 
+#include "ldl_platform.h"
+
 #include <stdint.h>
+#include <stdbool.h>
+
+struct ldl_aes_ctx;
+
+/** Block cipher backend
+ *
+ * A backend takes over the block encryption normally performed by
+ * LDL_AES_encrypt(). Since everything in @ref ldl_crypto (and therefore
+ * the default @ref ldl_tsm) encrypts through LDL_AES_encrypt(), this
+ * is how a hardware AES engine can be used without reimplementing
+ * @ref ldl_tsm.
+ *
+ * A backend is selected by defining #LDL_AES_BACKEND.
+ *
+ * */
+struct ldl_aes_backend {
 
-/** AES state */
+    /** Prepare backend to encrypt with the key in ctx
+     *
+     * Called by LDL_AES_init() after the key schedule has been
+     * expanded. The first 16 bytes of #ldl_aes_ctx.k are the key.
+     *
+     * @param[in] ctx
+     *
+     * @retval true     backend will encrypt for this ctx
+     * @retval false    backend is not available (portable implementation will be used)
+     *
+     * */
+    bool (*init)(struct ldl_aes_ctx *ctx);
+
+    /** Encrypt a block of data
+     *
+     * @param[in] ctx
+     * @param[in] s pointer to 16 byte block of data (any alignment)
+     *
+     * */
+    void (*encrypt)(const struct ldl_aes_ctx *ctx, void *s);
+
+    /** Encrypt n consecutive blocks of data
+     *
+     * **OPTIONAL** (may be NULL). Backends that can work on more
+     * than one block at a time (e.g. by interleaving blocks or
+     * queueing them to a DMA engine) should implement this.
+     *
+     * @param[in] ctx
+     * @param[in] s pointer to n x 16 byte blocks of data (any alignment)
+     * @param[in] n number of blocks
+     *
+     * */
+    void (*encrypt_blocks)(const struct ldl_aes_ctx *ctx, void *s, uint8_t n);
+};
+
+/** AES state
+ *
+ * Only AES-128 is used by LoRaWAN so the key schedule
+ * is sized for 11 round keys.
+ *
+ * */
 struct ldl_aes_ctx {
 
-    uint8_t k[240U];
+    uint8_t k[176U];
     uint8_t r;
+#ifdef LDL_AES_BACKEND
+    /* NULL if the portable implementation is used */
+    const struct ldl_aes_backend *backend;
+#endif
 };
 
 /** Initialise AES block cipher
@@ -67,6 +129,18 @@ void LDL_AES_init(struct ldl_aes_ctx *ctx, const void *key);
  * */
 void LDL_AES_encrypt(const struct ldl_aes_ctx *ctx, void *s);
 
+/** Encrypt consecutive blocks of data
+ *
+ * Same as calling LDL_AES_encrypt() for each block except
+ * a #ldl_aes_backend may be able to do it faster.
+ *
+ * @param[in] ctx state previously initialised by LDL_AES_init()
+ * @param[in] s pointer to n x 16 byte blocks of data (any alignment)
+ * @param[in] n number of blocks
+ *
+ * */
+void LDL_AES_encryptBlocks(const struct ldl_aes_ctx *ctx, void *s, uint8_t n);
+
 /** Decrypt a block of data
  *
  * @param[in] ctx state previously initialised by LDL_AES_init()
@@ -75,6 +149,18 @@ void LDL_AES_encrypt(const struct ldl_aes_ctx *ctx, void *s);
  * */
 void LDL_AES_decrypt(const struct ldl_aes_ctx *ctx, void *s);
 
+/** Get the AES-NI backend
+ *
+ * The backend uses AES-NI instructions if the host supports
+ * them, otherwise it defers to the portable implementation.
+ *
+ * Only available if #LDL_ENABLE_AES_NI is defined.
+ *
+ * @return #ldl_aes_backend
+ *
+ * */
+const struct ldl_aes_backend *LDL_AES_NI_getBackend(void);
+
 #ifdef __cplusplus
 }
 #endif
@@ -33,6 +33,7 @@
  * - #ldl_chip_set_mode_fn
  * - #ldl_chip_write_fn
  * - #ldl_chip_read_fn
+ * - #ldl_chip_submit_fn (optional, see #LDL_ENABLE_CHIP_ASYNC)
  *
  * Implementations of these functions must be assigned to the radio
  * driver during initialisation. Use the examples in the function pointer
@@ -156,6 +157,55 @@ typedef bool (*ldl_chip_write_fn)(void *self, const void *opcode, size_t opcode_
  * */
 typedef bool (*ldl_chip_read_fn)(void *self, const void *opcode, size_t opcode_size, void *data, size_t size);
 
+/** One write transaction for #ldl_chip_submit_fn
+ *
+ * Same as one call to #ldl_chip_write_fn.
+ *
+ * */
+struct ldl_chip_transfer {
+
+    const void *opcode;     /**< opcode data that must be written */
+    size_t opcode_size;     /**< size of opcode data */
+    const void *data;       /**< buffer to write (may be NULL if size is zero) */
+    size_t size;            /**< size of buffer in bytes */
+};
+
+/** Called by the chip interface when a submission has finished
+ *
+ * @param[in] ctx   ctx that was passed to #ldl_chip_submit_fn
+ * @param[in] ok    false if a transfer could not be completed (e.g. chip still busy after timeout)
+ *
+ * */
+typedef void (*ldl_chip_complete_fn)(void *ctx, bool ok);
+
+/** Start a list of write transactions without waiting for them to complete
+ *
+ * @param[in] self
+ * @param[in] transfer  list of transfers
+ * @param[in] count     number of transfers in list
+ * @param[in] cb        call this when finished
+ * @param[in] ctx       pass this to cb
+ *
+ * @retval true     cb will be called
+ * @retval false    cannot accept the submission (cb will not be called)
+ *
+ * Only used when #LDL_ENABLE_CHIP_ASYNC is defined.
+ *
+ * Transfers must be performed in order, each one as if
+ * #ldl_chip_write_fn had been called. If a transfer fails the
+ * remainder can be abandoned. cb is typically called from the SPI DMA
+ * interrupt and must be called exactly once.
+ *
+ * The list and every buffer it points to remain valid until cb
+ * is called.
+ *
+ * #ldl_chip_write_fn and #ldl_chip_read_fn may still be called
+ * while a submission is outstanding. These must wait for the
+ * outstanding submission to complete before accessing the chip.
+ *
+ * */
+typedef bool (*ldl_chip_submit_fn)(void *self, const struct ldl_chip_transfer *transfer, size_t count, ldl_chip_complete_fn cb, void *ctx);
+
 #ifdef __cplusplus
 }
 #endif
@@ -47,7 +47,7 @@ struct ldl_aes_ctx;
  * @param[in] len   size of input
  *
  * */
-void LDL_CTR_encrypt(struct ldl_aes_ctx *ctx, const void *iv, const void *in, void *out, uint8_t len);
+void LDL_CTR_encrypt(const struct ldl_aes_ctx *ctx, const void *iv, const void *in, void *out, uint8_t len);
 
 #ifdef __cplusplus
 }
@@ -150,7 +150,8 @@ enum ldl_mac_sme {
     LDL_SME_TIMER_A,
     LDL_SME_TIMER_B,
     LDL_SME_INTERRUPT,
-    LDL_SME_BAND
+    LDL_SME_BAND,
+    LDL_SME_MIC
 };
 
 /** MAC state */
@@ -178,7 +179,9 @@ enum ldl_mac_state {
     LDL_STATE_START_RADIO_FOR_RX2,     /**< waiting for second RX window */
     LDL_STATE_RX2,          /**< second RX window */
 
-    LDL_STATE_RX2_LOCKOUT  /**< used to ensure an out of range RX2 window is not clobbered */
+    LDL_STATE_RX2_LOCKOUT,  /**< used to ensure an out of range RX2 window is not clobbered */
+
+    LDL_STATE_WAIT_MIC      /**< waiting for SM to calculate MIC of a downlink received in RX2 */
 
 };
 
@@ -319,12 +322,31 @@ enum ldl_band_index {
     LDL_BAND_MAX
 };
 
+/* ticks as kept by MAC timers
+ *
+ * 64 bit with LDL_ENABLE_TICKS_64 so that timers never wrap
+ * */
+#ifdef LDL_ENABLE_TICKS_64
+typedef uint64_t ldl_ticks_t;
+#else
+typedef uint32_t ldl_ticks_t;
+#endif
+
 struct ldl_timer {
 
-    uint32_t time;
+    ldl_ticks_t time;
     bool armed;
 };
 
+#ifdef LDL_ENABLE_TICKS_64
+/* extends ldl_mac_init_arg.ticks to 64 bits */
+struct ldl_mac_clock {
+
+    uint32_t low;       /* ticks when last read */
+    uint32_t high;      /* number of times ticks had wrapped */
+};
+#endif
+
 struct ldl_input {
 
     bool armed;
@@ -332,17 +354,54 @@ struct ldl_input {
     uint32_t time;
 };
 
+/* state of an outstanding ldl_sm_interface.begin_mic */
+struct ldl_mic_input {
+
+    bool busy;      /* SM has not called back yet */
+    bool wanted;    /* result is still relevant */
+    bool state;     /* result is waiting in mic */
+    uint32_t mic;
+    uint8_t len;    /* size of frame in rx_buffer */
+};
+
 struct ldl_mac_channel {
 
     uint32_t freqAndRate;
     uint32_t dlFreq;
 };
 
+/* 'time' timebase derived from ticks
+ *
+ * only brought up to date when a deadline is set or has passed
+ * */
 struct ldl_mac_time {
 
-    uint32_t ticks;
-    uint32_t remainder;
-    bool parked;
+    ldl_ticks_t ticks;  /* ticks at which 'now' was last updated */
+    uint32_t remainder; /* ticks not yet accounted for in 'now' */
+    uint32_t now;       /* free running; wraps */
+};
+
+/* LoRa timing for the configured tps
+ *
+ * The LoRa symbol period is 2^n microseconds where n is
+ * (SF + 3 - bandwidth) and ranges from 8 (SF7/500KHz) to 15
+ * (SF12/125KHz). Both tables are indexed by (n - 8).
+ *
+ * calculated once by LDL_MAC_init() so that air time, RX window
+ * offsets and conversions between ticks and time need only
+ * multiply-adds
+ * */
+struct ldl_mac_timing {
+
+    uint32_t symbol[8U];    /* symbol period in ticks (rounded down) */
+    uint32_t quarter[8U];   /* quarter symbol period in ticks x 2^shift (rounded up) */
+    uint8_t shift;
+
+#ifndef LDL_PARAM_TPS
+    uint32_t reciprocal;    /* (2^32 - 1) / tps (rounded down) */
+#endif
+    uint32_t ms;            /* ticks per millisecond x 2^msShift (rounded up) */
+    uint8_t msShift;
 };
 
 /** Session cache */
@@ -428,17 +487,29 @@ struct ldl_mac {
     uint8_t buffer[LDL_MAX_PACKET];
     uint8_t bufferLen;
 
-    /* down-counters that use the 'time' timebase
+    /* deadlines in the 'time' timebase
      *
-     * used for duty cycle timing per band among other things */
+     * used for duty cycle timing per band among other things
+     *
+     * zero means the band is free, otherwise the band is free once
+     * 'now' reaches the deadline (compared modulo 2^32)
+     * */
     uint32_t band[LDL_BAND_MAX];
 
-    /* day down-counter used by OTAA to apply duty-cycle reduction
+    /* deadline used by OTAA to apply duty-cycle reduction
      *
-     * 'time' timebase like the band down-counters
+     * 'time' timebase like the band deadlines
      * */
     uint32_t day;
 
+    /* channels that are enabled (unmasked and configured) in each band
+     *
+     * derived from ctx.chMask and ctx.chConfig and updated only when they
+     * change, so that selecting a channel doesn't need to look up
+     * frequencies
+     * */
+    uint8_t band_channels[LDL_BAND_GLOBAL][72U / 8U];
+
     /* 32bit to detect 16bit overflow */
     uint32_t devNonce;
     uint32_t joinNonce;
@@ -456,8 +527,14 @@ struct ldl_mac {
     struct ldl_sm *sm;
     struct ldl_radio *radio;
     struct ldl_input inputs;
+#ifdef LDL_ENABLE_SM_ASYNC
+    struct ldl_mic_input mic_inputs;
+#endif
     struct ldl_timer timers[LDL_TIMER_MAX];
 
+    /* soonest of the armed timers (updated whenever one changes) */
+    struct ldl_timer earliest;
+
     const struct ldl_sm_interface *sm_interface;
     const struct ldl_radio_interface *radio_interface;
 
@@ -469,6 +546,8 @@ struct ldl_mac {
 
     struct ldl_mac_time time;
 
+    struct ldl_mac_timing timing;
+
 #ifndef LDL_DISABLE_DEVICE_TIME
     /* used to provide precise time sync */
     uint32_t ticks_at_tx;
@@ -485,6 +564,11 @@ struct ldl_mac {
     ldl_system_ticks_fn ticks;
     ldl_system_get_battery_level_fn get_battery_level;
 
+#ifdef LDL_ENABLE_TICKS_64
+    ldl_system_ticks64_fn ticks64;
+    struct ldl_mac_clock clock;
+#endif
+
     bool fPending;
 
 #ifndef LDL_PARAM_TPS
@@ -569,6 +653,18 @@ struct ldl_mac_init_arg {
      * */
     ldl_system_ticks_fn ticks;
 
+#ifdef LDL_ENABLE_TICKS_64
+    /** system interface for getting 64 bit ticks
+     *
+     * Leave this field NULL to have #ldl_mac_init_arg.ticks extended
+     * to 64 bits. If set, #ldl_mac_init_arg.ticks may be left NULL.
+     *
+     * Only used if LDL_ENABLE_TICKS_64 is defined.
+     *
+     * */
+    ldl_system_ticks64_fn ticks64;
+#endif
+
     /** System interface for getting battery level
      *
      * Leave this field NULL to use the default implementation.
@@ -1021,16 +1117,44 @@ uint8_t LDL_MAC_getMaxDCycle(const struct ldl_mac *self);
  * This can be used by an application to ensure long-running tasks
  * do not cause LDL to miss important events.
  *
+ * Time sensitive events are the radio interrupts that end TX and
+ * the RX windows, and the timers that open the RX windows.
+ *
  * @param[in] self      #ldl_mac
  * @param[in] interval  seconds
  *
+ * @retval true     an event is due within interval
+ * @retval false    no event is due within interval
  *
- * @retval true
- * @retval false
+ * @see LDL_MAC_priorityDeadline()
+ *
+ * @note interrupt safe if LDL_SYSTEM_ENTER_CRITICAL() and LDL_SYSTEM_ENTER_CRITICAL() have been defined
  *
  * */
 bool LDL_MAC_priority(const struct ldl_mac *self, uint8_t interval);
 
+/** Get the system ticks at which the next time sensitive event is due
+ *
+ * Long-running tasks that finish before this deadline will not
+ * cause LDL to miss an event.
+ *
+ * The deadline is in the same timebase as LDL_MAC_getTicks(). It is
+ * the current ticks if LDL is waiting on a radio interrupt, and
+ * may be in the past if LDL_MAC_process() is overdue.
+ *
+ * @param[in] self      #ldl_mac
+ * @param[out] ticks    system ticks
+ *
+ * @retval true     ticks has been set
+ * @retval false    no time sensitive event is expected
+ *
+ * @see LDL_MAC_priority()
+ *
+ * @note interrupt safe if LDL_SYSTEM_ENTER_CRITICAL() and LDL_SYSTEM_ENTER_CRITICAL() have been defined
+ *
+ * */
+bool LDL_MAC_priorityDeadline(const struct ldl_mac *self, uint32_t *ticks);
+
 /** Radio calls this function to notify MAC that an event has occurred.
  *
  * Normally this will happen via the function pointer set as an
@@ -1056,6 +1180,20 @@ void LDL_MAC_radioEvent(struct ldl_mac *self);
  * */
 void LDL_MAC_radioEventWithTicks(struct ldl_mac *self, uint32_t ticks);
 
+#ifdef LDL_ENABLE_SM_ASYNC
+/** Security Module calls this function to complete #ldl_sm_interface.begin_mic
+ *
+ * This function is passed to #ldl_sm_interface.begin_mic as an #ldl_sm_mic_fn.
+ *
+ * @param[in] self      #ldl_mac
+ * @param[in] mic       result
+ *
+ * @note interrupt safe if LDL_SYSTEM_ENTER_CRITICAL() and LDL_SYSTEM_ENTER_CRITICAL() have been defined
+ *
+ * */
+void LDL_MAC_micComplete(struct ldl_mac *self, uint32_t mic);
+#endif
+
 /** Get current tick value
  *
  * @param[in] self  #ldl_mac
@@ -32,7 +32,7 @@ enum ldl_timer_inst {
 
     LDL_TIMER_WAITA,    /* general use + RX1 slot timing */
     LDL_TIMER_WAITB,    /* RX2 slot timing */
-    LDL_TIMER_BAND,     /* tracks time used to decrement down counters */
+    LDL_TIMER_BAND,     /* expires when the earliest band deadline passes */
 #ifdef LDL_ENABLE_CLASS_B
     LDL_TIMER_BEACON,   /* beacon tracking */
 #endif
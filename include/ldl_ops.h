@@ -35,6 +35,8 @@
  *
  * */
 
+#include "ldl_sm_internal.h"
+
 #include <stdint.h>
 #include <stdbool.h>
 
@@ -48,16 +50,56 @@ struct ldl_system_identity;
 void LDL_OPS_deriveKeys(struct ldl_mac *self);
 void LDL_OPS_deriveJoinKeys(struct ldl_mac *self);
 
+/* arguments for ldl_sm_interface.mic/begin_mic to check a downlink */
+struct ldl_ops_mic {
+
+    enum ldl_sm_key key;
+    uint8_t hdr[16U];
+    uint8_t hdrLen;
+};
+
 /* decode and verify a frame (depends on ldl_mac state but does not modify directly) */
 bool LDL_OPS_receiveFrame(struct ldl_mac *self, struct ldl_frame_down *f, uint8_t *in, uint8_t len);
 
-/* encode a frame (depends on ldl_mac state but does not modify directly)  */
+/* LDL_OPS_receiveFrame() in two halves so that the MIC can be calculated in between
+ *
+ * LDL_OPS_prepareMIC() decodes the frame (decrypting a join accept in-place) and
+ * returns true if the MIC should be checked.
+ *
+ * LDL_OPS_checkMIC() compares the MIC and decrypts the payload of the frame
+ * decoded by LDL_OPS_prepareMIC() (or decoded again from the same buffer).
+ *
+ * */
+bool LDL_OPS_prepareMIC(struct ldl_mac *self, struct ldl_frame_down *f, uint8_t *in, uint8_t len, struct ldl_ops_mic *arg);
+bool LDL_OPS_checkMIC(struct ldl_mac *self, struct ldl_frame_down *f, uint32_t mic);
+
+/* encode a frame (depends on ldl_mac state but does not modify directly)
+ *
+ * data frames are encrypted and MIC'd here, in a single pass if the SM
+ * implements secure_data
+ *
+ * */
 uint8_t LDL_OPS_prepareData(struct ldl_mac *self, const struct ldl_frame_data *f, uint8_t *out, uint8_t max);
 uint8_t LDL_OPS_prepareJoinRequest(struct ldl_mac *self, const struct ldl_frame_join_request *f, uint8_t *out, uint8_t max);
 
-/* apply MIC to a data frame */
+/* apply MIC to a data frame that is already encrypted */
 void LDL_OPS_micDataFrame(struct ldl_mac *self, void *buffer, uint8_t size);
 
+/* update the MIC of a data frame prepared by LDL_OPS_prepareData() for a retry
+ *
+ * only the part that depends on tx.rate and tx.chIndex is recalculated
+ * (i.e. nothing for LoRaWAN 1.0)
+ *
+ * */
+void LDL_OPS_remicDataFrame(struct ldl_mac *self, void *buffer, uint8_t size);
+
+/* write little endian fields (EUIs are reversed) and return the number of bytes written */
+uint8_t LDL_OPS_putU8(uint8_t *buf, uint8_t value);
+uint8_t LDL_OPS_putU16(uint8_t *buf, uint16_t value);
+uint8_t LDL_OPS_putU24(uint8_t *buf, uint32_t value);
+uint8_t LDL_OPS_putU32(uint8_t *buf, uint32_t value);
+uint8_t LDL_OPS_putEUI(uint8_t *buf, const uint8_t *value);
+
 /* derive expected 32 bit downcounter from 16 least significant bits and update the copy in ldl_mac */
 void LDL_OPS_syncDownCounter(struct ldl_mac *self, uint8_t port, uint16_t counter);
 
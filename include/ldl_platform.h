@@ -176,6 +176,81 @@
     #define LDL_ENABLE_AVR
     #undef  LDL_ENABLE_AVR
 
+    /**
+     * Define to use a word oriented AES implementation
+     *
+     * The default implementation works a byte at a time which suits
+     * 8 bit targets. This option combines sbox and mix columns into
+     * a single 1KB table of 32 bit words which is much faster on 32 bit
+     * targets.
+     *
+     * */
+    #define LDL_ENABLE_AES_TTABLE
+    #undef  LDL_ENABLE_AES_TTABLE
+
+    /**
+     * Define to replace the block cipher used by @ref ldl_crypto
+     *
+     * Must expand to an expression that evaluates to a pointer
+     * to #ldl_aes_backend.
+     *
+     * e.g.
+     *
+     * @code
+     * #define LDL_AES_BACKEND getHardwareAES()
+     * @endcode
+     *
+     * */
+    #define LDL_AES_BACKEND
+    #undef  LDL_AES_BACKEND
+
+    /**
+     * Define to use AES-NI instructions on x86-64 hosts
+     *
+     * Support for AES-NI is checked at run-time and the portable
+     * implementation is used if it isn't available.
+     *
+     * This is useful for speeding up simulations and tests.
+     *
+     * */
+    #define LDL_ENABLE_AES_NI
+    #undef  LDL_ENABLE_AES_NI
+
+    /**
+     * Define to have the default Security Module keep an expanded
+     * AES key schedule and CMAC subkeys for every key it holds.
+     *
+     * Key schedules and subkeys are then only derived when keys change (i.e.
+     * LDL_SM_init() and LDL_SM_updateSessionKey()) rather than on
+     * every cryptographic operation.
+     *
+     * This trades RAM for CPU time. Each key costs an extra 209 bytes
+     * of RAM which comes to 627 bytes for LoRaWAN 1.0.x, and 1672 bytes
+     * for LoRaWAN 1.1. These figures do not include the backend
+     * pointer each key gains when #LDL_AES_BACKEND is defined.
+     *
+     * */
+    #define LDL_ENABLE_SM_KEY_CACHE
+    #undef  LDL_ENABLE_SM_KEY_CACHE
+
+    /**
+     * Define to have the MAC use ldl_sm_interface.begin_mic (if the
+     * Security Module implements it) to check the MIC of downlinks.
+     *
+     * This is for Security Modules backed by an external secure element
+     * where a MIC calculation takes long enough that it would
+     * otherwise block LDL_MAC_process() between RX1 and RX2.
+     *
+     * The SM reports the result by calling LDL_MAC_micComplete().
+     * The RX2 window will still be opened on time if the result of a
+     * frame received in RX1 is outstanding.
+     *
+     * This option implies #LDL_ENABLE_STATIC_RX_BUFFER.
+     *
+     * */
+    #define LDL_ENABLE_SM_ASYNC
+    #undef  LDL_ENABLE_SM_ASYNC
+
     /**
      * Define to apply the proposed change to LoRaWAN 1.1 spec regarding
      * the construction of the A1 block when encrypting Fopts.
@@ -204,6 +279,61 @@
     #define LDL_ENABLE_RADIO_DEBUG
     #undef LDL_ENABLE_RADIO_DEBUG
 
+    /**
+     * Define to put the SX126x into warm start sleep between
+     * operations instead of cold start sleep
+     *
+     * The chip retains its configuration in warm start sleep so the
+     * driver can skip commands that would write the same parameters
+     * again. This shortens the time it takes to start a TX or RX at
+     * the cost of a slightly higher sleep current.
+     *
+     * */
+    #define LDL_ENABLE_SX126X_WARM_SLEEP
+    #undef LDL_ENABLE_SX126X_WARM_SLEEP
+
+    /**
+     * Define to have the radio drivers submit the configuration
+     * written by transmit and receive as one list of transfers through
+     * #ldl_chip_submit_fn instead of one blocking #ldl_chip_write_fn
+     * at a time
+     *
+     * LDL_MAC_process() then returns while the transfers (and the
+     * BUSY waits between them) are carried out by the chip interface,
+     * typically using SPI DMA. The chip interface reports completion
+     * through a callback.
+     *
+     * Drivers fall back to blocking writes if ldl_sx126x_init_arg.chip_submit
+     * or ldl_sx127x_init_arg.chip_submit is NULL, if the previous
+     * submission has not completed, or if the submission is refused.
+     *
+     * The size of the queue can be set with #LDL_CHIP_QUEUE_MAX and
+     * #LDL_CHIP_QUEUE_BUFFER_SIZE.
+     *
+     * */
+    #define LDL_ENABLE_CHIP_ASYNC
+    #undef LDL_ENABLE_CHIP_ASYNC
+
+    /**
+     * Define to keep MAC timers and the band off-time base in 64 bit
+     * ticks
+     *
+     * For tick sources fast enough (e.g. 32MHz) that a 32 bit counter
+     * wraps every few minutes. Timers never wrap and band off-times
+     * longer than INT32_MAX ticks are scheduled in one go rather than
+     * being clamped. tps may be up to 64MHz with this option.
+     *
+     * Set #ldl_mac_init_arg.ticks64 to read a 64 bit counter directly.
+     * Otherwise #ldl_mac_init_arg.ticks is extended to 64 bits by
+     * counting wraps, which requires LDL to read it at least once
+     * per wrap. LDL_MAC_ticksUntilNextEvent() never returns more than
+     * INT32_MAX while an event is pending so applications that sleep
+     * until the next event do this anyway.
+     *
+     * */
+    #define LDL_ENABLE_TICKS_64
+    #undef LDL_ENABLE_TICKS_64
+
     /**
      * Define to set #ldl_mac_init_arg.tps at compile time
      *
@@ -350,6 +480,29 @@
     #define LDL_PARAM_XTAL_DELAY 25
 #endif
 
+#ifndef LDL_CHIP_QUEUE_MAX
+    /**
+     * Define to change the maximum number of transfers a radio driver
+     * can queue for one #ldl_chip_submit_fn when #LDL_ENABLE_CHIP_ASYNC
+     * is defined.
+     *
+     * */
+    #define LDL_CHIP_QUEUE_MAX 16
+#endif
+
+#ifndef LDL_CHIP_QUEUE_BUFFER_SIZE
+    /**
+     * Define to change the number of bytes reserved for copies of
+     * queued opcodes and register values when #LDL_ENABLE_CHIP_ASYNC
+     * is defined.
+     *
+     * A transfer that does not fit is written (after everything
+     * queued before it) using #ldl_chip_write_fn.
+     *
+     * */
+    #define LDL_CHIP_QUEUE_BUFFER_SIZE 96
+#endif
+
 #ifdef LDL_DISABLE_POINTONE
     #error "LDL_DISABLE_POINTONE is depreciated, use LDL_L2_VERSION=LDL_L2_VERSION_1_0_4"
 #endif
@@ -412,6 +565,15 @@
     #define LDL_DISABLE_LINK_CHECK
 #endif
 
+#if defined(LDL_ENABLE_AES_NI) && !defined(LDL_AES_BACKEND)
+    #define LDL_AES_BACKEND LDL_AES_NI_getBackend()
+#endif
+
+#if defined(LDL_ENABLE_SM_ASYNC) && !defined(LDL_ENABLE_STATIC_RX_BUFFER)
+    /* the frame must stay put while the MIC is calculated */
+    #define LDL_ENABLE_STATIC_RX_BUFFER
+#endif
+
 /** @} */
 
 
@@ -192,6 +192,32 @@ struct ldl_sx127x_debug_log {
     bool overflow;
 };
 
+/* registers below this address are shadowed by the SX127x driver */
+#define LDL_SX127X_SHADOW_SIZE 0x50U
+
+#ifdef LDL_ENABLE_CHIP_ASYNC
+/* transfers collected by a driver for one #ldl_chip_submit_fn */
+struct ldl_chip_queue {
+
+    struct ldl_chip_transfer transfer[LDL_CHIP_QUEUE_MAX];
+
+    /* copies of opcodes and small data buffers */
+    uint8_t buffer[LDL_CHIP_QUEUE_BUFFER_SIZE];
+
+    size_t count;
+    size_t used;
+
+    /* writes are being queued */
+    bool open;
+
+    /* set until the chip interface calls back */
+    volatile bool busy;
+
+    /* a submission failed since the driver last checked */
+    volatile bool failed;
+};
+#endif
+
 /** Radio state */
 struct ldl_radio {
 
@@ -204,6 +230,11 @@ struct ldl_radio {
     ldl_chip_read_fn chip_read;
     ldl_chip_set_mode_fn chip_set_mode;
 
+#ifdef LDL_ENABLE_CHIP_ASYNC
+    ldl_chip_submit_fn chip_submit;
+    struct ldl_chip_queue queue;
+#endif
+
     struct ldl_mac *cb_ctx;
     ldl_radio_event_fn cb;
 
@@ -212,6 +243,18 @@ struct ldl_radio {
 #if defined(LDL_ENABLE_SX1272) || defined(LDL_ENABLE_SX1276)
         struct {
             enum ldl_sx127x_pa pa;
+
+            /* register values last written to the chip
+             *
+             * configuration registers are only written when the
+             * value differs or the corresponding valid bit is clear
+             *
+             * */
+            uint8_t shadow[LDL_SX127X_SHADOW_SIZE];
+            uint8_t shadow_valid[LDL_SX127X_SHADOW_SIZE / 8U];
+
+            /* a write has failed since beginTransfers() */
+            bool write_failed;
 #ifdef LDL_ENABLE_RADIO_DEBUG
             struct ldl_sx127x_debug_log debug;
 #endif
@@ -230,6 +273,26 @@ struct ldl_radio {
             uint8_t xta;
             uint8_t xtb;
 
+            /* parameters last written to the chip
+             *
+             * commands are only sent when the parameters differ
+             * or the corresponding valid bit is clear
+             *
+             * */
+            struct {
+
+                uint8_t valid;
+                uint8_t packet_type[1];
+                uint8_t buffer_base_address[2];
+                uint8_t rf_frequency[4];
+                uint8_t modulation_params[4];
+                uint8_t packet_params[6];
+                uint8_t dio_irq_params[8];
+                uint8_t sync_word[4];
+                uint8_t symb_num_timeout[1];
+
+            } shadow;
+
         } sx126x;
 #endif
         /* make sure this still compiles if radios are not enabled*/
@@ -238,6 +301,9 @@ struct ldl_radio {
     } state;
 
     int16_t tx_gain;
+
+    /* set by a successful prepare_transmit and cleared by a change of mode */
+    bool tx_ready;
 };
 
 /** @ref ldl_mac calls non-static radio functions through these function pointers
@@ -320,6 +386,32 @@ struct ldl_radio_interface {
      * */
     void (*get_status)(struct ldl_radio *self, struct ldl_radio_status *status);
 
+    /** Configure radio and load the buffer for a transmission that
+     * will be started later by start_transmit (optional)
+     *
+     * @ref ldl_mac calls this while the XTAL is starting so that
+     * only start_transmit is left for when the TX slot arrives.
+     * transmit is used instead if this or start_transmit is NULL.
+     *
+     * @warning ldl_radio.mode must be LDL_RADIO_MODE_TX
+     *
+     * @param[in] self
+     * @param[in] settings
+     * @param[in] data
+     * @param[in] len
+     *
+     * */
+    void (*prepare_transmit)(struct ldl_radio *self, const struct ldl_radio_tx_setting *settings, const void *data, uint8_t len);
+
+    /** Start the transmission loaded by prepare_transmit (optional)
+     *
+     * @warning ldl_radio.mode must be LDL_RADIO_MODE_TX
+     *
+     * @param[in] self
+     *
+     * */
+    void (*start_transmit)(struct ldl_radio *self);
+
 };
 
 /** Get interface for initialised radio driver
@@ -363,6 +455,29 @@ void LDL_Radio_handleInterrupt(struct ldl_radio *self, uint8_t n);
  * */
 void LDL_Radio_setEventCallback(struct ldl_radio *self, struct ldl_mac *ctx, ldl_radio_event_fn cb);
 
+/* the following are used by the radio drivers
+ *
+ * Writes made between LDL_Radio_beginTransfers() and
+ * LDL_Radio_endTransfers() are submitted together if
+ * #LDL_ENABLE_CHIP_ASYNC is defined, otherwise they are written
+ * one at a time.
+ *
+ * */
+
+/* returns false if a previous submission failed (the chip
+ * configuration is unknown) */
+bool LDL_Radio_beginTransfers(struct ldl_radio *self);
+
+/* submit everything written since LDL_Radio_beginTransfers() */
+void LDL_Radio_endTransfers(struct ldl_radio *self);
+
+/* data is copied if copy is true, otherwise it must remain valid
+ * until the transfer is complete (opcode is always copied) */
+bool LDL_Radio_write(struct ldl_radio *self, const void *opcode, size_t opcode_size, const void *data, size_t size, bool copy);
+
+/* anything queued is written first */
+bool LDL_Radio_read(struct ldl_radio *self, const void *opcode, size_t opcode_size, void *data, size_t size);
+
 /** Get minimum SNR for a given spreading factor
  *
  * @param[in] sf spreading factor
@@ -34,6 +34,8 @@ extern "C" {
 
 #include "ldl_platform.h"
 #include "ldl_sm_internal.h"
+#include "ldl_aes.h"
+#include "ldl_cmac.h"
 
 #include <stdint.h>
 
@@ -42,6 +44,12 @@ extern "C" {
 struct ldl_key {
 
     uint8_t value[LDL_KEY_SIZE];
+#ifdef LDL_ENABLE_SM_KEY_CACHE
+    /* expanded from value whenever value changes */
+    struct ldl_aes_ctx ctx;
+    /* derived from ctx whenever value changes */
+    struct ldl_cmac_subkeys subkeys;
+#endif
 };
 
 /** default in-memory security module state */
@@ -43,6 +43,16 @@ extern "C" {
 /** SM state */
 struct ldl_sm;
 
+struct ldl_mac;
+
+/** Called by the SM to complete #ldl_sm_interface.begin_mic
+ *
+ * @param[in] mac   as passed to #ldl_sm_interface.begin_mic
+ * @param[in] mic   result
+ *
+ * */
+typedef void (*ldl_sm_mic_fn)(struct ldl_mac *mac, uint32_t mic);
+
 /** SM key descriptor */
 enum ldl_sm_key {
 
@@ -58,12 +68,70 @@ enum ldl_sm_key {
     LDL_SM_KEY_NWK         /**< network root key */
 };
 
+/** Uplink data frame to be secured by #ldl_sm_interface.secure_data
+ *
+ * Fields are encrypted in-place with CTR AES-128 before the MIC is
+ * calculated over the whole frame.
+ *
+ * */
+struct ldl_sm_data_frame {
+
+    uint8_t *msg;               /**< frame (without MIC) */
+    uint8_t len;                /**< size of msg */
+
+    uint8_t optsOffset;         /**< position of FOpts in msg */
+    uint8_t optsLen;            /**< size of FOpts to encrypt (0 if FOpts are not encrypted) */
+    enum ldl_sm_key optsKey;    /**< #ldl_sm_key to encrypt FOpts */
+    const void *optsIV;         /**< 16B CTR initial value for FOpts */
+
+    uint8_t dataOffset;         /**< position of FRMPayload in msg */
+    uint8_t dataLen;            /**< size of FRMPayload */
+    enum ldl_sm_key dataKey;    /**< #ldl_sm_key to encrypt FRMPayload */
+    const void *dataIV;         /**< 16B CTR initial value for FRMPayload */
+
+    const void *b0;             /**< 16B block prepended to msg for the #LDL_SM_KEY_FNWKSINT MIC */
+    const void *b1;             /**< 16B block prepended to msg for the #LDL_SM_KEY_SNWKSINT MIC (NULL if not required) */
+};
+
+/** parameters needed to derive all session keys after a join */
+struct ldl_sm_join_param {
+
+    uint8_t version;            /**< 0 for LoRaWAN 1.0.x, 1 for LoRaWAN 1.1 */
+    uint32_t joinNonce;         /**< JoinNonce (AppNonce in 1.0.x) */
+    uint32_t netID;             /**< NetID (only used if version is 0) */
+    const uint8_t *joinEUI;     /**< 8B JoinEUI in MSB first order (only used if version is 1) */
+    uint16_t devNonce;          /**< DevNonce used in the join request */
+};
+
 struct ldl_sm_interface {
 
     void (*update_session_key)(struct ldl_sm *self, enum ldl_sm_key key_desc, enum ldl_sm_key root_desc, const void *iv);
     uint32_t (*mic)(struct ldl_sm *self, enum ldl_sm_key desc, const void *hdr, uint8_t hdrLen, const void *data, uint8_t dataLen);
     void (*ecb)(struct ldl_sm *self, enum ldl_sm_key desc, void *b);
     void (*ctr)(struct ldl_sm *self, enum ldl_sm_key desc, const void *iv, void *data, uint8_t len);
+
+    /* optional (may be NULL)
+     *
+     * MAC will use ctr and mic if this isn't implemented */
+    void (*secure_data)(struct ldl_sm *self, const struct ldl_sm_data_frame *frame, uint32_t *micF, uint32_t *micS);
+
+    /* optional (may be NULL)
+     *
+     * Start the same calculation as mic and return immediately. The
+     * result is passed to cb (from any context) when it is ready.
+     *
+     * hdr and data are only valid for the duration of this call.
+     *
+     * Return false if the calculation could not be started (e.g. busy)
+     * and the MAC will use mic instead.
+     *
+     * Only used if LDL_ENABLE_SM_ASYNC is defined. */
+    bool (*begin_mic)(struct ldl_sm *self, enum ldl_sm_key desc, const void *hdr, uint8_t hdrLen, const void *data, uint8_t dataLen, struct ldl_mac *mac, ldl_sm_mic_fn cb);
+
+    /* optional (may be NULL)
+     *
+     * MAC will use update_session_key once per session key if this isn't implemented */
+    void (*derive_session_keys)(struct ldl_sm *self, const struct ldl_sm_join_param *param);
 };
 
 /** MAC can use this interface to talk to the default SM implementation
@@ -98,6 +166,18 @@ const struct ldl_sm_interface *LDL_SM_getInterface(void);
  * */
 void LDL_SM_updateSessionKey(struct ldl_sm *self, enum ldl_sm_key keyDesc, enum ldl_sm_key rootDesc, const void *iv);
 
+/** Derive all session keys from the root keys
+ *
+ * Equivalent to calling LDL_SM_updateSessionKey() for each session key
+ * except that each root key is only looked up (and expanded if
+ * #LDL_ENABLE_SM_KEY_CACHE is not defined) once.
+ *
+ * @param[in] self
+ * @param[in] param     #ldl_sm_join_param
+ *
+ * */
+void LDL_SM_deriveSessionKeys(struct ldl_sm *self, const struct ldl_sm_join_param *param);
+
 /** Lookup a key and use it to produce a MIC
  *
  * The MIC is the four least-significant bytes of an AES-128 CMAC digest of (hdr|data), intepreted
@@ -135,6 +215,25 @@ void LDL_SM_ecb(struct ldl_sm *self, enum ldl_sm_key desc, void *b);
  * */
 void LDL_SM_ctr(struct ldl_sm *self, enum ldl_sm_key desc, const void *iv, void *data, uint8_t len);
 
+/** Encrypt an uplink data frame and produce the MIC(s) in one pass
+ *
+ * Equivalent to encrypting FOpts and FRMPayload with LDL_SM_ctr() and
+ * then calling LDL_SM_mic() once for each MIC block, except that each
+ * block of the frame is encrypted and added to the MIC(s) while it
+ * is still hot.
+ *
+ * The default SM only offers this via #ldl_sm_interface if
+ * #LDL_ENABLE_SM_KEY_CACHE is defined since otherwise three key
+ * schedules would have to be expanded on the stack at the same time.
+ *
+ * @param[in] self
+ * @param[in] frame     #ldl_sm_data_frame
+ * @param[out] micF     MIC produced with #LDL_SM_KEY_FNWKSINT over (b0|msg)
+ * @param[out] micS     MIC produced with #LDL_SM_KEY_SNWKSINT over (b1|msg) (not written if b1 is NULL)
+ *
+ * */
+void LDL_SM_secureData(struct ldl_sm *self, const struct ldl_sm_data_frame *frame, uint32_t *micF, uint32_t *micS);
+
 
 #ifdef __cplusplus
 }
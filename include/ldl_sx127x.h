@@ -51,6 +51,9 @@ struct ldl_sx127x_init_arg {
     ldl_chip_read_fn chip_read;         /**< #ldl_chip_read_fn */
     ldl_chip_set_mode_fn chip_set_mode; /**< #ldl_chip_set_mode_fn */
 
+    /** #ldl_chip_submit_fn (optional, only used if #LDL_ENABLE_CHIP_ASYNC is defined) */
+    ldl_chip_submit_fn chip_submit;
+
     /** SX1272/6 transceivers have PAs on different physical pins
      *
      * The driver needs to know if one or both are connected.
@@ -91,6 +94,8 @@ const struct ldl_radio_interface *LDL_SX1276_getInterface(void);
 
 void LDL_SX127X_setMode(struct ldl_radio *self, enum ldl_radio_mode mode);
 void LDL_SX127X_transmit(struct ldl_radio *self, const struct ldl_radio_tx_setting *settings, const void *data, uint8_t len);
+void LDL_SX127X_prepareTransmit(struct ldl_radio *self, const struct ldl_radio_tx_setting *settings, const void *data, uint8_t len);
+void LDL_SX127X_startTransmit(struct ldl_radio *self);
 void LDL_SX127X_receive(struct ldl_radio *self, const struct ldl_radio_rx_setting *settings);
 uint8_t LDL_SX127X_readBuffer(struct ldl_radio *self, struct ldl_radio_packet_metadata *meta, void *data, uint8_t max);
 void LDL_SX127X_receiveEntropy(struct ldl_radio *self);
@@ -73,6 +73,21 @@ extern "C" {
  * */
 typedef uint32_t (*ldl_system_ticks_fn)(void *app);
 
+#ifdef LDL_ENABLE_TICKS_64
+/** Like #ldl_system_ticks_fn but reads a 64 bit counter that never wraps
+ *
+ * Only used if LDL_ENABLE_TICKS_64 is defined.
+ *
+ * @note this may be called from mainloop or interrupt
+ *
+ * @param[in]   app     from #ldl_mac_init_arg.app
+ *
+ * @return ticks
+ *
+ * */
+typedef uint64_t (*ldl_system_ticks64_fn)(void *app);
+#endif
+
 /** LDL uses this function to select channels and to add random dither
  * to scheduled events.
  *
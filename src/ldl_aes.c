@@ -23,6 +23,7 @@
 
 #include "ldl_aes.h"
 #include "ldl_debug.h"
+#include "ldl_internal.h"
 #include <string.h>
 
 /* defines ************************************************************/
@@ -48,6 +49,7 @@
     #define RSBOX(C) pgm_read_byte(&rsbox[(C)])
     #define SBOX(C) pgm_read_byte(&sbox[(C)])
     #define RCON(C) pgm_read_byte(&rcon[(C)])
+    #define TE(C) pgm_read_dword(&te[(C)])
 
 #else
 
@@ -56,9 +58,12 @@
     #define SBOX(C) (sbox[(C)])
     #define RCON(C) (rcon[(C)])
     #define RSBOX(C) (rsbox[(C)])
+    #define TE(C) (te[(C)])
 
 #endif
 
+#define ROTR32(W, N) (((W) >> (N)) | ((W) << (32U - (N))))
+
 /* static variables ***************************************************/
 
 static const uint8_t sbox[] PROGMEM = {
@@ -96,6 +101,91 @@ static const uint8_t sbox[] PROGMEM = {
     0x41U, 0x99U, 0x2dU, 0x0fU, 0xb0U, 0x54U, 0xbbU, 0x16U
 };
 
+#ifdef LDL_ENABLE_AES_TTABLE
+/* combined sbox and mix columns for row 1
+ *
+ * te[x] = sbox[x].{02,01,01,03}
+ *
+ * rows 2 to 4 are the same table rotated right by 8, 16 and 24 bits
+ *
+ * */
+static const uint32_t te[] PROGMEM = {
+    0xc66363a5U, 0xf87c7c84U, 0xee777799U, 0xf67b7b8dU,
+    0xfff2f20dU, 0xd66b6bbdU, 0xde6f6fb1U, 0x91c5c554U,
+    0x60303050U, 0x02010103U, 0xce6767a9U, 0x562b2b7dU,
+    0xe7fefe19U, 0xb5d7d762U, 0x4dababe6U, 0xec76769aU,
+    0x8fcaca45U, 0x1f82829dU, 0x89c9c940U, 0xfa7d7d87U,
+    0xeffafa15U, 0xb25959ebU, 0x8e4747c9U, 0xfbf0f00bU,
+    0x41adadecU, 0xb3d4d467U, 0x5fa2a2fdU, 0x45afafeaU,
+    0x239c9cbfU, 0x53a4a4f7U, 0xe4727296U, 0x9bc0c05bU,
+    0x75b7b7c2U, 0xe1fdfd1cU, 0x3d9393aeU, 0x4c26266aU,
+    0x6c36365aU, 0x7e3f3f41U, 0xf5f7f702U, 0x83cccc4fU,
+    0x6834345cU, 0x51a5a5f4U, 0xd1e5e534U, 0xf9f1f108U,
+    0xe2717193U, 0xabd8d873U, 0x62313153U, 0x2a15153fU,
+    0x0804040cU, 0x95c7c752U, 0x46232365U, 0x9dc3c35eU,
+    0x30181828U, 0x379696a1U, 0x0a05050fU, 0x2f9a9ab5U,
+    0x0e070709U, 0x24121236U, 0x1b80809bU, 0xdfe2e23dU,
+    0xcdebeb26U, 0x4e272769U, 0x7fb2b2cdU, 0xea75759fU,
+    0x1209091bU, 0x1d83839eU, 0x582c2c74U, 0x341a1a2eU,
+    0x361b1b2dU, 0xdc6e6eb2U, 0xb45a5aeeU, 0x5ba0a0fbU,
+    0xa45252f6U, 0x763b3b4dU, 0xb7d6d661U, 0x7db3b3ceU,
+    0x5229297bU, 0xdde3e33eU, 0x5e2f2f71U, 0x13848497U,
+    0xa65353f5U, 0xb9d1d168U, 0x00000000U, 0xc1eded2cU,
+    0x40202060U, 0xe3fcfc1fU, 0x79b1b1c8U, 0xb65b5bedU,
+    0xd46a6abeU, 0x8dcbcb46U, 0x67bebed9U, 0x7239394bU,
+    0x944a4adeU, 0x984c4cd4U, 0xb05858e8U, 0x85cfcf4aU,
+    0xbbd0d06bU, 0xc5efef2aU, 0x4faaaae5U, 0xedfbfb16U,
+    0x864343c5U, 0x9a4d4dd7U, 0x66333355U, 0x11858594U,
+    0x8a4545cfU, 0xe9f9f910U, 0x04020206U, 0xfe7f7f81U,
+    0xa05050f0U, 0x783c3c44U, 0x259f9fbaU, 0x4ba8a8e3U,
+    0xa25151f3U, 0x5da3a3feU, 0x804040c0U, 0x058f8f8aU,
+    0x3f9292adU, 0x219d9dbcU, 0x70383848U, 0xf1f5f504U,
+    0x63bcbcdfU, 0x77b6b6c1U, 0xafdada75U, 0x42212163U,
+    0x20101030U, 0xe5ffff1aU, 0xfdf3f30eU, 0xbfd2d26dU,
+    0x81cdcd4cU, 0x180c0c14U, 0x26131335U, 0xc3ecec2fU,
+    0xbe5f5fe1U, 0x359797a2U, 0x884444ccU, 0x2e171739U,
+    0x93c4c457U, 0x55a7a7f2U, 0xfc7e7e82U, 0x7a3d3d47U,
+    0xc86464acU, 0xba5d5de7U, 0x3219192bU, 0xe6737395U,
+    0xc06060a0U, 0x19818198U, 0x9e4f4fd1U, 0xa3dcdc7fU,
+    0x44222266U, 0x542a2a7eU, 0x3b9090abU, 0x0b888883U,
+    0x8c4646caU, 0xc7eeee29U, 0x6bb8b8d3U, 0x2814143cU,
+    0xa7dede79U, 0xbc5e5ee2U, 0x160b0b1dU, 0xaddbdb76U,
+    0xdbe0e03bU, 0x64323256U, 0x743a3a4eU, 0x140a0a1eU,
+    0x924949dbU, 0x0c06060aU, 0x4824246cU, 0xb85c5ce4U,
+    0x9fc2c25dU, 0xbdd3d36eU, 0x43acacefU, 0xc46262a6U,
+    0x399191a8U, 0x319595a4U, 0xd3e4e437U, 0xf279798bU,
+    0xd5e7e732U, 0x8bc8c843U, 0x6e373759U, 0xda6d6db7U,
+    0x018d8d8cU, 0xb1d5d564U, 0x9c4e4ed2U, 0x49a9a9e0U,
+    0xd86c6cb4U, 0xac5656faU, 0xf3f4f407U, 0xcfeaea25U,
+    0xca6565afU, 0xf47a7a8eU, 0x47aeaee9U, 0x10080818U,
+    0x6fbabad5U, 0xf0787888U, 0x4a25256fU, 0x5c2e2e72U,
+    0x381c1c24U, 0x57a6a6f1U, 0x73b4b4c7U, 0x97c6c651U,
+    0xcbe8e823U, 0xa1dddd7cU, 0xe874749cU, 0x3e1f1f21U,
+    0x964b4bddU, 0x61bdbddcU, 0x0d8b8b86U, 0x0f8a8a85U,
+    0xe0707090U, 0x7c3e3e42U, 0x71b5b5c4U, 0xcc6666aaU,
+    0x904848d8U, 0x06030305U, 0xf7f6f601U, 0x1c0e0e12U,
+    0xc26161a3U, 0x6a35355fU, 0xae5757f9U, 0x69b9b9d0U,
+    0x17868691U, 0x99c1c158U, 0x3a1d1d27U, 0x279e9eb9U,
+    0xd9e1e138U, 0xebf8f813U, 0x2b9898b3U, 0x22111133U,
+    0xd26969bbU, 0xa9d9d970U, 0x078e8e89U, 0x339494a7U,
+    0x2d9b9bb6U, 0x3c1e1e22U, 0x15878792U, 0xc9e9e920U,
+    0x87cece49U, 0xaa5555ffU, 0x50282878U, 0xa5dfdf7aU,
+    0x038c8c8fU, 0x59a1a1f8U, 0x09898980U, 0x1a0d0d17U,
+    0x65bfbfdaU, 0xd7e6e631U, 0x844242c6U, 0xd06868b8U,
+    0x824141c3U, 0x299999b0U, 0x5a2d2d77U, 0x1e0f0f11U,
+    0x7bb0b0cbU, 0xa85454fcU, 0x6dbbbbd6U, 0x2c16163aU
+};
+#endif
+
+/* static function prototypes *****************************************/
+
+static void encryptBlock(const struct ldl_aes_ctx *ctx, void *s);
+
+#ifdef LDL_ENABLE_AES_TTABLE
+static uint32_t getColumn(const uint8_t *in);
+static void putColumn(uint8_t *out, uint32_t value);
+#endif
+
 /* functions **********************************************************/
 
 void LDL_AES_init(struct ldl_aes_ctx *ctx, const void *key)
@@ -141,9 +231,111 @@ void LDL_AES_init(struct ldl_aes_ctx *ctx, const void *key)
 
         i++;
     }
+
+#ifdef LDL_AES_BACKEND
+    ctx->backend = LDL_AES_BACKEND;
+
+    if((ctx->backend != NULL) && !ctx->backend->init(ctx)){
+
+        ctx->backend = NULL;
+    }
+#endif
 }
 
 void LDL_AES_encrypt(const struct ldl_aes_ctx *ctx, void *s)
+{
+    LDL_PEDANTIC(ctx != NULL)
+    LDL_PEDANTIC(s != NULL)
+
+#ifdef LDL_AES_BACKEND
+    if(ctx->backend != NULL){
+
+        ctx->backend->encrypt(ctx, s);
+    }
+    else
+#endif
+    {
+        encryptBlock(ctx, s);
+    }
+}
+
+void LDL_AES_encryptBlocks(const struct ldl_aes_ctx *ctx, void *s, uint8_t n)
+{
+    LDL_PEDANTIC(ctx != NULL)
+    LDL_PEDANTIC((n == 0U) || (s != NULL))
+
+    uint8_t *_s = s;
+    uint8_t i;
+
+#ifdef LDL_AES_BACKEND
+    if((ctx->backend != NULL) && (ctx->backend->encrypt_blocks != NULL)){
+
+        ctx->backend->encrypt_blocks(ctx, s, n);
+    }
+    else
+#endif
+    {
+        for(i=0U; i < n; i++){
+
+            LDL_AES_encrypt(ctx, &_s[i * AES_BLOCK_SIZE]);
+        }
+    }
+}
+
+/* static functions ***************************************************/
+
+#ifdef LDL_ENABLE_AES_TTABLE
+static void encryptBlock(const struct ldl_aes_ctx *ctx, void *s)
+{
+    uint8_t *_s = s;
+    uint8_t r;
+    uint32_t s0;
+    uint32_t s1;
+    uint32_t s2;
+    uint32_t s3;
+    uint32_t t0;
+    uint32_t t1;
+    uint32_t t2;
+    uint32_t t3;
+    const uint8_t *k = ctx->k;
+
+    /* add round key */
+    s0 = getColumn(&_s[C1]) ^ getColumn(&k[C1]);
+    s1 = getColumn(&_s[C2]) ^ getColumn(&k[C2]);
+    s2 = getColumn(&_s[C3]) ^ getColumn(&k[C3]);
+    s3 = getColumn(&_s[C4]) ^ getColumn(&k[C4]);
+
+    /* sbox, shiftrows, mix columns and add round key */
+    for(r = 1U; r < ctx->r; r++){
+
+        k = &k[AES_BLOCK_SIZE];
+
+        t0 = TE(U8(s0 >> 24)) ^ ROTR32(TE(U8(s1 >> 16)), 8U) ^ ROTR32(TE(U8(s2 >> 8)), 16U) ^ ROTR32(TE(U8(s3)), 24U) ^ getColumn(&k[C1]);
+        t1 = TE(U8(s1 >> 24)) ^ ROTR32(TE(U8(s2 >> 16)), 8U) ^ ROTR32(TE(U8(s3 >> 8)), 16U) ^ ROTR32(TE(U8(s0)), 24U) ^ getColumn(&k[C2]);
+        t2 = TE(U8(s2 >> 24)) ^ ROTR32(TE(U8(s3 >> 16)), 8U) ^ ROTR32(TE(U8(s0 >> 8)), 16U) ^ ROTR32(TE(U8(s1)), 24U) ^ getColumn(&k[C3]);
+        t3 = TE(U8(s3 >> 24)) ^ ROTR32(TE(U8(s0 >> 16)), 8U) ^ ROTR32(TE(U8(s1 >> 8)), 16U) ^ ROTR32(TE(U8(s2)), 24U) ^ getColumn(&k[C4]);
+
+        s0 = t0;
+        s1 = t1;
+        s2 = t2;
+        s3 = t3;
+    }
+
+    k = &k[AES_BLOCK_SIZE];
+
+    /* final round has no mix columns */
+    t0 = (U32(SBOX(U8(s0 >> 24))) << 24) | (U32(SBOX(U8(s1 >> 16))) << 16) | (U32(SBOX(U8(s2 >> 8))) << 8) | U32(SBOX(U8(s3)));
+    t1 = (U32(SBOX(U8(s1 >> 24))) << 24) | (U32(SBOX(U8(s2 >> 16))) << 16) | (U32(SBOX(U8(s3 >> 8))) << 8) | U32(SBOX(U8(s0)));
+    t2 = (U32(SBOX(U8(s2 >> 24))) << 24) | (U32(SBOX(U8(s3 >> 16))) << 16) | (U32(SBOX(U8(s0 >> 8))) << 8) | U32(SBOX(U8(s1)));
+    t3 = (U32(SBOX(U8(s3 >> 24))) << 24) | (U32(SBOX(U8(s0 >> 16))) << 16) | (U32(SBOX(U8(s1 >> 8))) << 8) | U32(SBOX(U8(s2)));
+
+    putColumn(&_s[C1], t0 ^ getColumn(&k[C1]));
+    putColumn(&_s[C2], t1 ^ getColumn(&k[C2]));
+    putColumn(&_s[C3], t2 ^ getColumn(&k[C3]));
+    putColumn(&_s[C4], t3 ^ getColumn(&k[C4]));
+}
+#else
+static void encryptBlock(const struct ldl_aes_ctx *ctx, void *s)
 {
     uint8_t *_s = s;
     uint8_t r;
@@ -224,3 +416,19 @@ void LDL_AES_encrypt(const struct ldl_aes_ctx *ctx, void *s)
         p += 16U;
     }
 }
+#endif
+
+#ifdef LDL_ENABLE_AES_TTABLE
+static uint32_t getColumn(const uint8_t *in)
+{
+    return (U32(in[R1]) << 24) | (U32(in[R2]) << 16) | (U32(in[R3]) << 8) | U32(in[R4]);
+}
+
+static void putColumn(uint8_t *out, uint32_t value)
+{
+    out[R1] = U8(value >> 24);
+    out[R2] = U8(value >> 16);
+    out[R3] = U8(value >> 8);
+    out[R4] = U8(value);
+}
+#endif
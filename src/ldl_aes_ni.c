@@ -0,0 +1,174 @@
+/* Copyright (c) 2021 Cameron Harper
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * */
+
+/* includes ***********************************************************/
+
+#include "ldl_aes.h"
+#include "ldl_debug.h"
+
+#ifdef LDL_ENABLE_AES_NI
+
+#if defined(__x86_64__) && (defined(__GNUC__) || defined(__clang__))
+
+    #include <cpuid.h>
+    #include <wmmintrin.h>
+
+    #define HAVE_AES_NI
+
+    /* allows intrinsics without having to build everything with -maes */
+    #define AES_NI_TARGET __attribute__((target("aes,sse2")))
+
+#endif
+
+/* static function prototypes *****************************************/
+
+static bool init(struct ldl_aes_ctx *ctx);
+static void encrypt(const struct ldl_aes_ctx *ctx, void *s);
+static void encryptBlocks(const struct ldl_aes_ctx *ctx, void *s, uint8_t n);
+
+/* static variables ***************************************************/
+
+static const struct ldl_aes_backend backend = {
+    .init = init,
+    .encrypt = encrypt,
+    .encrypt_blocks = encryptBlocks
+};
+
+/* functions **********************************************************/
+
+const struct ldl_aes_backend *LDL_AES_NI_getBackend(void)
+{
+    return &backend;
+}
+
+/* static functions ***************************************************/
+
+static bool init(struct ldl_aes_ctx *ctx)
+{
+    (void)ctx;
+
+#ifdef HAVE_AES_NI
+    /* cpuid is expensive under virtualisation so only ask once */
+    static int8_t supported = -1;
+    unsigned int a;
+    unsigned int b;
+    unsigned int c;
+    unsigned int d;
+
+    if(supported < 0){
+
+        supported = ((__get_cpuid(1U, &a, &b, &c, &d) != 0) && ((c & bit_AES) == bit_AES)) ? 1 : 0;
+    }
+
+    return (supported > 0);
+#else
+    return false;
+#endif
+}
+
+#ifdef HAVE_AES_NI
+AES_NI_TARGET
+static void encrypt(const struct ldl_aes_ctx *ctx, void *s)
+{
+    uint8_t r;
+    __m128i state;
+
+    /* the portable key schedule has the same layout as AES-NI round keys */
+    state = _mm_xor_si128(_mm_loadu_si128((const __m128i *)s), _mm_loadu_si128((const __m128i *)ctx->k));
+
+    for(r = 1U; r < ctx->r; r++){
+
+        state = _mm_aesenc_si128(state, _mm_loadu_si128((const __m128i *)&ctx->k[r * 16U]));
+    }
+
+    state = _mm_aesenclast_si128(state, _mm_loadu_si128((const __m128i *)&ctx->k[r * 16U]));
+
+    _mm_storeu_si128((__m128i *)s, state);
+}
+
+AES_NI_TARGET
+static void encryptBlocks(const struct ldl_aes_ctx *ctx, void *s, uint8_t n)
+{
+    uint8_t r;
+    uint8_t *ptr = s;
+    __m128i k;
+    __m128i s0;
+    __m128i s1;
+    __m128i s2;
+    __m128i s3;
+
+    /* four blocks are interleaved to hide the latency of aesenc */
+    while(n >= 4U){
+
+        k = _mm_loadu_si128((const __m128i *)ctx->k);
+
+        s0 = _mm_xor_si128(_mm_loadu_si128((const __m128i *)&ptr[0U]), k);
+        s1 = _mm_xor_si128(_mm_loadu_si128((const __m128i *)&ptr[16U]), k);
+        s2 = _mm_xor_si128(_mm_loadu_si128((const __m128i *)&ptr[32U]), k);
+        s3 = _mm_xor_si128(_mm_loadu_si128((const __m128i *)&ptr[48U]), k);
+
+        for(r = 1U; r < ctx->r; r++){
+
+            k = _mm_loadu_si128((const __m128i *)&ctx->k[r * 16U]);
+
+            s0 = _mm_aesenc_si128(s0, k);
+            s1 = _mm_aesenc_si128(s1, k);
+            s2 = _mm_aesenc_si128(s2, k);
+            s3 = _mm_aesenc_si128(s3, k);
+        }
+
+        k = _mm_loadu_si128((const __m128i *)&ctx->k[r * 16U]);
+
+        _mm_storeu_si128((__m128i *)&ptr[0U], _mm_aesenclast_si128(s0, k));
+        _mm_storeu_si128((__m128i *)&ptr[16U], _mm_aesenclast_si128(s1, k));
+        _mm_storeu_si128((__m128i *)&ptr[32U], _mm_aesenclast_si128(s2, k));
+        _mm_storeu_si128((__m128i *)&ptr[48U], _mm_aesenclast_si128(s3, k));
+
+        ptr = &ptr[64U];
+        n -= 4U;
+    }
+
+    while(n > 0U){
+
+        encrypt(ctx, ptr);
+
+        ptr = &ptr[16U];
+        n--;
+    }
+}
+#else
+static void encrypt(const struct ldl_aes_ctx *ctx, void *s)
+{
+    /* never called since init() always fails */
+    (void)ctx;
+    (void)s;
+}
+
+static void encryptBlocks(const struct ldl_aes_ctx *ctx, void *s, uint8_t n)
+{
+    /* never called since init() always fails */
+    (void)ctx;
+    (void)s;
+    (void)n;
+}
+#endif
+
+#endif
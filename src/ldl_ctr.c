@@ -26,29 +26,38 @@
 
 #include <string.h>
 
+/* defines ************************************************************/
+
+#define BLOCK_SIZE 16U
+
+/* number of keystream blocks generated at once (redefine to trade
+ * stack for speed) */
+#ifndef LDL_CTR_BATCH
+    #define LDL_CTR_BATCH 4U
+#endif
+
 /* static function prototypes *****************************************/
 
-static void xor128(uint8_t *acc, const uint8_t *op);
+static void xorStream(uint8_t *out, const uint8_t *in, const uint8_t *stream, uint8_t len);
 
 /* functions **********************************************************/
 
-void LDL_CTR_encrypt(struct ldl_aes_ctx *ctx, const void *iv, const void *in, void *out, uint8_t len)
+void LDL_CTR_encrypt(const struct ldl_aes_ctx *ctx, const void *iv, const void *in, void *out, uint8_t len)
 {
     LDL_PEDANTIC(ctx != NULL)
+    LDL_PEDANTIC(iv != NULL)
+    LDL_PEDANTIC((len == 0U) || ((in != NULL) && (out != NULL)))
 
-    uint8_t a[16U];
-    uint8_t s[16U];
-    uint8_t pld[16U];
-    uint8_t k;
+    uint8_t a[BLOCK_SIZE];
+    uint8_t s[LDL_CTR_BATCH * BLOCK_SIZE];
+    uint8_t remaining;
+    uint8_t blocks;
     uint8_t i;
-    uint8_t pos;
     uint8_t size;
+    uint8_t pos;
     const uint8_t *ptr_in;
     uint8_t *ptr_out;
 
-    /* number of blocks */
-    k = (len / 16U) + (((len % 16U) != 0U) ? 1U : 0U);
-
     pos = 0U;
 
     ptr_in = (const uint8_t *)in;
@@ -56,46 +65,55 @@ void LDL_CTR_encrypt(struct ldl_aes_ctx *ctx, const void *iv, const void *in, vo
 
     (void)memcpy(a, iv, sizeof(a));
 
-    for(i=0U; i < k; i++){
+    while(pos < len){
 
-        size = ((len - pos) >= U8(sizeof(a))) ? U8(sizeof(a)) : (len - pos);
+        remaining = len - pos;
 
-        (void)memset(pld, 0, sizeof(pld));
+        /* number of blocks in this batch */
+        blocks = (remaining / BLOCK_SIZE) + (((remaining % BLOCK_SIZE) != 0U) ? 1U : 0U);
+        blocks = (blocks > LDL_CTR_BATCH) ? U8(LDL_CTR_BATCH) : blocks;
 
-        (void)memcpy(pld, &ptr_in[pos], size);
+        for(i=0U; i < blocks; i++){
 
-        (void)memcpy(s, a, sizeof(s));
+            (void)memcpy(&s[i * BLOCK_SIZE], a, sizeof(a));
+            a[15U]++;
+        }
 
-        a[15U]++;
+        LDL_AES_encryptBlocks(ctx, s, blocks);
 
-        LDL_AES_encrypt(ctx, s);
+        size = ((blocks * BLOCK_SIZE) < remaining) ? U8(blocks * BLOCK_SIZE) : remaining;
 
-        xor128(pld, s);
+        xorStream(&ptr_out[pos], &ptr_in[pos], s, size);
 
-        (void)memcpy(&ptr_out[pos], pld, size);
-
-        pos += U8(sizeof(a));
+        pos += size;
     }
 }
 
 /* static functions ***************************************************/
 
-static void xor128(uint8_t *acc, const uint8_t *op)
+static void xorStream(uint8_t *out, const uint8_t *in, const uint8_t *stream, uint8_t len)
 {
-    acc[0] ^= op[0];
-    acc[1] ^= op[1];
-    acc[2] ^= op[2];
-    acc[3] ^= op[3];
-    acc[4] ^= op[4];
-    acc[5] ^= op[5];
-    acc[6] ^= op[6];
-    acc[7] ^= op[7];
-    acc[8] ^= op[8];
-    acc[9] ^= op[9];
-    acc[10] ^= op[10];
-    acc[11] ^= op[11];
-    acc[12] ^= op[12];
-    acc[13] ^= op[13];
-    acc[14] ^= op[14];
-    acc[15] ^= op[15];
+    uint32_t w;
+    uint32_t k;
+    uint8_t pos = 0U;
+
+    /* memcpy lets the compiler choose the widest access that is
+     * safe for the alignment of in and out (which is arbitrary) */
+    while((len - pos) >= U8(sizeof(w))){
+
+        (void)memcpy(&w, &in[pos], sizeof(w));
+        (void)memcpy(&k, &stream[pos], sizeof(k));
+
+        w ^= k;
+
+        (void)memcpy(&out[pos], &w, sizeof(w));
+
+        pos += U8(sizeof(w));
+    }
+
+    while(pos < len){
+
+        out[pos] = in[pos] ^ stream[pos];
+        pos++;
+    }
 }
@@ -48,6 +48,25 @@ void LDL_Frame_updateMIC(void *msg, uint8_t len, uint32_t mic)
     }
 }
 
+uint32_t LDL_Frame_getMIC(const void *msg, uint8_t len)
+{
+    LDL_PEDANTIC(msg != NULL)
+
+    struct ldl_stream s;
+    uint32_t mic = 0U;
+
+    if(len > sizeof(mic)){
+
+        LDL_Stream_initReadOnly(&s, msg, len);
+
+        (void)LDL_Stream_seekSet(&s, len - U8(sizeof(mic)));
+
+        (void)LDL_Stream_getU32(&s, &mic);
+    }
+
+    return mic;
+}
+
 uint8_t LDL_Frame_putData(const struct ldl_frame_data *f, void *out, uint8_t max, struct ldl_frame_data_offset *off)
 {
     LDL_PEDANTIC(f != NULL)
@@ -40,8 +40,10 @@ enum {
 
 #ifdef LDL_PARAM_TPS
     #define GET_TPS() U32(LDL_PARAM_TPS)
+    #define GET_TPS_RECIPROCAL() U32(UINT32_MAX / U32(LDL_PARAM_TPS))
 #else
     #define GET_TPS() self->tps
+    #define GET_TPS_RECIPROCAL() self->timing.reciprocal
 #endif
 
 #ifdef LDL_PARAM_A
@@ -85,6 +87,8 @@ static void processEntropy(struct ldl_mac *self, enum ldl_mac_sme event);
 
 static void processStartRadioForTX(struct ldl_mac *self, enum ldl_mac_sme event);
 static void processTX(struct ldl_mac *self, enum ldl_mac_sme event, uint32_t lag);
+static uint32_t txSetting(const struct ldl_mac *self, struct ldl_radio_tx_setting *setting);
+static bool txIsPrepared(const struct ldl_mac *self);
 
 static void processStartRadioForRX1(struct ldl_mac *self, enum ldl_mac_sme event, uint32_t lag);
 static void processStartRadioForRX2(struct ldl_mac *self, enum ldl_mac_sme event, uint32_t lag);
@@ -101,7 +105,9 @@ static uint8_t requiredRate(uint8_t desired, uint8_t min, uint8_t max);
 static void selectJoinChannelAndRate(struct ldl_mac *self, struct ldl_mac_tx *tx);
 static void registerTime(struct ldl_mac *self, const struct ldl_mac_tx *tx);
 static bool getChannel(const struct ldl_mac *self, uint8_t chIndex, uint32_t *freq, uint8_t *minRate, uint8_t *maxRate);
-static bool isAvailable(const struct ldl_mac *self, uint8_t chIndex, uint32_t limit);
+static void updateChannelMap(struct ldl_mac *self, uint8_t chIndex);
+static void rebuildChannelMap(struct ldl_mac *self);
+static uint8_t countChannels(const uint8_t *mask, size_t max);
 static void initSession(struct ldl_mac *self, enum ldl_region region);
 static void forgetNetwork(struct ldl_mac *self);
 static bool setChannel(struct ldl_mac *self, uint8_t chIndex, uint32_t freq, uint8_t minRate, uint8_t maxRate);
@@ -109,15 +115,25 @@ static bool maskChannel(uint8_t *mask, size_t max, enum ldl_region region, uint8
 static bool unmaskChannel(uint8_t *mask, size_t max, enum ldl_region region, uint8_t chIndex);
 static void unmaskAllChannels(uint8_t *mask, size_t max);
 static bool channelIsMasked(const uint8_t *mask, size_t max, enum ldl_region region, uint8_t chIndex);
-static uint32_t symbolPeriod(uint32_t tps, enum ldl_spreading_factor sf, enum ldl_signal_bandwidth bw);
-static uint32_t timeUntilAvailable(const struct ldl_mac *self, uint8_t chIndex);
 static bool rateSettingIsValid(enum ldl_region region, uint8_t rate);
 static bool adaptRate(struct ldl_mac *self);
+static uint32_t timeNow(const struct ldl_mac *self);
+static uint32_t timeSync(struct ldl_mac *self);
+static uint32_t deadlineRemaining(uint32_t deadline, uint32_t now);
+static uint32_t deadlineExtend(uint32_t deadline, uint32_t now, uint32_t time);
 static bool processBands(struct ldl_mac *self);
-static void setNextBandEvent(struct ldl_mac *self);
+static void setNextBandEvent(struct ldl_mac *self, uint32_t now);
 static void downlinkMissingHandler(struct ldl_mac *self);
 static uint32_t timeUntilNextChannel(const struct ldl_mac *self);
+static uint32_t getTicks(const struct ldl_mac *self);
+static ldl_ticks_t timerNow(const struct ldl_mac *self);
+static ldl_ticks_t timerSync(struct ldl_mac *self);
+static uint32_t timerUntil(ldl_ticks_t timeout, ldl_ticks_t time, uint32_t *lag);
+static void timerSetTicks(struct ldl_mac *self, enum ldl_timer_inst timer, ldl_ticks_t timeout);
 static uint32_t timerDelta(uint32_t timeout, uint32_t time);
+static void timerUpdateEarliest(struct ldl_mac *self, ldl_ticks_t time);
+static bool priorityDeadline(const struct ldl_mac *self, ldl_ticks_t now, ldl_ticks_t *deadline);
+static uint32_t ticksToTime(const struct ldl_mac *self, ldl_ticks_t since, uint32_t *remainder);
 static void pushSessionUpdate(struct ldl_mac *self);
 static void dummyResponseHandler(void *app, enum ldl_mac_response_type type, const union ldl_mac_response_arg *arg);
 static bool allChannelsAreMasked(const uint8_t *mask, size_t max);
@@ -126,7 +142,7 @@ static void clearPendingCommand(struct ldl_mac *self, enum ldl_mac_cmd_type type
 static void setPendingCommand(struct ldl_mac *self, enum ldl_mac_cmd_type type);
 static uint32_t defaultRand(void *app);
 static uint8_t defaultBatteryLevel(void *app);
-static uint32_t getOTAAOffTime(const struct ldl_mac *self);
+static uint32_t getOTAAOffTime(const struct ldl_mac *self, uint32_t now);
 static void handleRadioError(struct ldl_mac *self);
 #ifndef LDL_DISABLE_TX_PARAM_SETUP
 static bool uplinkDwell(uint8_t tx_param_setup);
@@ -135,6 +151,17 @@ static void fillJoinBuffer(struct ldl_mac *self, uint16_t devNonce);
 
 static uint32_t msToTime(uint32_t ms);
 static uint32_t msToTicks(const struct ldl_mac *self, uint32_t ms);
+static uint32_t guardTicks(const struct ldl_mac *self);
+
+static uint32_t divTPS(const struct ldl_mac *self, uint32_t n, uint32_t *remainder);
+
+static void initTiming(struct ldl_mac *self);
+static uint32_t scale(uint32_t value, uint8_t shift, uint32_t divisor, bool roundUp);
+static uint8_t timingIndex(enum ldl_spreading_factor sf, enum ldl_signal_bandwidth bw);
+static uint32_t symbolTicks(const struct ldl_mac *self, enum ldl_spreading_factor sf, enum ldl_signal_bandwidth bw);
+static uint32_t packetQuarters(enum ldl_spreading_factor sf, enum ldl_signal_bandwidth bw, uint8_t size, bool crc);
+static uint32_t airTimeTicks(const struct ldl_mac *self, enum ldl_spreading_factor sf, enum ldl_signal_bandwidth bw, uint32_t quarters);
+static uint32_t airTimeTime(enum ldl_spreading_factor sf, enum ldl_signal_bandwidth bw, uint32_t quarters);
 
 static void inputArm(struct ldl_mac *self);
 static void inputDisarm(struct ldl_mac *self);
@@ -142,7 +169,36 @@ static bool inputCheck(struct ldl_mac *self, uint32_t *lag);
 static void inputSignal(struct ldl_mac *self, uint32_t ticks);
 static bool inputPending(const struct ldl_mac *self);
 
+static void handleDownlink(struct ldl_mac *self, struct ldl_frame_down *frame);
+
+#ifdef LDL_ENABLE_SM_ASYNC
+static bool beginMIC(struct ldl_mac *self, const struct ldl_ops_mic *arg, const uint8_t *in, uint8_t len);
+static void abandonMIC(struct ldl_mac *self);
+static bool micCheck(struct ldl_mac *self);
+static bool micPending(const struct ldl_mac *self);
+static void processMIC(struct ldl_mac *self);
+static void processWaitMIC(struct ldl_mac *self, enum ldl_mac_sme event);
+#endif
+
 static const uint32_t timeTPS = U32(0x100);
+
+/* quarter symbol period in 'time' x 2^timeShift (rounded up)
+ *
+ * same index as ldl_mac_timing.quarter
+ * */
+#define TIME_QUARTER(N) U32(((U64(1) << ((N) + 25U)) + U64(999999)) / U64(1000000))
+static const uint8_t timeShift = 19U;
+static const uint32_t timeQuarter[] = {
+    TIME_QUARTER(8U),
+    TIME_QUARTER(9U),
+    TIME_QUARTER(10U),
+    TIME_QUARTER(11U),
+    TIME_QUARTER(12U),
+    TIME_QUARTER(13U),
+    TIME_QUARTER(14U),
+    TIME_QUARTER(15U)
+};
+#undef TIME_QUARTER
 static const uint8_t sessionMagicNumber = 0xdbU;
 
 /* functions **********************************************************/
@@ -151,7 +207,11 @@ void LDL_MAC_init(struct ldl_mac *self, enum ldl_region region, const struct ldl
 {
     LDL_PEDANTIC(self != NULL)
     LDL_PEDANTIC(arg != NULL)
+#ifdef LDL_ENABLE_TICKS_64
+    LDL_PEDANTIC((arg->ticks != NULL) || (arg->ticks64 != NULL))
+#else
     LDL_PEDANTIC(arg->ticks != NULL)
+#endif
     LDL_PEDANTIC(arg->radio_interface != NULL);
     LDL_PEDANTIC(arg->sm_interface != NULL);
 
@@ -175,10 +235,20 @@ void LDL_MAC_init(struct ldl_mac *self, enum ldl_region region, const struct ldl
     self->otaaDither = arg->otaaDither;
 #endif
 
+#ifdef LDL_ENABLE_TICKS_64
+    /* 64M >= tps >= 1K */
+    LDL_PEDANTIC((GET_TPS() >= U32(1000)) && (GET_TPS() <= U32(64000000)))
+#else
     /* 1M >= tps >= 1K */
     LDL_PEDANTIC((GET_TPS() >= U32(1000)) && (GET_TPS() <= U32(1000000)))
+#endif
+
+    initTiming(self);
 
     self->ticks = arg->ticks;
+#ifdef LDL_ENABLE_TICKS_64
+    self->ticks64 = arg->ticks64;
+#endif
     self->rand = (arg->rand != NULL) ? arg->rand : defaultRand;
     self->get_battery_level = (arg->get_battery_level != NULL) ? arg->get_battery_level : defaultBatteryLevel;
 
@@ -222,9 +292,17 @@ void LDL_MAC_init(struct ldl_mac *self, enum ldl_region region, const struct ldl
         initSession(self, region);
     }
 
-    self->band[LDL_BAND_GLOBAL] = msToTime(U32(LDL_STARTUP_DELAY));
+    rebuildChannelMap(self);
+
+    LDL_SYSTEM_ENTER_CRITICAL(self->app)
+
+    self->time.ticks = timerSync(self);
+
+    LDL_SYSTEM_LEAVE_CRITICAL(self->app)
 
-    self->time.ticks = self->ticks(self->app);
+    self->band[LDL_BAND_GLOBAL] = deadlineExtend(0U, self->time.now, msToTime(U32(LDL_STARTUP_DELAY)));
+
+    setNextBandEvent(self, self->time.now);
 
     LDL_MAC_timerSet(self, LDL_TIMER_WAITA, 0);
 
@@ -301,7 +379,11 @@ enum ldl_mac_status LDL_MAC_otaa(struct ldl_mac *self)
 
             self->trials = 0;
 
-            self->day = U32(60) * U32(60) * U32(24) * timeTPS;
+            uint32_t now = timeSync(self);
+
+            self->day = deadlineExtend(0U, now, U32(60) * U32(60) * U32(24) * timeTPS);
+
+            setNextBandEvent(self, now);
 
 #if defined(LDL_ENABLE_L2_1_1)
             LDL_OPS_deriveJoinKeys(self);
@@ -363,6 +445,8 @@ enum ldl_mac_status LDL_MAC_abp(struct ldl_mac *self, uint32_t devAddr)
         self->band[LDL_BAND_GLOBAL] = 0;
         self->day = 0;
 
+        setNextBandEvent(self, timeSync(self));
+
         retval = LDL_STATUS_OK;
     }
     else{
@@ -389,6 +473,8 @@ void LDL_MAC_forget(struct ldl_mac *self)
 
         self->band[LDL_BAND_GLOBAL] = 0;
 
+        setNextBandEvent(self, timeSync(self));
+
         forgetNetwork(self);
 
         pushSessionUpdate(self);
@@ -413,6 +499,9 @@ void LDL_MAC_cancel(struct ldl_mac *self)
         /* ensure the radio will return to a useful state */
         self->state = LDL_STATE_RADIO_RESET;
         self->radio_interface->set_mode(self->radio, LDL_RADIO_MODE_RESET);
+
+        /* >100us */
+        LDL_MAC_timerSet(self, LDL_TIMER_WAITA, GET_TPS()/U32(1024));
         break;
 
     /* no need to touch radio in these states */
@@ -456,6 +545,12 @@ void LDL_MAC_process(struct ldl_mac *self)
     uint32_t lag = 0;
     bool channel_ready;
 
+    LDL_SYSTEM_ENTER_CRITICAL(self->app)
+
+    (void)timerSync(self);
+
+    LDL_SYSTEM_LEAVE_CRITICAL(self->app)
+
     channel_ready = processBands(self);
 
     if(inputCheck(self, &lag)){
@@ -470,6 +565,12 @@ void LDL_MAC_process(struct ldl_mac *self)
 
         event = LDL_SME_TIMER_B;
     }
+#ifdef LDL_ENABLE_SM_ASYNC
+    else if(micCheck(self)){
+
+        event = LDL_SME_MIC;
+    }
+#endif
     else if(channel_ready){
 
         event = LDL_SME_BAND;
@@ -479,6 +580,14 @@ void LDL_MAC_process(struct ldl_mac *self)
         event = LDL_SME_NONE;
     }
 
+#ifdef LDL_ENABLE_SM_ASYNC
+    /* the result can arrive in any state */
+    if(event == LDL_SME_MIC){
+
+        processMIC(self);
+    }
+    else
+#endif
     if(event != LDL_SME_NONE){
 
         switch(self->state){
@@ -555,10 +664,15 @@ void LDL_MAC_process(struct ldl_mac *self)
 
             processRX2Lockout(self, event);
             break;
+
+#ifdef LDL_ENABLE_SM_ASYNC
+        case LDL_STATE_WAIT_MIC:
+
+            processWaitMIC(self, event);
+            break;
+#endif
         }
     }
-
-    setNextBandEvent(self);
 }
 
 uint32_t LDL_MAC_ticksUntilNextEvent(const struct ldl_mac *self)
@@ -567,8 +681,12 @@ uint32_t LDL_MAC_ticksUntilNextEvent(const struct ldl_mac *self)
 
     uint32_t retval = 0U;
 
-    if(!inputPending(self)){
-
+#ifdef LDL_ENABLE_SM_ASYNC
+    if(!inputPending(self) && !micPending(self))
+#else
+    if(!inputPending(self))
+#endif
+    {
         retval = LDL_MAC_timerTicksUntilNext(self);
     }
 
@@ -665,7 +783,7 @@ bool LDL_MAC_ready(const struct ldl_mac *self)
 
 void LDL_MAC_radioEvent(struct ldl_mac *self)
 {
-    LDL_MAC_radioEventWithTicks(self, self->ticks(self->app));
+    LDL_MAC_radioEventWithTicks(self, getTicks(self));
 }
 
 void LDL_MAC_radioEventWithTicks(struct ldl_mac *self, uint32_t ticks)
@@ -675,6 +793,25 @@ void LDL_MAC_radioEventWithTicks(struct ldl_mac *self, uint32_t ticks)
     inputSignal(self, ticks);
 }
 
+#ifdef LDL_ENABLE_SM_ASYNC
+void LDL_MAC_micComplete(struct ldl_mac *self, uint32_t mic)
+{
+    LDL_PEDANTIC(self != NULL)
+
+    LDL_SYSTEM_ENTER_CRITICAL(self->app)
+
+    self->mic_inputs.busy = false;
+
+    if(self->mic_inputs.wanted){
+
+        self->mic_inputs.mic = mic;
+        self->mic_inputs.state = true;
+    }
+
+    LDL_SYSTEM_LEAVE_CRITICAL(self->app)
+}
+#endif
+
 uint8_t LDL_MAC_mtu(const struct ldl_mac *self)
 {
     LDL_PEDANTIC(self != NULL)
@@ -754,7 +891,11 @@ bool LDL_MAC_addChannel(struct ldl_mac *self, uint8_t chIndex, uint32_t freq, ui
 
     LDL_DEBUG("chIndex=%u freq=%" PRIu32 " minRate=%u maxRate=%u", chIndex, freq, minRate, maxRate)
 
-    return setChannel(self, chIndex, freq, minRate, maxRate);
+    bool retval = setChannel(self, chIndex, freq, minRate, maxRate);
+
+    updateChannelMap(self, chIndex);
+
+    return retval;
 }
 
 bool LDL_MAC_maskChannel(struct ldl_mac *self, uint8_t chIndex)
@@ -763,7 +904,11 @@ bool LDL_MAC_maskChannel(struct ldl_mac *self, uint8_t chIndex)
 
     LDL_DEBUG("chIndex=%u", chIndex)
 
-    return maskChannel(self->ctx.chMask, sizeof(self->ctx.chMask), self->ctx.region, chIndex);
+    bool retval = maskChannel(self->ctx.chMask, sizeof(self->ctx.chMask), self->ctx.region, chIndex);
+
+    updateChannelMap(self, chIndex);
+
+    return retval;
 }
 
 bool LDL_MAC_unmaskChannel(struct ldl_mac *self, uint8_t chIndex)
@@ -772,17 +917,16 @@ bool LDL_MAC_unmaskChannel(struct ldl_mac *self, uint8_t chIndex)
 
     LDL_DEBUG("chIndex=%u", chIndex)
 
-    return unmaskChannel(self->ctx.chMask, sizeof(self->ctx.chMask), self->ctx.region, chIndex);
+    bool retval = unmaskChannel(self->ctx.chMask, sizeof(self->ctx.chMask), self->ctx.region, chIndex);
+
+    updateChannelMap(self, chIndex);
+
+    return retval;
 }
 
 void LDL_MAC_timerSet(struct ldl_mac *self, enum ldl_timer_inst timer, uint32_t timeout)
 {
-    LDL_SYSTEM_ENTER_CRITICAL(self->app)
-
-    self->timers[timer].time = self->ticks(self->app) + (timeout & U32(INT32_MAX));
-    self->timers[timer].armed = true;
-
-    LDL_SYSTEM_LEAVE_CRITICAL(self->app)
+    timerSetTicks(self, timer, timeout & U32(INT32_MAX));
 }
 
 void LDL_MAC_timerAppend(struct ldl_mac *self, enum ldl_timer_inst timer, uint32_t timeout)
@@ -792,25 +936,28 @@ void LDL_MAC_timerAppend(struct ldl_mac *self, enum ldl_timer_inst timer, uint32
     self->timers[timer].time += (timeout & U32(INT32_MAX));
     self->timers[timer].armed = true;
 
+    timerUpdateEarliest(self, timerSync(self));
+
     LDL_SYSTEM_LEAVE_CRITICAL(self->app)
 }
 
 bool LDL_MAC_timerCheck(struct ldl_mac *self, enum ldl_timer_inst timer, uint32_t *lag)
 {
     bool retval = false;
-    uint32_t time;
+    ldl_ticks_t time;
 
     LDL_SYSTEM_ENTER_CRITICAL(self->app)
 
     if(self->timers[timer].armed){
 
-        time = self->ticks(self->app);
+        time = timerSync(self);
 
-        if(timerDelta(self->timers[timer].time, time) < U32(INT32_MAX)){
+        if(timerUntil(self->timers[timer].time, time, lag) == 0U){
 
             self->timers[timer].armed = false;
-            *lag = timerDelta(self->timers[timer].time, time);
             retval = true;
+
+            timerUpdateEarliest(self, time);
         }
     }
 
@@ -821,68 +968,67 @@ bool LDL_MAC_timerCheck(struct ldl_mac *self, enum ldl_timer_inst timer, uint32_
 
 void LDL_MAC_timerClear(struct ldl_mac *self, enum ldl_timer_inst timer)
 {
-    self->timers[timer].armed = false;
-}
-
-uint32_t LDL_MAC_timerTicksUntilNext(const struct ldl_mac *self)
-{
-    size_t i;
-    uint32_t retval = UINT32_MAX;
-    uint32_t time;
-
-    time = self->ticks(self->app);
-
-    for(i=0U; i < sizeof(self->timers)/sizeof(*self->timers); i++){
-
-        LDL_SYSTEM_ENTER_CRITICAL(self->app)
+    LDL_SYSTEM_ENTER_CRITICAL(self->app)
 
-        if(self->timers[i].armed){
+    if(self->timers[timer].armed){
 
-            if(timerDelta(self->timers[i].time, time) <= U32(INT32_MAX)){
+        self->timers[timer].armed = false;
 
-                retval = 0U;
-            }
-            else{
+        timerUpdateEarliest(self, timerSync(self));
+    }
 
-                if(timerDelta(time, self->timers[i].time) < retval){
+    LDL_SYSTEM_LEAVE_CRITICAL(self->app)
+}
 
-                    retval = timerDelta(time, self->timers[i].time);
-                }
-            }
-        }
+uint32_t LDL_MAC_timerTicksUntilNext(const struct ldl_mac *self)
+{
+    uint32_t retval = UINT32_MAX;
+    uint32_t lag;
 
-        LDL_SYSTEM_LEAVE_CRITICAL(self->app)
+    LDL_SYSTEM_ENTER_CRITICAL(self->app)
 
-        if(retval == 0U){
+    if(self->earliest.armed){
 
-            break;
-        }
+        retval = timerUntil(self->earliest.time, timerNow(self), &lag);
     }
 
+    LDL_SYSTEM_LEAVE_CRITICAL(self->app)
+
     return retval;
 }
 
 uint32_t LDL_MAC_timerTicksUntil(const struct ldl_mac *self, enum ldl_timer_inst timer, uint32_t *lag)
 {
     uint32_t retval = UINT32_MAX;
-    uint32_t time;
 
     LDL_SYSTEM_ENTER_CRITICAL(self->app)
 
     if(self->timers[timer].armed){
 
-        time = self->ticks(self->app);
+        retval = timerUntil(self->timers[timer].time, timerNow(self), lag);
+    }
+
+    LDL_SYSTEM_LEAVE_CRITICAL(self->app)
 
-        *lag = timerDelta(self->timers[timer].time, time);
+    return retval;
+}
 
-        if(*lag <= U32(INT32_MAX)){
+bool LDL_MAC_priority(const struct ldl_mac *self, uint8_t interval)
+{
+    LDL_PEDANTIC(self != NULL)
 
-            retval = 0U;
-        }
-        else{
+    bool retval = false;
+    ldl_ticks_t now;
+    ldl_ticks_t deadline;
+    uint32_t lag;
 
-            retval = timerDelta(time, self->timers[timer].time);
-        }
+    LDL_SYSTEM_ENTER_CRITICAL(self->app)
+
+    now = timerNow(self);
+
+    if(priorityDeadline(self, now, &deadline)){
+
+        retval = (U64(timerUntil(deadline, now, &lag)) <= (U64(interval) * U64(GET_TPS())));
     }
 
     LDL_SYSTEM_LEAVE_CRITICAL(self->app)
@@ -890,26 +1036,23 @@ uint32_t LDL_MAC_timerTicksUntil(const struct ldl_mac *self, enum ldl_timer_inst
     return retval;
 }
 
-bool LDL_MAC_priority(const struct ldl_mac *self, uint8_t interval)
+bool LDL_MAC_priorityDeadline(const struct ldl_mac *self, uint32_t *ticks)
 {
     LDL_PEDANTIC(self != NULL)
+    LDL_PEDANTIC(ticks != NULL)
 
     bool retval;
+    ldl_ticks_t deadline;
 
-    /* todo */
-    (void)interval;
+    LDL_SYSTEM_ENTER_CRITICAL(self->app)
 
-    switch(self->state){
-    default:
-        retval = false;
-        break;
-    case LDL_STATE_TX:
-    case LDL_STATE_WAIT_RX1:
-    case LDL_STATE_RX1:
-    case LDL_STATE_WAIT_RX2:
-    case LDL_STATE_RX2:
-        retval = true;
-        break;
+    retval = priorityDeadline(self, timerNow(self), &deadline);
+
+    LDL_SYSTEM_LEAVE_CRITICAL(self->app)
+
+    if(retval){
+
+        *ticks = U32(deadline);
     }
 
     return retval;
@@ -919,7 +1062,7 @@ uint32_t LDL_MAC_getTicks(struct ldl_mac *self)
 {
     LDL_PEDANTIC(self != NULL)
 
-    return self->ticks(self->app);
+    return getTicks(self);
 }
 
 #ifdef LDL_ENABLE_TEST_MODE
@@ -957,7 +1100,7 @@ static void processInit(struct ldl_mac *self)
     LDL_MAC_timerSet(self, LDL_TIMER_WAITA, GET_TPS()/U32(1024));
 
     LDL_DEBUG("set radio reset: ticks=%" PRIu32 "",
-        self->ticks(self->app)
+        getTicks(self)
     )
 }
 
@@ -972,7 +1115,7 @@ static void processRadioReset(struct ldl_mac *self, enum ldl_mac_sme event)
         LDL_MAC_timerSet(self, LDL_TIMER_WAITA, GET_TPS()/U32(128));
 
         LDL_DEBUG("clear radio reset: ticks=%" PRIu32 "",
-            self->ticks(self->app)
+            getTicks(self)
         )
     }
 }
@@ -1023,7 +1166,7 @@ static void processStartRadioForEntropy(struct ldl_mac *self, enum ldl_mac_sme e
         /* ~1ms */
         LDL_MAC_timerSet(self, LDL_TIMER_WAITA, GET_TPS()/U32(1024));
 
-        LDL_DEBUG("listen for entropy: ticks=%" PRIu32 "", self->ticks(self->app))
+        LDL_DEBUG("listen for entropy: ticks=%" PRIu32 "", getTicks(self))
     }
 }
 
@@ -1041,7 +1184,7 @@ static void processEntropy(struct ldl_mac *self, enum ldl_mac_sme event)
         self->op = LDL_OP_NONE;
 
         LDL_DEBUG("read entropy: ticks=%" PRIu32 " entropy=%" PRIu32 "",
-            self->ticks(self->app),
+            getTicks(self),
             arg.entropy.value
         )
 
@@ -1070,7 +1213,7 @@ static void processWaitOTAA(struct ldl_mac *self, enum ldl_mac_sme event)
         delay = self->rand(self->app) % (GET_TPS()*U32(30));
 #endif
         LDL_DEBUG("add dither to otaa: ticks=%" PRIu32 " delay=%" PRIu32 "",
-            self->ticks(self->app),
+            getTicks(self),
             delay
         )
 
@@ -1095,6 +1238,16 @@ static void processWait(struct ldl_mac *self, enum ldl_mac_sme event, uint32_t l
         case LDL_STATE_WAIT_TX:
             self->state = LDL_STATE_START_RADIO_FOR_TX;
             self->radio_interface->set_mode(self->radio, LDL_RADIO_MODE_TX);
+            /* load the radio while the XTAL starts so that only the
+             * TX command is left for when the timer expires */
+            if(txIsPrepared(self)){
+
+                struct ldl_radio_tx_setting setting;
+
+                (void)txSetting(self, &setting);
+
+                self->radio_interface->prepare_transmit(self->radio, &setting, self->buffer, self->bufferLen);
+            }
             timer = LDL_TIMER_WAITA;
             break;
         case LDL_STATE_WAIT_RX1:
@@ -1119,7 +1272,7 @@ static void processWait(struct ldl_mac *self, enum ldl_mac_sme event, uint32_t l
         LDL_MAC_timerAppend(self, timer, delay);
 #if 0
         LDL_DEBUG("start xtal: ticks=%" PRIu32 " delay=%" PRIu32 "",
-            self->ticks(self->app),
+            getTicks(self),
             delay
         )
 #endif
@@ -1134,65 +1287,38 @@ static void processWait(struct ldl_mac *self, enum ldl_mac_sme event, uint32_t l
 static void processStartRadioForTX(struct ldl_mac *self, enum ldl_mac_sme event)
 {
     struct ldl_radio_tx_setting setting;
-    uint8_t mtu;
-    uint32_t ms;
+    uint32_t quarters;
 
     if(event == LDL_SME_TIMER_A){
 
-        LDL_Region_convertRate(self->ctx.region, self->tx.rate, &setting.sf, &setting.bw, &mtu);
+        quarters = txSetting(self, &setting);
 
-        setting.eirp = LDL_Region_getTXPower(self->ctx.region, self->tx.power);
+        self->tx.airTime = airTimeTime(setting.sf, setting.bw, quarters);
 
-#ifndef LDL_DISABLE_TX_PARAM_SETUP
-        if(LDL_Region_txParamSetupImplemented(self->ctx.region)){
-
-            static const int8_t maxEIRP[] = {
-                8,
-                10,
-                12,
-                13,
-                14,
-                16,
-                18,
-                20,
-                21,
-                24,
-                26,
-                27,
-                29,
-                30,
-                33,
-                36
-            };
-
-            int16_t max_eirp = (int16_t)maxEIRP[self->ctx.tx_param_setup & 0xfU];
-
-            max_eirp *= 100;
-
-            if(setting.eirp > max_eirp){
-
-                setting.eirp = max_eirp;
-            }
-        }
-#endif
-        setting.freq = self->tx.freq;
+        inputArm(self);
 
-        ms = LDL_Radio_getAirTime(setting.bw, setting.sf, self->bufferLen, true);
+#ifdef LDL_ENABLE_SM_ASYNC
+        /* a result for the previous uplink is no longer relevant */
+        abandonMIC(self);
+#endif
 
-        self->tx.airTime = msToTime(ms);
+        if(txIsPrepared(self)){
 
-        inputArm(self);
+            self->radio_interface->start_transmit(self->radio);
+        }
+        else{
 
-        self->radio_interface->transmit(self->radio, &setting, self->buffer, self->bufferLen);
+            self->radio_interface->transmit(self->radio, &setting, self->buffer, self->bufferLen);
+        }
 
         self->state = LDL_STATE_TX;
 
         /* reset the radio if the tx complete interrupt doesn't appear after double the expected time */
-        LDL_MAC_timerSet(self, LDL_TIMER_WAITA, msToTicks(self, ms) << 1);
+        LDL_MAC_timerSet(self, LDL_TIMER_WAITA, airTimeTicks(self, setting.sf, setting.bw, quarters) << 1);
 
         LDL_INFO("tx begin")
         LDL_DEBUG("ticks=%" PRIu32 " freq=%" PRIu32 " power=%u  bw=%" PRIu32 " sf=%u size=%u",
-            self->ticks(self->app),
+            getTicks(self),
             self->tx.freq,
             self->tx.power,
             LDL_Radio_bwToNumber(setting.bw),
@@ -1202,6 +1328,56 @@ static void processStartRadioForTX(struct ldl_mac *self, enum ldl_mac_sme event)
     }
 }
 
+static uint32_t txSetting(const struct ldl_mac *self, struct ldl_radio_tx_setting *setting)
+{
+    uint8_t mtu;
+
+    LDL_Region_convertRate(self->ctx.region, self->tx.rate, &setting->sf, &setting->bw, &mtu);
+
+    setting->eirp = LDL_Region_getTXPower(self->ctx.region, self->tx.power);
+
+#ifndef LDL_DISABLE_TX_PARAM_SETUP
+    if(LDL_Region_txParamSetupImplemented(self->ctx.region)){
+
+        static const int8_t maxEIRP[] = {
+            8,
+            10,
+            12,
+            13,
+            14,
+            16,
+            18,
+            20,
+            21,
+            24,
+            26,
+            27,
+            29,
+            30,
+            33,
+            36
+        };
+
+        int16_t max_eirp = (int16_t)maxEIRP[self->ctx.tx_param_setup & 0xfU];
+
+        max_eirp *= 100;
+
+        if(setting->eirp > max_eirp){
+
+            setting->eirp = max_eirp;
+        }
+    }
+#endif
+    setting->freq = self->tx.freq;
+
+    return packetQuarters(setting->sf, setting->bw, self->bufferLen, true);
+}
+
+static bool txIsPrepared(const struct ldl_mac *self)
+{
+    return (self->radio_interface->prepare_transmit != NULL) && (self->radio_interface->start_transmit != NULL);
+}
+
 static void processTX(struct ldl_mac *self, enum ldl_mac_sme event, uint32_t lag)
 {
     uint32_t waitSeconds;
@@ -1216,6 +1392,7 @@ static void processTX(struct ldl_mac *self, enum ldl_mac_sme event, uint32_t lag
     uint32_t xtal_error;
     uint8_t mtu;
     uint32_t margin;
+    uint32_t symbol;
     struct ldl_radio_status status;
 
     (void)memset(&status, 0, sizeof(status));
@@ -1238,13 +1415,13 @@ static void processTX(struct ldl_mac *self, enum ldl_mac_sme event, uint32_t lag
     if(event == LDL_SME_TIMER_A){
 
         LDL_ERROR("interrupt fault")
-        LDL_DEBUG("ticks=%" PRIu32 "", self->ticks(self->app))
+        LDL_DEBUG("ticks=%" PRIu32 "", getTicks(self))
         handleRadioError(self);
     }
     else if((event == LDL_SME_INTERRUPT) && !status.tx){
 
         LDL_ERROR("unexpected status")
-        LDL_DEBUG("ticks=%" PRIu32 "", self->ticks(self->app))
+        LDL_DEBUG("ticks=%" PRIu32 "", getTicks(self))
         handleRadioError(self);
     }
     else if((event == LDL_SME_INTERRUPT) && status.tx){
@@ -1258,7 +1435,7 @@ static void processTX(struct ldl_mac *self, enum ldl_mac_sme event, uint32_t lag
         waitTicks = waitSeconds * GET_TPS();
 
 #ifndef LDL_DISABLE_DEVICE_TIME
-        self->ticks_at_tx = self->ticks(self->app) - lag;
+        self->ticks_at_tx = getTicks(self) - lag;
 #endif
         advance = GET_ADVANCE() + lag + msToTicks(self, LDL_PARAM_XTAL_DELAY);
 
@@ -1269,12 +1446,14 @@ static void processTX(struct ldl_mac *self, enum ldl_mac_sme event, uint32_t lag
 
             xtal_error = (waitSeconds * GET_A() * U32(2)) + GET_B();
 
-            extra_symbols = extraSymbols(xtal_error, symbolPeriod(GET_TPS(), sf, bw));
+            symbol = symbolTicks(self, sf, bw);
+
+            extra_symbols = extraSymbols(xtal_error, symbol);
 
             /* we need a minimum of 3 extra symbols */
             extra_symbols = (extra_symbols < U32(3)) ? U32(3) : extra_symbols;
 
-            margin = extra_symbols * symbolPeriod(GET_TPS(), sf, bw);
+            margin = extra_symbols * symbol;
             self->rx1_symbols = U16(5) + U16(extra_symbols);
 
             /* advance timer by time required for extra symbols */
@@ -1287,12 +1466,14 @@ static void processTX(struct ldl_mac *self, enum ldl_mac_sme event, uint32_t lag
 
             xtal_error += (GET_A() * U32(2));
 
-            extra_symbols = extraSymbols(xtal_error, symbolPeriod(GET_TPS(), sf, bw));
+            symbol = symbolTicks(self, sf, bw);
+
+            extra_symbols = extraSymbols(xtal_error, symbol);
 
             /* we need a minimum of 3 extra symbols */
             extra_symbols = (extra_symbols < U32(3)) ? U32(3) : extra_symbols;
 
-            margin = extra_symbols * symbolPeriod(GET_TPS(), sf, bw);
+            margin = extra_symbols * symbol;
             self->rx2_symbols = U16(5) + U16(extra_symbols);
 
             /* advance timer by time required for extra symbols */
@@ -1325,7 +1506,7 @@ static void processTX(struct ldl_mac *self, enum ldl_mac_sme event, uint32_t lag
         self->radio_interface->set_mode(self->radio, LDL_RADIO_MODE_HOLD);
 
         LDL_INFO("tx complete")
-        LDL_DEBUG("ticks=%" PRIu32 "", self->ticks(self->app))
+        LDL_DEBUG("ticks=%" PRIu32 "", getTicks(self))
     }
     else{
 
@@ -1359,12 +1540,12 @@ static void processStartRadioForRX1(struct ldl_mac *self, enum ldl_mac_sme event
 
         self->radio_interface->receive(self->radio, &setting);
 
-        /* use waitA as a guard (timeout after ~4 seconds) */
-        LDL_MAC_timerSet(self, LDL_TIMER_WAITA, (GET_TPS() + GET_A()) << 2U);
+        /* use waitA as a guard */
+        LDL_MAC_timerSet(self, LDL_TIMER_WAITA, guardTicks(self));
 
         LDL_INFO("rx1 slot")
         LDL_DEBUG("ticks=%" PRIu32 " timeout=%" PRIu16 " lag=%" PRIu32 " freq=%" PRIu32 " bw=%" PRIu32 " sf=%u",
-            self->ticks(self->app),
+            getTicks(self),
             self->rx1_symbols,
             lag,
             freq,
@@ -1394,11 +1575,11 @@ static void processStartRadioForRX2(struct ldl_mac *self, enum ldl_mac_sme event
         self->radio_interface->receive(self->radio, &setting);
 
         /* use waitA as a guard */
-        LDL_MAC_timerSet(self, LDL_TIMER_WAITA, (GET_TPS() + GET_A()) * 4U);
+        LDL_MAC_timerSet(self, LDL_TIMER_WAITA, guardTicks(self));
 
         LDL_INFO("rx2 slot")
         LDL_DEBUG("ticks=%" PRIu32 " timeout=%" PRIu16 " lag=%" PRIu32 " freq=%" PRIu32 " bw=%" PRIu32 " sf=%u",
-            self->ticks(self->app),
+            getTicks(self),
             self->rx2_symbols,
             lag,
             self->ctx.rx2Freq,
@@ -1421,8 +1602,12 @@ static void processRX(struct ldl_mac *self, enum ldl_mac_sme event)
     uint8_t mtu;
     enum ldl_spreading_factor sf;
     enum ldl_signal_bandwidth bw;
-    union ldl_mac_response_arg arg;
-    uint32_t ms;
+    struct ldl_ops_mic arg;
+    uint32_t mic;
+    bool valid;
+#ifdef LDL_ENABLE_SM_ASYNC
+    bool pending;
+#endif
 
     struct ldl_radio_status status;
 
@@ -1436,7 +1621,7 @@ static void processRX(struct ldl_mac *self, enum ldl_mac_sme event)
     if(event == LDL_SME_TIMER_A){
 
         LDL_ERROR("interrupt fault")
-        LDL_DEBUG("ticks=%" PRIu32 "", self->ticks(self->app))
+        LDL_DEBUG("ticks=%" PRIu32 "", getTicks(self))
 
         self->radio_interface->get_status(self->radio, &status);
 
@@ -1445,169 +1630,86 @@ static void processRX(struct ldl_mac *self, enum ldl_mac_sme event)
     else if((event == LDL_SME_INTERRUPT) && !status.rx && !status.timeout){
 
         LDL_ERROR("unexpected status")
-        LDL_DEBUG("ticks=%" PRIu32 "", self->ticks(self->app))
+        LDL_DEBUG("ticks=%" PRIu32 "", getTicks(self))
 
         handleRadioError(self);
     }
     else if((event == LDL_SME_INTERRUPT) && status.rx){
 
         LDL_MAC_timerClear(self, LDL_TIMER_WAITA);
-        LDL_MAC_timerClear(self, LDL_TIMER_WAITB);
 
         len = self->radio_interface->read_buffer(self->radio, &meta, buffer, LDL_MAX_PACKET);
 
-        self->radio_interface->set_mode(self->radio, LDL_RADIO_MODE_SLEEP);
-
         self->rx_snr = meta.snr;
 
         LDL_DEBUG("downlink: ticks=%" PRIu32 " rssi=%d snr=%d size=%u",
-            self->ticks(self->app),
+            getTicks(self),
             meta.rssi,
             meta.snr,
             len
         )
 
-        if(LDL_OPS_receiveFrame(self, &frame, buffer, len)){
-
-            switch(frame.type){
-            default:
-            case FRAME_TYPE_JOIN_ACCEPT:
-
-                self->ctx.joined = true;
-
-                /* keep the joining rate */
-                self->ctx.rate = self->ctx.adr ? LDL_Region_getJoinRate(self->ctx.region, self->trials) : self->ctx.rate;
-
-                self->ctx.rx1DROffset = frame.rx1DataRateOffset;
-                self->ctx.rx2DataRate = frame.rx2DataRate;
-                self->ctx.rx1Delay = frame.rxDelay;
-
-                if(frame.cfList != NULL){
-
-                    LDL_Region_processCFList(self->ctx.region, self, frame.cfList, frame.cfListLen);
-                }
-
-                self->ctx.devAddr = frame.devAddr;
-
-#if defined(LDL_ENABLE_L2_1_1)
-                self->ctx.version = (frame.optNeg) ? 1U : 0U;
-
-                if(SESS_VERSION(self->ctx) > 0U){
+#ifdef LDL_ENABLE_SM_ASYNC
+        /* this frame replaces any from RX1 still being checked */
+        abandonMIC(self);
 
-                    setPendingCommand(self, LDL_CMD_REKEY);
-                }
+        pending = false;
 #endif
-                /* cache this so that the session keys can be re-derived */
-                self->ctx.netID = frame.netID;
-                self->ctx.joinNonce = frame.joinNonce;
-                /* self->ctx.devNonce is already set */
-
-                self->joinNonce = frame.joinNonce;
-
-                LDL_OPS_deriveKeys(self);
-
-                self->joinNonce++;
-
-                LDL_INFO("join accept: joinNonce=%" PRIu32 " devNonce=%" PRIu16 " netID=%" PRIu32 " devAddr=%" PRIu32 " rx1Delay=%u",
-                    self->ctx.joinNonce,
-                    self->ctx.devNonce,
-                    self->ctx.netID,
-                    self->ctx.devAddr,
-                    self->ctx.rx1Delay
-                )
-
-                self->band[LDL_BAND_GLOBAL] = 0;
-                self->day = 0;
-                self->state = LDL_STATE_IDLE;
-                self->op = LDL_OP_NONE;
-
-                arg.join_complete.joinNonce = self->joinNonce;
-                arg.join_complete.netID = self->ctx.netID;
-                arg.join_complete.devAddr = self->ctx.devAddr;
-
-                self->handler(self->app, LDL_MAC_JOIN_COMPLETE, &arg);
-                break;
-
-            case FRAME_TYPE_DATA_CONFIRMED_DOWN:
-            case FRAME_TYPE_DATA_UNCONFIRMED_DOWN:
-
-                /* if set it means network has more data to send */
-                self->fPending = frame.pending;
-
-                self->pendingACK = (frame.type == FRAME_TYPE_DATA_CONFIRMED_DOWN);
-
-                LDL_OPS_syncDownCounter(self, frame.port, frame.counter);
-
-                clearPendingCommand(self, LDL_CMD_RX_PARAM_SETUP);
-                clearPendingCommand(self, LDL_CMD_DL_CHANNEL);
-                clearPendingCommand(self, LDL_CMD_RX_TIMING_SETUP);
+        valid = false;
 
-                self->adrAckCounter = 0;
-                self->adrAckReq = false;
+        if(LDL_OPS_prepareMIC(self, &frame, buffer, len, &arg)){
 
-                if(frame.opts != NULL){
+#ifdef LDL_ENABLE_SM_ASYNC
+            pending = beginMIC(self, &arg, buffer, len);
 
-                    processCommands(self, frame.opts, frame.optsLen);
-                }
-
-                if(frame.data != NULL){
-
-                    if(frame.port == 0U){
+            if(!pending)
+#endif
+            {
+                mic = self->sm_interface->mic(self->sm, arg.key, arg.hdr, arg.hdrLen, buffer, len - U8(sizeof(mic)));
 
-                        processCommands(self, frame.data, frame.dataLen);
-                    }
-                    else{
+                valid = LDL_OPS_checkMIC(self, &frame, mic);
+            }
+        }
 
-                        arg.rx.port = frame.port;
-                        arg.rx.data = frame.data;
-                        arg.rx.size = frame.dataLen;
+        if(valid){
 
-                        self->handler(self->app, LDL_MAC_RX, &arg);
-                    }
-                }
+            self->radio_interface->set_mode(self->radio, LDL_RADIO_MODE_SLEEP);
 
-                switch(self->op){
-                default:
-                case LDL_OP_DATA_UNCONFIRMED:
+            LDL_MAC_timerClear(self, LDL_TIMER_WAITB);
 
-                    self->handler(self->app, LDL_MAC_DATA_COMPLETE, NULL);
-                    break;
+            handleDownlink(self, &frame);
+        }
+#ifdef LDL_ENABLE_SM_ASYNC
+        else if(pending && (self->state == LDL_STATE_RX2)){
 
-                case LDL_OP_DATA_CONFIRMED:
+            self->radio_interface->set_mode(self->radio, LDL_RADIO_MODE_SLEEP);
 
-                    if(frame.ack){
+            LDL_MAC_timerClear(self, LDL_TIMER_WAITB);
 
-                        self->handler(self->app, LDL_MAC_DATA_COMPLETE, NULL);
-                    }
-                    else{
+            self->state = LDL_STATE_WAIT_MIC;
 
-                        LDL_DEBUG("NAK received in response to confirmed uplink")
-
-                        /* I don't see how this would ever happen
-                         * in practice since downlinks are sent
-                         * in response to having receied an uplink.
-                         *
-                         * For this reason simply handle it as a timeout
-                         * regardless of the number of attempts requested.
-                         *
-                         *  */
-                        self->handler(self->app, LDL_MAC_DATA_TIMEOUT, NULL);
-                    }
-                    break;
+            /* use waitA as a guard */
+            LDL_MAC_timerSet(self, LDL_TIMER_WAITA, guardTicks(self));
 
-                case LDL_OP_REJOINING:
-                    break;
-                }
+            LDL_DEBUG("waiting for mic")
+        }
+#endif
+        else if(self->state == LDL_STATE_RX1){
 
-                self->state = LDL_STATE_IDLE;
-                self->op = LDL_OP_NONE;
-                break;
-            }
+            /* carry on with RX2 whether the frame failed or its MIC
+             * is still being checked
+             *
+             * waitB is left running so that RX2 is still opened on time */
+            self->radio_interface->set_mode(self->radio, LDL_RADIO_MODE_HOLD);
 
-            pushSessionUpdate(self);
+            self->state = LDL_STATE_WAIT_RX2;
         }
         else{
 
+            self->radio_interface->set_mode(self->radio, LDL_RADIO_MODE_SLEEP);
+
+            LDL_MAC_timerClear(self, LDL_TIMER_WAITB);
+
             downlinkMissingHandler(self);
         }
     }
@@ -1621,9 +1723,7 @@ static void processRX(struct ldl_mac *self, enum ldl_mac_sme event)
 
             LDL_Region_convertRate(self->ctx.region, self->tx.rate, &sf, &bw, &mtu);
 
-            ms = LDL_Radio_getAirTime(bw, sf, mtu, false);
-
-            LDL_MAC_timerSet(self, LDL_TIMER_WAITA, msToTicks(self, ms));
+            LDL_MAC_timerSet(self, LDL_TIMER_WAITA, airTimeTicks(self, sf, bw, packetQuarters(sf, bw, mtu, false)));
 
             self->state = LDL_STATE_RX2_LOCKOUT;
         }
@@ -1642,22 +1742,178 @@ static void processRX(struct ldl_mac *self, enum ldl_mac_sme event)
     }
 }
 
-static void processRX2Lockout(struct ldl_mac *self, enum ldl_mac_sme event)
+static void handleDownlink(struct ldl_mac *self, struct ldl_frame_down *frame)
 {
-    if(event == LDL_SME_TIMER_A){
+    union ldl_mac_response_arg arg;
 
-        downlinkMissingHandler(self);
-    }
-}
+    switch(frame->type){
+    default:
+    case FRAME_TYPE_JOIN_ACCEPT:
 
-static void handleRadioError(struct ldl_mac *self)
-{
-    inputDisarm(self);
-    LDL_MAC_timerClear(self, LDL_TIMER_WAITA);
-    LDL_MAC_timerClear(self, LDL_TIMER_WAITB);
+        self->ctx.joined = true;
 
-    switch(self->op){
-    default:
+        /* keep the joining rate */
+        self->ctx.rate = self->ctx.adr ? LDL_Region_getJoinRate(self->ctx.region, self->trials) : self->ctx.rate;
+
+        self->ctx.rx1DROffset = frame->rx1DataRateOffset;
+        self->ctx.rx2DataRate = frame->rx2DataRate;
+        self->ctx.rx1Delay = frame->rxDelay;
+
+        if(frame->cfList != NULL){
+
+            LDL_Region_processCFList(self->ctx.region, self, frame->cfList, frame->cfListLen);
+        }
+
+        self->ctx.devAddr = frame->devAddr;
+
+#if defined(LDL_ENABLE_L2_1_1)
+        self->ctx.version = (frame->optNeg) ? 1U : 0U;
+
+        if(SESS_VERSION(self->ctx) > 0U){
+
+            setPendingCommand(self, LDL_CMD_REKEY);
+        }
+#endif
+        /* cache this so that the session keys can be re-derived */
+        self->ctx.netID = frame->netID;
+        self->ctx.joinNonce = frame->joinNonce;
+        /* self->ctx.devNonce is already set */
+
+        self->joinNonce = frame->joinNonce;
+
+        LDL_OPS_deriveKeys(self);
+
+        self->joinNonce++;
+
+        LDL_INFO("join accept: joinNonce=%" PRIu32 " devNonce=%" PRIu16 " netID=%" PRIu32 " devAddr=%" PRIu32 " rx1Delay=%u",
+            self->ctx.joinNonce,
+            self->ctx.devNonce,
+            self->ctx.netID,
+            self->ctx.devAddr,
+            self->ctx.rx1Delay
+        )
+
+        self->band[LDL_BAND_GLOBAL] = 0;
+        self->day = 0;
+        self->state = LDL_STATE_IDLE;
+        self->op = LDL_OP_NONE;
+
+        setNextBandEvent(self, timeSync(self));
+
+        arg.join_complete.joinNonce = self->joinNonce;
+        arg.join_complete.netID = self->ctx.netID;
+        arg.join_complete.devAddr = self->ctx.devAddr;
+
+        self->handler(self->app, LDL_MAC_JOIN_COMPLETE, &arg);
+        break;
+
+    case FRAME_TYPE_DATA_CONFIRMED_DOWN:
+    case FRAME_TYPE_DATA_UNCONFIRMED_DOWN:
+
+        /* if set it means network has more data to send */
+        self->fPending = frame->pending;
+
+        self->pendingACK = (frame->type == FRAME_TYPE_DATA_CONFIRMED_DOWN);
+
+        LDL_OPS_syncDownCounter(self, frame->port, frame->counter);
+
+        clearPendingCommand(self, LDL_CMD_RX_PARAM_SETUP);
+        clearPendingCommand(self, LDL_CMD_DL_CHANNEL);
+        clearPendingCommand(self, LDL_CMD_RX_TIMING_SETUP);
+
+        self->adrAckCounter = 0;
+        self->adrAckReq = false;
+
+        if(frame->opts != NULL){
+
+            processCommands(self, frame->opts, frame->optsLen);
+        }
+
+        if(frame->data != NULL){
+
+            if(frame->port == 0U){
+
+                processCommands(self, frame->data, frame->dataLen);
+            }
+            else{
+
+                arg.rx.port = frame->port;
+                arg.rx.data = frame->data;
+                arg.rx.size = frame->dataLen;
+
+                self->handler(self->app, LDL_MAC_RX, &arg);
+            }
+        }
+
+        switch(self->op){
+        default:
+        case LDL_OP_DATA_UNCONFIRMED:
+
+            self->handler(self->app, LDL_MAC_DATA_COMPLETE, NULL);
+            break;
+
+        case LDL_OP_DATA_CONFIRMED:
+
+            if(frame->ack){
+
+                self->handler(self->app, LDL_MAC_DATA_COMPLETE, NULL);
+            }
+            else{
+
+                LDL_DEBUG("NAK received in response to confirmed uplink")
+
+                /* I don't see how this would ever happen
+                 * in practice since downlinks are sent
+                 * in response to having receied an uplink.
+                 *
+                 * For this reason simply handle it as a timeout
+                 * regardless of the number of attempts requested.
+                 *
+                 *  */
+                self->handler(self->app, LDL_MAC_DATA_TIMEOUT, NULL);
+            }
+            break;
+
+        case LDL_OP_REJOINING:
+            break;
+        }
+
+        self->state = LDL_STATE_IDLE;
+        self->op = LDL_OP_NONE;
+        break;
+    }
+
+    pushSessionUpdate(self);
+}
+
+static void processRX2Lockout(struct ldl_mac *self, enum ldl_mac_sme event)
+{
+    if(event == LDL_SME_TIMER_A){
+
+#ifdef LDL_ENABLE_SM_ASYNC
+        /* still waiting to hear about the frame from RX1 */
+        if(self->mic_inputs.wanted){
+
+            self->state = LDL_STATE_WAIT_MIC;
+
+            LDL_MAC_timerSet(self, LDL_TIMER_WAITA, guardTicks(self));
+        }
+        else
+#endif
+        {
+            downlinkMissingHandler(self);
+        }
+    }
+}
+
+static void handleRadioError(struct ldl_mac *self)
+{
+    inputDisarm(self);
+    LDL_MAC_timerClear(self, LDL_TIMER_WAITA);
+    LDL_MAC_timerClear(self, LDL_TIMER_WAITB);
+
+    switch(self->op){
+    default:
     case LDL_OP_NONE:
     case LDL_OP_DATA_CONFIRMED:
     case LDL_OP_DATA_UNCONFIRMED:
@@ -1927,8 +2183,6 @@ static enum ldl_mac_status externalDataCommand(struct ldl_mac *self, bool confir
 
                             self->bufferLen = LDL_OPS_prepareData(self, &f, self->buffer, U8(sizeof(self->buffer)));
 
-                            LDL_OPS_micDataFrame(self, self->buffer, self->bufferLen);
-
                             if(self->state == LDL_STATE_IDLE){
 
                                 self->state = LDL_STATE_WAIT_TX;
@@ -1936,7 +2190,7 @@ static enum ldl_mac_status externalDataCommand(struct ldl_mac *self, bool confir
                             }
 
                             LDL_DEBUG("initiate data: ticks=%" PRIu32,
-                                self->ticks(self->app)
+                                getTicks(self)
                             )
                         }
                         else{
@@ -2004,6 +2258,7 @@ static bool adaptRate(struct ldl_mac *self)
                                 LDL_DEBUG("adr: all channels unmasked")
 
                                 unmaskAllChannels(self->ctx.chMask, sizeof(self->ctx.chMask));
+                                rebuildChannelMap(self);
 
                                 self->adrAckCounter = UINT8_MAX;
                             }
@@ -2026,11 +2281,6 @@ static bool adaptRate(struct ldl_mac *self)
     return session_changed;
 }
 
-static uint32_t symbolPeriod(uint32_t tps, enum ldl_spreading_factor sf, enum ldl_signal_bandwidth bw)
-{
-    return (((U32(1)) << sf) * tps) / LDL_Radio_bwToNumber(bw);
-}
-
 static uint32_t extraSymbols(uint32_t xtal_error, uint32_t symbol_period)
 {
     return (xtal_error / symbol_period) + (((xtal_error % symbol_period) > 0U) ? U32(1) : U32(0));
@@ -2397,7 +2647,7 @@ static void processCommands(struct ldl_mac *self, const uint8_t *in, uint8_t len
             arg.device_time.time <<= 8;
             arg.device_time.time |= U64(cmd.fields.deviceTime.fractions);
 
-            lag = timerDelta(self->ticks_at_tx, self->ticks(self->app));
+            lag = timerDelta(self->ticks_at_tx, getTicks(self));
 
             arg.device_time.time += (U64(lag) * U64(timeTPS) / U64(GET_TPS()));
 
@@ -2481,12 +2731,16 @@ static void processCommands(struct ldl_mac *self, const uint8_t *in, uint8_t len
         self->ctx.power = power;
         self->ctx.nbTrans = nbTrans;
     }
+
+    /* LinkADRReq and NewChannelReq work on the session directly */
+    rebuildChannelMap(self);
 }
 
 static void registerTime(struct ldl_mac *self, const struct ldl_mac_tx *tx)
 {
     uint8_t band;
     uint32_t offTime;
+    uint32_t now = timeSync(self);
 
     if(LDL_Region_getBand(self->ctx.region, tx->freq, &band)){
 
@@ -2494,36 +2748,24 @@ static void registerTime(struct ldl_mac *self, const struct ldl_mac_tx *tx)
 
         offTime = tx->airTime * LDL_Region_getOffTimeFactor(self->ctx.region, band);
 
-        if((self->band[band] + offTime) < self->band[band]){
-
-            self->band[band] = UINT32_MAX;
-        }
-        else{
-
-            self->band[band] += offTime;
-        }
+        self->band[band] = deadlineExtend(self->band[band], now, offTime);
     }
 
     if((self->op == LDL_OP_JOINING) || (self->ctx.maxDutyCycle > 0U)){
 
         if(self->op == LDL_OP_JOINING){
 
-            offTime = tx->airTime * getOTAAOffTime(self);
+            offTime = tx->airTime * getOTAAOffTime(self, now);
         }
         else{
 
             offTime = tx->airTime * (U32(1) << (self->ctx.maxDutyCycle & 0xfU));
         }
 
-        if((self->band[LDL_BAND_GLOBAL] + offTime) < self->band[LDL_BAND_GLOBAL]){
-
-            self->band[LDL_BAND_GLOBAL] = UINT32_MAX;
-        }
-        else{
-
-            self->band[LDL_BAND_GLOBAL] += offTime;
-        }
+        self->band[LDL_BAND_GLOBAL] = deadlineExtend(self->band[LDL_BAND_GLOBAL], now, offTime);
     }
+
+    setNextBandEvent(self, now);
 }
 
 static uint8_t requiredRate(uint8_t desired, uint8_t min, uint8_t max)
@@ -2593,68 +2835,73 @@ static bool selectChannel(const struct ldl_mac *self, uint8_t desired_rate, uint
     bool retval = false;
     uint8_t i;
     uint8_t selection;
-    uint32_t available = 0;
-    uint8_t j = 0;
+    uint8_t available;
+    uint8_t count;
     uint8_t minRate;
     uint8_t maxRate;
-    uint8_t except = UINT8_MAX;
+    size_t b;
+    uint32_t now = timeNow(self);
 
-    uint8_t mask[sizeof(self->ctx.chMask)];
+    uint8_t mask[sizeof(self->band_channels[0])];
 
     (void)memset(mask, 0, sizeof(mask));
 
-    /* count number of available channels for this rate */
-    for(i=0; i < LDL_Region_numChannels(self->ctx.region); i++){
+    /* channels in bands that are free enough */
+    for(b=0U; b < sizeof(self->band_channels)/sizeof(*self->band_channels); b++){
 
-        if(isAvailable(self, i, limit)){
+        if(deadlineRemaining(self->band[b], now) <= limit){
 
-            if(i == self->tx.chIndex){
+            for(i=0U; i < sizeof(mask); i++){
 
-                except = i;
+                mask[i] |= self->band_channels[b][i];
             }
-
-            (void)maskChannel(mask, sizeof(mask), self->ctx.region, i);
-            available++;
         }
     }
 
+    available = countChannels(mask, sizeof(mask));
+
+    /* avoid the last channel if there is a choice */
+    if((available > 1U) && channelIsMasked(mask, sizeof(mask), self->ctx.region, self->tx.chIndex)){
+
+        (void)unmaskChannel(mask, sizeof(mask), self->ctx.region, self->tx.chIndex);
+        available--;
+    }
+
     if(available > 0U){
 
-        if(except != U8(UINT8_MAX)){
+        selection = U8(self->rand(self->app) % available);
 
-            if(available == 1U){
+        /* skip whole bytes to reach the n-th set bit */
+        for(i=0U; i < sizeof(mask); i++){
 
-                except = UINT8_MAX;
-            }
-            else{
+            count = countChannels(&mask[i], 1U);
+
+            if(selection < count){
 
-                available--;
+                break;
             }
-        }
 
-        selection = U8(self->rand(self->app) % available);
+            selection -= count;
+        }
 
-        for(i=0; i < LDL_Region_numChannels(self->ctx.region); i++){
+        for(i = U8(i * 8U); i < (sizeof(mask) * 8U); i++){
 
             if(channelIsMasked(mask, sizeof(mask), self->ctx.region, i)){
 
-                if(except != i){
+                if(selection == 0U){
 
-                    if(selection == j){
+                    if(getChannel(self, i, &tx->freq, &minRate, &maxRate)){
 
-                        if(getChannel(self, i, &tx->freq, &minRate, &maxRate)){
+                        tx->chIndex = i;
 
-                            tx->chIndex = i;
+                        tx->rate = requiredRate(desired_rate, minRate, maxRate);
 
-                            tx->rate = requiredRate(desired_rate, minRate, maxRate);
-
-                            retval = true;
-                            break;
-                        }
+                        retval = true;
                     }
-
-                    j++;
+                    break;
                 }
+
+                selection--;
             }
         }
     }
@@ -2662,58 +2909,62 @@ static bool selectChannel(const struct ldl_mac *self, uint8_t desired_rate, uint
     return retval;
 }
 
-static bool isAvailable(const struct ldl_mac *self, uint8_t chIndex, uint32_t limit)
+static void updateChannelMap(struct ldl_mac *self, uint8_t chIndex)
 {
-    bool retval = false;
     uint32_t freq;
     uint8_t minRate;
     uint8_t maxRate;
     uint8_t band;
+    size_t b;
 
-    if(!channelIsMasked(self->ctx.chMask, sizeof(self->ctx.chMask), self->ctx.region, chIndex)){
+    if(chIndex < (sizeof(self->band_channels[0])*8U)){
 
-        if(getChannel(self, chIndex, &freq, &minRate, &maxRate)){
+        for(b=0U; b < sizeof(self->band_channels)/sizeof(*self->band_channels); b++){
 
-            if(freq > 0U){
+            (void)unmaskChannel(self->band_channels[b], sizeof(self->band_channels[b]), self->ctx.region, chIndex);
+        }
 
-                if(LDL_Region_getBand(self->ctx.region, freq, &band)){
+        if(!channelIsMasked(self->ctx.chMask, sizeof(self->ctx.chMask), self->ctx.region, chIndex)){
 
-                    LDL_PEDANTIC( band < LDL_BAND_MAX )
+            if(getChannel(self, chIndex, &freq, &minRate, &maxRate)){
 
-                    if(self->band[band] <= limit){
+                if(freq > 0U){
 
-                        retval = true;
+                    if(LDL_Region_getBand(self->ctx.region, freq, &band)){
+
+                        LDL_PEDANTIC( band < LDL_BAND_GLOBAL )
+
+                        (void)maskChannel(self->band_channels[band], sizeof(self->band_channels[band]), self->ctx.region, chIndex);
                     }
                 }
             }
         }
     }
-
-    return retval;
 }
 
-static uint32_t timeUntilAvailable(const struct ldl_mac *self, uint8_t chIndex)
+static void rebuildChannelMap(struct ldl_mac *self)
 {
-    uint32_t retval = UINT32_MAX;
-    uint32_t freq;
-    uint8_t minRate;
-    uint8_t maxRate;
-    uint8_t band;
+    uint8_t i;
 
-    if(!channelIsMasked(self->ctx.chMask, sizeof(self->ctx.chMask), self->ctx.region, chIndex)){
+    (void)memset(self->band_channels, 0, sizeof(self->band_channels));
 
-        if(getChannel(self, chIndex, &freq, &minRate, &maxRate)){
+    for(i=0U; i < LDL_Region_numChannels(self->ctx.region); i++){
+
+        updateChannelMap(self, i);
+    }
+}
 
-            if(freq > 0U){
+static uint8_t countChannels(const uint8_t *mask, size_t max)
+{
+    /* set bits in a nibble */
+    static const uint8_t bits[] = {0U, 1U, 1U, 2U, 1U, 2U, 2U, 3U, 1U, 2U, 2U, 3U, 2U, 3U, 3U, 4U};
 
-                if(LDL_Region_getBand(self->ctx.region, freq, &band)){
+    uint8_t retval = 0U;
+    size_t i;
 
-                    LDL_PEDANTIC( band < LDL_BAND_MAX )
+    for(i=0U; i < max; i++){
 
-                    retval = (self->band[band] > self->band[LDL_BAND_GLOBAL]) ? self->band[band] : self->band[LDL_BAND_GLOBAL];
-                }
-            }
-        }
+        retval += bits[mask[i] & 0xfU] + bits[mask[i] >> 4];
     }
 
     return retval;
@@ -2765,6 +3016,8 @@ static void forgetNetwork(struct ldl_mac *self)
 
     /* reset the default channels (even though they shouldn't have changed!) */
     LDL_Region_getDefaultChannels(self->ctx.region, self);
+
+    rebuildChannelMap(self);
 }
 
 static bool getChannel(const struct ldl_mac *self, uint8_t chIndex, uint32_t *freq, uint8_t *minRate, uint8_t *maxRate)
@@ -2915,17 +3168,18 @@ static bool rateSettingIsValid(enum ldl_region region, uint8_t rate)
     return retval;
 }
 
-static uint32_t getOTAAOffTime(const struct ldl_mac *self)
+static uint32_t getOTAAOffTime(const struct ldl_mac *self, uint32_t now)
 {
     uint32_t retval;
+    uint32_t day = deadlineRemaining(self->day, now);
 
     /* first hour: 36/3600 (0.01) */
-    if(self->day > (timeTPS * U32(23) * U32(60) * U32(60))){
+    if(day > (timeTPS * U32(23) * U32(60) * U32(60))){
 
         retval = 100;
     }
     /* first 11 hours: 36/36000 (0.001) */
-    else if(self->day > (timeTPS * U32(13) * U32(60) * U32(60))){
+    else if(day > (timeTPS * U32(13) * U32(60) * U32(60))){
 
         retval = 1000;
     }
@@ -2940,64 +3194,355 @@ static uint32_t getOTAAOffTime(const struct ldl_mac *self)
     return retval;
 }
 
+/* lower 32 bits of the ticks */
+static uint32_t getTicks(const struct ldl_mac *self)
+{
+#ifdef LDL_ENABLE_TICKS_64
+    return U32(timerNow(self));
+#else
+    return self->ticks(self->app);
+#endif
+}
+
+/* ticks in the timer timebase */
+static ldl_ticks_t timerNow(const struct ldl_mac *self)
+{
+#ifdef LDL_ENABLE_TICKS_64
+    uint64_t retval;
+    uint32_t ticks;
+
+    if(self->ticks64 != NULL){
+
+        retval = self->ticks64(self->app);
+    }
+    else{
+
+        ticks = self->ticks(self->app);
+
+        retval = (U64(self->clock.high) << 32) | U64(ticks);
+
+        /* wrapped since last read */
+        if(ticks < self->clock.low){
+
+            retval += (U64(1) << 32);
+        }
+    }
+
+    return retval;
+#else
+    return self->ticks(self->app);
+#endif
+}
+
+/* timerNow() and keep the 32 bit extension in step
+ *
+ * must be called from a critical section */
+static ldl_ticks_t timerSync(struct ldl_mac *self)
+{
+    ldl_ticks_t retval;
+
+    retval = timerNow(self);
+
+#ifdef LDL_ENABLE_TICKS_64
+    self->clock.low = U32(retval);
+    self->clock.high = U32(retval >> 32);
+#endif
+
+    return retval;
+}
+
+/* zero if timeout has passed (and lag is by how much), otherwise
+ * ticks until timeout */
+static uint32_t timerUntil(ldl_ticks_t timeout, ldl_ticks_t time, uint32_t *lag)
+{
+    uint32_t retval = 0U;
+
+#ifdef LDL_ENABLE_TICKS_64
+    if(timeout <= time){
+
+        *lag = ((time - timeout) > U64(UINT32_MAX)) ? UINT32_MAX : U32(time - timeout);
+    }
+    else{
+
+        /* never further than the 32 bit timebase would allow */
+        retval = ((timeout - time) > U64(INT32_MAX)) ? U32(INT32_MAX) : U32(timeout - time);
+    }
+#else
+    *lag = timerDelta(timeout, time);
+
+    if(*lag > U32(INT32_MAX)){
+
+        retval = timerDelta(time, timeout);
+    }
+#endif
+
+    return retval;
+}
+
+static void timerSetTicks(struct ldl_mac *self, enum ldl_timer_inst timer, ldl_ticks_t timeout)
+{
+    ldl_ticks_t time;
+
+    LDL_SYSTEM_ENTER_CRITICAL(self->app)
+
+    time = timerSync(self);
+
+    self->timers[timer].time = time + timeout;
+    self->timers[timer].armed = true;
+
+    timerUpdateEarliest(self, time);
+
+    LDL_SYSTEM_LEAVE_CRITICAL(self->app)
+}
+
 static uint32_t timerDelta(uint32_t timeout, uint32_t time)
 {
     return (timeout <= time) ? (time - timeout) : (UINT32_MAX - timeout + time);
 }
 
-static bool updateDownCounter(uint32_t *counter, uint32_t time)
+/* must be called from a critical section after any timer changes */
+static void timerUpdateEarliest(struct ldl_mac *self, ldl_ticks_t time)
 {
-    bool expired = false;
+    size_t i;
+#ifdef LDL_ENABLE_TICKS_64
+    /* timers don't wrap so the lowest time is the soonest */
+    (void)time;
 
-    if(*counter > 0U){
+    self->earliest.armed = false;
 
-        if(*counter <= time){
+    for(i=0U; i < sizeof(self->timers)/sizeof(*self->timers); i++){
 
-            *counter = 0U;
-            expired = true;
-        }
-        else{
+        if(self->timers[i].armed && (!self->earliest.armed || (self->timers[i].time < self->earliest.time))){
 
-            *counter -= time;
+            self->earliest.time = self->timers[i].time;
+            self->earliest.armed = true;
         }
     }
+#else
+    uint32_t until;
+    uint32_t lag;
+    uint32_t soonest = UINT32_MAX;
+
+    self->earliest.armed = false;
+
+    for(i=0U; i < sizeof(self->timers)/sizeof(*self->timers); i++){
+
+        if(self->timers[i].armed){
+
+            /* expired timers are as soon as it gets */
+            until = timerUntil(self->timers[i].time, time, &lag);
 
-    return expired;
+            if(!self->earliest.armed || (until < soonest)){
+
+                soonest = until;
+
+                self->earliest.time = self->timers[i].time;
+                self->earliest.armed = true;
+            }
+        }
+    }
+#endif
 }
 
-static bool processBands(struct ldl_mac *self)
+/* when the next event that cannot be handled late is due
+ *
+ * must be called from a critical section */
+static bool priorityDeadline(const struct ldl_mac *self, ldl_ticks_t now, ldl_ticks_t *deadline)
 {
     bool retval = false;
+    const struct ldl_timer *windows[2U] = {NULL, NULL};
+    uint32_t lag;
     size_t i;
-    uint32_t time = 0U;
 
-    if(!self->time.parked){
+    switch(self->state){
+    default:
+        /* nothing */
+        break;
 
-        /* time tracking via ticks */
-        {
-            uint32_t ticks = self->ticks(self->app);
+    /* the radio may interrupt at any moment */
+    case LDL_STATE_TX:
+    case LDL_STATE_RX1:
+    case LDL_STATE_RX2:
 
-            uint32_t since = timerDelta(self->time.ticks, ticks);
+        *deadline = now;
+        retval = true;
+        break;
+
+    /* waitA opens RX1 and waitB opens RX2 */
+    case LDL_STATE_WAIT_RX1:
+    case LDL_STATE_START_RADIO_FOR_RX1:
 
-            self->time.ticks = ticks;
+        windows[0] = &self->timers[LDL_TIMER_WAITA];
+        windows[1] = &self->timers[LDL_TIMER_WAITB];
+        break;
 
-            uint32_t fraction = ((since % GET_TPS()) * timeTPS) + self->time.remainder;
+    case LDL_STATE_WAIT_RX2:
+    case LDL_STATE_START_RADIO_FOR_RX2:
 
-            time = ((since / GET_TPS()) * timeTPS) + (fraction / GET_TPS());
+        windows[0] = &self->timers[LDL_TIMER_WAITB];
+        break;
+    }
 
-            self->time.remainder = fraction % GET_TPS();
+    for(i=0U; i < sizeof(windows)/sizeof(*windows); i++){
+
+        if((windows[i] != NULL) && windows[i]->armed){
+
+            if(!retval || (timerUntil(windows[i]->time, now, &lag) < timerUntil(*deadline, now, &lag))){
+
+                *deadline = windows[i]->time;
+                retval = true;
+            }
         }
+    }
 
-        bool ready = false;
+    return retval;
+}
+
+static uint32_t timeNow(const struct ldl_mac *self)
+{
+    uint32_t remainder = self->time.remainder;
+
+    return self->time.now + ticksToTime(self, timerNow(self) - self->time.ticks, &remainder);
+}
+
+static uint32_t timeSync(struct ldl_mac *self)
+{
+    ldl_ticks_t ticks;
+
+    LDL_SYSTEM_ENTER_CRITICAL(self->app)
+
+    ticks = timerSync(self);
+
+    LDL_SYSTEM_LEAVE_CRITICAL(self->app)
+
+    self->time.now += ticksToTime(self, ticks - self->time.ticks, &self->time.remainder);
+    self->time.ticks = ticks;
+
+    return self->time.now;
+}
+
+/* whole units of 'time' in since + remainder, leaving the rest in remainder */
+static uint32_t ticksToTime(const struct ldl_mac *self, ldl_ticks_t since, uint32_t *remainder)
+{
+    uint32_t retval = 0U;
+    uint32_t units = 0U;
+    uint32_t fraction;
+    uint8_t i;
+
+#ifdef LDL_ENABLE_TICKS_64
+    uint32_t span;
+
+    /* whole seconds at a time until the rest fits in 32 bits */
+    if(since > U64(UINT32_MAX)){
+
+        span = divTPS(self, UINT32_MAX, &fraction);
+
+        while(since > U64(UINT32_MAX)){
+
+            retval += span * timeTPS;
+            since -= U64(span) * U64(GET_TPS());
+        }
+    }
+#endif
+
+    retval += divTPS(self, U32(since), &fraction) * timeTPS;
+
+    /* fraction x timeTPS / tps one bit at a time (timeTPS is 2^8) since
+     * the product overflows for tps above 16MHz */
+    for(i=0U; i < 8U; i++){
+
+        units <<= 1;
+        fraction <<= 1;
+
+        if(fraction >= GET_TPS()){
+
+            units++;
+            fraction -= GET_TPS();
+        }
+    }
+
+    fraction += *remainder;
+
+    if(fraction >= GET_TPS()){
+
+        units++;
+        fraction -= GET_TPS();
+    }
+
+    *remainder = fraction;
+
+    return retval + units;
+}
+
+static uint32_t deadlineRemaining(uint32_t deadline, uint32_t now)
+{
+    uint32_t retval = 0U;
+
+    if(deadline > 0U){
+
+        retval = deadline - now;
+
+        /* deadline has passed */
+        if(retval > U32(INT32_MAX)){
+
+            retval = 0U;
+        }
+    }
+
+    return retval;
+}
+
+static uint32_t deadlineExtend(uint32_t deadline, uint32_t now, uint32_t time)
+{
+    uint32_t retval = deadline;
+    uint32_t remaining = deadlineRemaining(deadline, now);
 
-        /* handle the day counter if set */
-        (void)updateDownCounter(&self->day, time);
+    if(time > 0U){
+
+        if(time > (U32(INT32_MAX) - remaining)){
+
+            remaining = U32(INT32_MAX);
+        }
+        else{
+
+            remaining += time;
+        }
+
+        retval = now + remaining;
+
+        /* zero is reserved for 'free' */
+        if(retval == 0U){
+
+            retval = 1U;
+        }
+    }
+
+    return retval;
+}
+
+static bool processBands(struct ldl_mac *self)
+{
+    bool retval = false;
+    bool ready = false;
+    size_t i;
+    uint32_t lag;
+    uint32_t now;
+
+    /* nothing to do until the earliest deadline has passed */
+    if(LDL_MAC_timerCheck(self, LDL_TIMER_BAND, &lag)){
+
+        now = timeSync(self);
+
+        if(deadlineRemaining(self->day, now) == 0U){
+
+            self->day = 0U;
+        }
 
-        /* decrement down counters with time */
         for(i=0U; i < sizeof(self->band)/sizeof(*self->band); i++){
 
-            if(updateDownCounter(&self->band[i], time)){
+            if((self->band[i] > 0U) && (deadlineRemaining(self->band[i], now) == 0U)){
 
+                self->band[i] = 0U;
                 ready = true;
             }
         }
@@ -3008,60 +3553,70 @@ static bool processBands(struct ldl_mac *self)
             self->handler(self->app, LDL_MAC_CHANNEL_READY, NULL);
             retval = true;
         }
+
+        setNextBandEvent(self, now);
     }
 
     return retval;
 }
 
-static void setNextBandEvent(struct ldl_mac *self)
+static void setNextBandEvent(struct ldl_mac *self, uint32_t now)
 {
     uint32_t time = UINT32_MAX;
+    uint32_t remaining;
+#ifndef LDL_ENABLE_TICKS_64
     uint32_t ticks;
+    uint32_t limit;
+#endif
     size_t i;
 
     for(i=0; i < sizeof(self->band)/sizeof(*self->band); i++){
 
-        if(self->band[i] > 0U){
+        remaining = deadlineRemaining(self->band[i], now);
 
-            if(self->band[i] < time){
+        if((self->band[i] > 0U) && (remaining < time)){
 
-                time = self->band[i];
-            }
+            time = remaining;
         }
     }
 
-    if(time <= self->band[LDL_BAND_GLOBAL]){
+    remaining = deadlineRemaining(self->band[LDL_BAND_GLOBAL], now);
 
-        time = self->band[LDL_BAND_GLOBAL];
+    if(time <= remaining){
+
+        time = remaining;
     }
 
-    /* consider day counter if there are no
-     * band counters */
+    /* consider day deadline if there are no
+     * band deadlines */
     if((time == UINT32_MAX) && (self->day > 0U)){
 
-        time = self->day;
+        time = deadlineRemaining(self->day, now);
     }
 
     /* convert to ticks */
     if(time < UINT32_MAX){
 
-        self->time.parked = false;
+#ifdef LDL_ENABLE_TICKS_64
+        /* 64 bit timers don't need clamping */
+        timerSetTicks(self, LDL_TIMER_BAND, U64((time / timeTPS) + (((time % timeTPS) > 0U) ? U32(1) : U32(0))) * U64(GET_TPS()));
+#else
+        limit = divTPS(self, U32(INT32_MAX), &ticks);
 
-        if(time < (U32(INT32_MAX)/GET_TPS()*timeTPS)){
+        if(time < (limit * timeTPS)){
 
             ticks = ((time / timeTPS) + (((time % timeTPS) > 0U) ? U32(1) : U32(0))) * GET_TPS();
         }
         else{
 
-            ticks = U32(INT32_MAX)/GET_TPS()*U32(INT32_MAX);
+            ticks = limit * GET_TPS();
         }
 
         LDL_MAC_timerSet(self, LDL_TIMER_BAND, ticks);
+#endif
     }
     else{
 
-        //LDL_DEBUG("time tracking is disabled")
-        self->time.parked = true;
         LDL_MAC_timerClear(self, LDL_TIMER_BAND);
     }
 }
@@ -3093,12 +3648,12 @@ static void downlinkMissingHandler(struct ldl_mac *self)
     {
         struct ldl_mac_tx tx;
 
-        bool global_band_ok = (self->band[LDL_BAND_GLOBAL] < LDL_Region_getMaxDCycleOffLimit(self->ctx.region));
+        bool global_band_ok = (deadlineRemaining(self->band[LDL_BAND_GLOBAL], timeNow(self)) < LDL_Region_getMaxDCycleOffLimit(self->ctx.region));
         bool channel_ok = selectChannel(self, self->tx.rate, LDL_Region_getMaxDCycleOffLimit(self->ctx.region), &tx);
 
         if((self->trials < nbTrans) && global_band_ok && channel_ok){
 
-            LDL_OPS_micDataFrame(self, self->buffer, self->bufferLen);
+            LDL_OPS_remicDataFrame(self, self->buffer, self->bufferLen);
 
             if(self->op == LDL_OP_DATA_CONFIRMED){
 
@@ -3157,30 +3712,192 @@ static void downlinkMissingHandler(struct ldl_mac *self)
 
 static uint32_t msToTime(uint32_t ms)
 {
-    /* round up */
-    uint32_t t = ms * timeTPS;
-
-    return (t / U32(1000)) + (((t % U32(1000)) > 0U) ? U32(1) : U32(0));
+    /* round up (0.256 x 2^16 is 16777.216)
+     *
+     * 64 bit since LDL_STARTUP_DELAY has no upper bound and this
+     * is only called at init */
+    return U32(((U64(ms) * U64(16778)) + U64(0xffff)) >> 16);
 }
 
 static uint32_t msToTicks(const struct ldl_mac *self, uint32_t ms)
+{
+    /* round up
+     *
+     * valid for ms < 2^16 */
+    return ((ms * self->timing.ms) + ((U32(1) << self->timing.msShift) - U32(1))) >> self->timing.msShift;
+}
+
+static uint32_t guardTicks(const struct ldl_mac *self)
+{
+    /* for a radio or MIC result that never arrives
+     *
+     * four seconds is longer than the longest downlink (about 2.8s
+     * for 64 bytes at SF12/125KHz) and A adds the crystal error */
+    return (GET_TPS() + GET_A()) << 2U;
+}
+
+static uint32_t divTPS(const struct ldl_mac *self, uint32_t n, uint32_t *remainder)
+{
+    uint32_t q;
+    uint32_t r;
+
+#ifdef LDL_PARAM_TPS
+    (void)self;
+#endif
+
+    /* the reciprocal is rounded down so this is never more than one short */
+    q = U32((U64(n) * U64(GET_TPS_RECIPROCAL())) >> 32);
+    r = n - (q * GET_TPS());
+
+    if(r >= GET_TPS()){
+
+        q++;
+        r -= GET_TPS();
+    }
+
+    *remainder = r;
+
+    return q;
+}
+
+static void initTiming(struct ldl_mac *self)
+{
+    uint8_t i;
+    uint8_t shift = 0U;
+
+    /* the largest packet is less than 2^11 quarter symbols so the
+     * largest quarter symbol is kept under 2^21 to multiply in 32 bits
+     *
+     * 15625 is 1M / 2^6 */
+    while((shift < 24U) && (scale(GET_TPS(), U8(7U + shift + 1U), U32(15625), true) <= (U32(1) << 21))){
+
+        shift++;
+    }
+
+    self->timing.shift = shift;
+
+    for(i=0U; i < U8(sizeof(self->timing.symbol)/sizeof(*self->timing.symbol)); i++){
+
+        /* 2^(i+8) us */
+        self->timing.symbol[i] = scale(GET_TPS(), U8(i + 2U), U32(15625), false);
+        self->timing.quarter[i] = scale(GET_TPS(), U8(i + shift), U32(15625), true);
+    }
+
+#ifndef LDL_PARAM_TPS
+    self->timing.reciprocal = UINT32_MAX / GET_TPS();
+#endif
+
+    /* as much precision as will multiply a 16 bit ms in 32 bits */
+    shift = 0U;
+
+    while((shift < 24U) && (scale(GET_TPS(), U8(shift + 1U), U32(1000), true) <= U32(UINT16_MAX))){
+
+        shift++;
+    }
+
+    self->timing.msShift = shift;
+    self->timing.ms = scale(GET_TPS(), shift, U32(1000), true);
+}
+
+static uint32_t scale(uint32_t value, uint8_t shift, uint32_t divisor, bool roundUp)
+{
+    /* value x 2^shift / divisor without overflowing */
+    uint32_t q = value / divisor;
+    uint32_t r = value % divisor;
+    uint8_t i;
+
+    for(i=0U; i < shift; i++){
+
+        q <<= 1;
+        r <<= 1;
+
+        if(r >= divisor){
+
+            q++;
+            r -= divisor;
+        }
+    }
+
+    return (roundUp && (r > 0U)) ? (q + U32(1)) : q;
+}
+
+static uint8_t timingIndex(enum ldl_spreading_factor sf, enum ldl_signal_bandwidth bw)
+{
+    /* symbol period is 2^(sf + 3 - bw) us */
+    uint8_t retval = U8(U8(sf) + 3U - U8(bw) - 8U);
+
+    LDL_PEDANTIC(retval < U8(sizeof(timeQuarter)/sizeof(*timeQuarter)))
+
+    return retval;
+}
+
+static uint32_t symbolTicks(const struct ldl_mac *self, enum ldl_spreading_factor sf, enum ldl_signal_bandwidth bw)
+{
+    return self->timing.symbol[timingIndex(sf, bw)];
+}
+
+static uint32_t packetQuarters(enum ldl_spreading_factor sf, enum ldl_signal_bandwidth bw, uint8_t size, bool crc)
+{
+    /* same formula as LDL_Radio_getAirTime() with everything divided
+     * through by four:
+     *
+     * Npayload = 8 + max( ceil[( 2PL - SF + 7 + 4CRC ) / ( SF - 2DE )], 0 ) x 5
+     *
+     * and with the result in quarter symbols:
+     *
+     * 4 x (12.25 + Npayload)
+     *
+     * */
+
+    /* 2^16 / (SF - 2DE) rounded up for SF - 2DE in 7..12 */
+    static const uint16_t reciprocal[] = {9363U, 8192U, 7282U, 6554U, 5958U, 5462U};
+
+    uint32_t numerator;
+    uint32_t denom;
+    uint32_t blocks;
+
+    denom = U32(sf) - ((((bw == LDL_BW_125) && ((sf == LDL_SF_11) || (sf == LDL_SF_12))) ? U32(2) : U32(0)));
+
+    numerator = (U32(2) * U32(size)) + U32(7) + (crc ? U32(4) : U32(0));
+    numerator = (numerator > U32(sf)) ? (numerator - U32(sf)) : U32(0);
+
+    /* exact for numerator < 2^12 */
+    blocks = ((numerator + denom - U32(1)) * U32(reciprocal[denom - U32(7)])) >> 16;
+
+    return U32(49) + (U32(4) * (U32(8) + (blocks * (U32(LDL_CR_5) + U32(4)))));
+}
+
+static uint32_t airTimeTicks(const struct ldl_mac *self, enum ldl_spreading_factor sf, enum ldl_signal_bandwidth bw, uint32_t quarters)
 {
     /* round up */
-    uint32_t t = ms * GET_TPS();
+    return ((quarters * self->timing.quarter[timingIndex(sf, bw)]) + ((U32(1) << self->timing.shift) - U32(1))) >> self->timing.shift;
+}
 
-    return (t / U32(1000)) + (((t % U32(1000)) > 0U) ? U32(1) : U32(0));
+static uint32_t airTimeTime(enum ldl_spreading_factor sf, enum ldl_signal_bandwidth bw, uint32_t quarters)
+{
+    /* round up */
+    return ((quarters * timeQuarter[timingIndex(sf, bw)]) + ((U32(1) << timeShift) - U32(1))) >> timeShift;
 }
 
 static uint32_t timeUntilNextChannel(const struct ldl_mac *self)
 {
-    uint8_t i;
+    size_t b;
     uint32_t min = UINT32_MAX;
+    uint32_t now = timeNow(self);
+    uint32_t time;
+    uint32_t global = deadlineRemaining(self->band[LDL_BAND_GLOBAL], now);
+
+    for(b=0U; b < sizeof(self->band_channels)/sizeof(*self->band_channels); b++){
 
-    for(i=0; i < LDL_Region_numChannels(self->ctx.region); i++){
+        if(countChannels(self->band_channels[b], sizeof(self->band_channels[b])) > 0U){
 
-        if(min > timeUntilAvailable(self, i)){
+            time = deadlineRemaining(self->band[b], now);
+            time = (time > global) ? time : global;
 
-            min = timeUntilAvailable(self, i);
+            if(min > time){
+
+                min = time;
+            }
         }
     }
 
@@ -3331,7 +4048,7 @@ static bool inputCheck(struct ldl_mac *self, uint32_t *lag)
 
         self->inputs.armed = false;
         self->inputs.state = false;
-        *lag = timerDelta(self->inputs.time, self->ticks(self->app));
+        *lag = timerDelta(self->inputs.time, getTicks(self));
 
         retval = true;
     }
@@ -3346,6 +4063,138 @@ static bool inputPending(const struct ldl_mac *self)
     return self->inputs.state;
 }
 
+#ifdef LDL_ENABLE_SM_ASYNC
+static bool beginMIC(struct ldl_mac *self, const struct ldl_ops_mic *arg, const uint8_t *in, uint8_t len)
+{
+    bool retval = false;
+
+    /* only one calculation at a time */
+    if((self->sm_interface->begin_mic != NULL) && !self->mic_inputs.busy){
+
+        LDL_SYSTEM_ENTER_CRITICAL(self->app)
+
+        self->mic_inputs.busy = true;
+        self->mic_inputs.wanted = true;
+        self->mic_inputs.state = false;
+        self->mic_inputs.len = len;
+
+        LDL_SYSTEM_LEAVE_CRITICAL(self->app)
+
+        if(self->sm_interface->begin_mic(self->sm, arg->key, arg->hdr, arg->hdrLen, in, len - U8(sizeof(uint32_t)), self, LDL_MAC_micComplete)){
+
+            retval = true;
+        }
+        else{
+
+            LDL_SYSTEM_ENTER_CRITICAL(self->app)
+
+            self->mic_inputs.busy = false;
+            self->mic_inputs.wanted = false;
+
+            LDL_SYSTEM_LEAVE_CRITICAL(self->app)
+        }
+    }
+
+    return retval;
+}
+
+static void abandonMIC(struct ldl_mac *self)
+{
+    LDL_SYSTEM_ENTER_CRITICAL(self->app)
+
+    /* busy is left alone since the SM will still call back */
+    self->mic_inputs.wanted = false;
+    self->mic_inputs.state = false;
+
+    LDL_SYSTEM_LEAVE_CRITICAL(self->app)
+}
+
+static bool micCheck(struct ldl_mac *self)
+{
+    bool retval = false;
+
+    LDL_SYSTEM_ENTER_CRITICAL(self->app)
+
+    if(self->mic_inputs.state){
+
+        self->mic_inputs.state = false;
+        self->mic_inputs.wanted = false;
+
+        retval = true;
+    }
+
+    LDL_SYSTEM_LEAVE_CRITICAL(self->app)
+
+    return retval;
+}
+
+static bool micPending(const struct ldl_mac *self)
+{
+    return self->mic_inputs.state;
+}
+
+static void processMIC(struct ldl_mac *self)
+{
+    struct ldl_frame_down frame;
+    bool valid;
+
+    switch(self->state){
+    default:
+        /* result is no longer relevant */
+        break;
+
+    case LDL_STATE_WAIT_MIC:
+
+        LDL_MAC_timerClear(self, LDL_TIMER_WAITA);
+
+        if(LDL_Frame_decode(&frame, self->rx_buffer, self->mic_inputs.len) && LDL_OPS_checkMIC(self, &frame, self->mic_inputs.mic)){
+
+            handleDownlink(self, &frame);
+        }
+        else{
+
+            downlinkMissingHandler(self);
+        }
+        break;
+
+    /* frame was received in RX1 */
+    case LDL_STATE_WAIT_RX2:
+    case LDL_STATE_START_RADIO_FOR_RX2:
+    case LDL_STATE_RX2:
+    case LDL_STATE_RX2_LOCKOUT:
+
+        valid = LDL_Frame_decode(&frame, self->rx_buffer, self->mic_inputs.len) && LDL_OPS_checkMIC(self, &frame, self->mic_inputs.mic);
+
+        LDL_DEBUG("rx1 mic %s: ticks=%" PRIu32 "", valid ? "ok" : "failed", getTicks(self))
+
+        /* otherwise carry on with RX2 */
+        if(valid){
+
+            inputDisarm(self);
+            LDL_MAC_timerClear(self, LDL_TIMER_WAITA);
+            LDL_MAC_timerClear(self, LDL_TIMER_WAITB);
+
+            self->radio_interface->set_mode(self->radio, LDL_RADIO_MODE_SLEEP);
+
+            handleDownlink(self, &frame);
+        }
+        break;
+    }
+}
+
+static void processWaitMIC(struct ldl_mac *self, enum ldl_mac_sme event)
+{
+    if(event == LDL_SME_TIMER_A){
+
+        LDL_ERROR("mic timeout")
+
+        abandonMIC(self);
+
+        downlinkMissingHandler(self);
+    }
+}
+#endif
+
 
 static void fillJoinBuffer(struct ldl_mac *self, uint16_t devNonce)
 {
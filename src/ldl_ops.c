@@ -39,12 +39,7 @@ static void initA(struct ldl_block *a, uint32_t c, uint32_t devAddr, bool up, ui
 static void initB(struct ldl_block *b, uint16_t confirmCounter, uint8_t rate, uint8_t chIndex, bool up, uint32_t devAddr, uint32_t upCounter, uint8_t len);
 
 static uint32_t deriveDownCounter(struct ldl_mac *self, uint8_t port, uint16_t counter);
-
-static uint8_t putU8(uint8_t *buf, uint8_t value);
-static uint8_t putU16(uint8_t *buf, uint16_t value);
-static uint8_t putU24(uint8_t *buf, uint32_t value);
-static uint8_t putU32(uint8_t *buf, uint32_t value);
-static uint8_t putEUI(uint8_t *buf, const uint8_t *value);
+static void putMIC(const struct ldl_mac *self, void *buffer, uint8_t size, uint32_t micF, uint32_t micS);
 
 /* functions **********************************************************/
 
@@ -78,13 +73,25 @@ void LDL_OPS_deriveKeys(struct ldl_mac *self)
 
     (void)memset(&iv, 0, sizeof(iv));
 
-    if(SESS_VERSION(self->ctx) == 0U){
+    if(self->sm_interface->derive_session_keys != NULL){
+
+        struct ldl_sm_join_param param;
+
+        param.version = SESS_VERSION(self->ctx);
+        param.joinNonce = self->ctx.joinNonce;
+        param.netID = self->ctx.netID;
+        param.joinEUI = self->joinEUI;
+        param.devNonce = self->ctx.devNonce;
+
+        self->sm_interface->derive_session_keys(self->sm, &param);
+    }
+    else if(SESS_VERSION(self->ctx) == 0U){
 
         /* ptr[0] below */
         pos = 1;
-        pos += putU24(&ptr[pos], self->ctx.joinNonce);
-        pos += putU24(&ptr[pos], self->ctx.netID);
-        (void)putU16(&ptr[pos], self->ctx.devNonce);
+        pos += LDL_OPS_putU24(&ptr[pos], self->ctx.joinNonce);
+        pos += LDL_OPS_putU24(&ptr[pos], self->ctx.netID);
+        (void)LDL_OPS_putU16(&ptr[pos], self->ctx.devNonce);
 
         ptr[0] = 2;
         self->sm_interface->update_session_key(self->sm, LDL_SM_KEY_APPS, LDL_SM_KEY_NWK, &iv);
@@ -98,9 +105,9 @@ void LDL_OPS_deriveKeys(struct ldl_mac *self)
 
         /* ptr[0] below */
         pos = 1;
-        pos += putU24(&ptr[pos], self->ctx.joinNonce);
-        pos += putEUI(&ptr[pos], self->joinEUI);
-        (void)putU16(&ptr[pos], self->ctx.devNonce);
+        pos += LDL_OPS_putU24(&ptr[pos], self->ctx.joinNonce);
+        pos += LDL_OPS_putEUI(&ptr[pos], self->joinEUI);
+        (void)LDL_OPS_putU16(&ptr[pos], self->ctx.devNonce);
 
         ptr[0] = 1;
         self->sm_interface->update_session_key(self->sm, LDL_SM_KEY_FNWKSINT, LDL_SM_KEY_NWK, &iv);
@@ -129,7 +136,7 @@ void LDL_OPS_deriveJoinKeys(struct ldl_mac *self)
     (void)memset(&iv, 0, sizeof(iv));
 
     /* ptr[0] below */
-    (void)putEUI(&ptr[1U], self->devEUI);
+    (void)LDL_OPS_putEUI(&ptr[1U], self->devEUI);
 
     ptr[0] = 5U;
     self->sm_interface->update_session_key(self->sm, LDL_SM_KEY_JSENC, LDL_SM_KEY_NWK, &iv);
@@ -151,6 +158,9 @@ uint8_t LDL_OPS_prepareData(struct ldl_mac *self, const struct ldl_frame_data *f
     if(retval > 0U){
 
         struct ldl_block A;
+        struct ldl_block optsA;
+        enum ldl_sm_key dataKey = (f->port == 0U) ? LDL_SM_KEY_NWKSENC : LDL_SM_KEY_APPS;
+        uint8_t optsLen = 0U;
 
 #if defined(LDL_ENABLE_L2_1_1)
         /* encrypt fopt (LoRaWAN 1.1) */
@@ -158,20 +168,61 @@ uint8_t LDL_OPS_prepareData(struct ldl_mac *self, const struct ldl_frame_data *f
 
 #ifdef LDL_ENABLE_ERRATA_A1
             /* as per errata 26 Jan 2018 */
-            initA(&A, 1, f->devAddr, true, f->counter, 1);
+            initA(&optsA, 1, f->devAddr, true, f->counter, 1);
 #else
             /* as per 1.1 spec */
-            initA(&A, 0, f->devAddr, true, f->counter, 0);
+            initA(&optsA, 0, f->devAddr, true, f->counter, 0);
 #endif
-            self->sm_interface->ctr(self->sm, LDL_SM_KEY_NWKSENC, &A, &out[off.opts], f->optsLen);
+            optsLen = f->optsLen;
         }
 #endif
 
         initA(&A, 0, f->devAddr, true, f->counter, 1);
 
-        /* encrypt data */
-        self->sm_interface->ctr(self->sm, (f->port == 0U) ? LDL_SM_KEY_NWKSENC : LDL_SM_KEY_APPS, &A, &out[off.data], f->dataLen);
+        if(self->sm_interface->secure_data != NULL){
+
+            struct ldl_sm_data_frame frame;
+            struct ldl_block B0;
+            struct ldl_block B1;
+            uint32_t micF;
+            uint32_t micS = 0U;
+
+            frame.msg = out;
+            frame.len = retval - U8(sizeof(micF));
+
+            frame.optsOffset = off.opts;
+            frame.optsLen = optsLen;
+            frame.optsKey = LDL_SM_KEY_NWKSENC;
+            frame.optsIV = &optsA;
+
+            frame.dataOffset = off.data;
+            frame.dataLen = f->dataLen;
+            frame.dataKey = dataKey;
+            frame.dataIV = &A;
+
+            initB(&B0, 0U, 0U, 0U, true, self->ctx.devAddr, self->tx.counter, frame.len);
+            initB(&B1, 0U, self->tx.rate, self->tx.chIndex, true, self->ctx.devAddr, self->tx.counter, frame.len);
 
+            frame.b0 = &B0;
+            frame.b1 = (SESS_VERSION(self->ctx) == 1U) ? &B1 : NULL;
+
+            /* encrypt and MIC in one pass */
+            self->sm_interface->secure_data(self->sm, &frame, &micF, &micS);
+
+            putMIC(self, out, retval, micF, micS);
+        }
+        else{
+
+            if(optsLen > 0U){
+
+                self->sm_interface->ctr(self->sm, LDL_SM_KEY_NWKSENC, &optsA, &out[off.opts], optsLen);
+            }
+
+            /* encrypt data */
+            self->sm_interface->ctr(self->sm, dataKey, &A, &out[off.data], f->dataLen);
+
+            LDL_OPS_micDataFrame(self, out, retval);
+        }
     }
 
     return retval;
@@ -181,7 +232,7 @@ void LDL_OPS_micDataFrame(struct ldl_mac *self, void *buffer, uint8_t size)
 {
     struct ldl_block B0;
     struct ldl_block B1;
-    uint32_t micS;
+    uint32_t micS = 0U;
     uint32_t micF;
 
     initB(&B0, 0U, 0U, 0U, true, self->ctx.devAddr, self->tx.counter, size - U8(sizeof(micF)));
@@ -192,12 +243,25 @@ void LDL_OPS_micDataFrame(struct ldl_mac *self, void *buffer, uint8_t size)
     if(SESS_VERSION(self->ctx) == 1U){
 
         micS = self->sm_interface->mic(self->sm, LDL_SM_KEY_SNWKSINT, &B1, U8(sizeof(B1.value)), buffer, size - U8(sizeof(micS)));
-
-        LDL_Frame_updateMIC(buffer, size, ((micF << 16) | (micS & U32(0xffff))));
     }
-    else{
 
-        LDL_Frame_updateMIC(buffer, size, micF);
+    putMIC(self, buffer, size, micF, micS);
+}
+
+void LDL_OPS_remicDataFrame(struct ldl_mac *self, void *buffer, uint8_t size)
+{
+    /* micF covers B0 and the frame which do not change between
+     * retries, only micS (B1) depends on the rate and channel */
+    if(SESS_VERSION(self->ctx) == 1U){
+
+        struct ldl_block B1;
+        uint32_t micS;
+
+        initB(&B1, 0U, self->tx.rate, self->tx.chIndex, true, self->ctx.devAddr, self->tx.counter, size - U8(sizeof(micS)));
+
+        micS = self->sm_interface->mic(self->sm, LDL_SM_KEY_SNWKSINT, &B1, U8(sizeof(B1.value)), buffer, size - U8(sizeof(micS)));
+
+        LDL_Frame_updateMIC(buffer, size, ((LDL_Frame_getMIC(buffer, size) & U32(0xffff0000)) | (micS & U32(0xffff))));
     }
 }
 
@@ -217,9 +281,24 @@ uint8_t LDL_OPS_prepareJoinRequest(struct ldl_mac *self, const struct ldl_frame_
 
 bool LDL_OPS_receiveFrame(struct ldl_mac *self, struct ldl_frame_down *f, uint8_t *in, uint8_t len)
 {
-    bool retval;
+    bool retval = false;
+    struct ldl_ops_mic arg;
     uint32_t mic;
 
+    if(LDL_OPS_prepareMIC(self, f, in, len, &arg)){
+
+        mic = self->sm_interface->mic(self->sm, arg.key, arg.hdr, arg.hdrLen, in, len - U8(sizeof(mic)));
+
+        retval = LDL_OPS_checkMIC(self, f, mic);
+    }
+
+    return retval;
+}
+
+bool LDL_OPS_prepareMIC(struct ldl_mac *self, struct ldl_frame_down *f, uint8_t *in, uint8_t len, struct ldl_ops_mic *arg)
+{
+    bool retval;
+
     retval = false;
 
     if(LDL_Frame_decode(f, in, len)){
@@ -258,7 +337,6 @@ bool LDL_OPS_receiveFrame(struct ldl_mac *self, struct ldl_frame_down *f, uint8_
 #if defined(LDL_ENABLE_L2_1_1)
                         if(f->optNeg){
 
-                            struct ldl_block hdr;
                             uint8_t pos;
 
                             pos = 0U;
@@ -266,43 +344,27 @@ bool LDL_OPS_receiveFrame(struct ldl_mac *self, struct ldl_frame_down *f, uint8_
                             switch(self->op){
                             default:
                             case LDL_OP_JOINING:
-                                pos += putU8(&hdr.value[pos], 0xffU);
+                                pos += LDL_OPS_putU8(&arg->hdr[pos], 0xffU);
                                 break;
                             case LDL_OP_REJOINING:
-                                pos += putU8(&hdr.value[pos], 2U);
+                                pos += LDL_OPS_putU8(&arg->hdr[pos], 2U);
                                 break;
                             }
 
-                            pos += putEUI(&hdr.value[pos], self->joinEUI);
-                            pos += putU16(&hdr.value[pos], self->ctx.devNonce);
-
-                            mic = self->sm_interface->mic(self->sm, LDL_SM_KEY_JSINT, &hdr, pos, in, len - U8(sizeof(mic)));
+                            pos += LDL_OPS_putEUI(&arg->hdr[pos], self->joinEUI);
+                            pos += LDL_OPS_putU16(&arg->hdr[pos], self->ctx.devNonce);
 
-                            if(f->mic == mic){
-
-                                retval = true;
-                            }
-                            else{
-
-                                /* MIC failed */
-                                LDL_DEBUG("joinAccept MIC failed")
-                            }
+                            arg->key = LDL_SM_KEY_JSINT;
+                            arg->hdrLen = pos;
                         }
                         else
 #endif
                         {
-                            mic = self->sm_interface->mic(self->sm, LDL_SM_KEY_NWK, NULL, 0U, in, len - U8(sizeof(mic)));
-
-                            if(f->mic == mic){
-
-                                retval = true;
-                            }
-                            else{
-
-                                /* MIC failed */
-                                LDL_DEBUG("joinAccept MIC failed")
-                            }
+                            arg->key = LDL_SM_KEY_NWK;
+                            arg->hdrLen = 0U;
                         }
+
+                        retval = true;
                     }
                 }
                 else{
@@ -336,45 +398,22 @@ bool LDL_OPS_receiveFrame(struct ldl_mac *self, struct ldl_frame_down *f, uint8_
                     counter = deriveDownCounter(self, f->port, f->counter);
 
                     struct ldl_block B;
-                    struct ldl_block A;
 
                     if((SESS_VERSION(self->ctx) == 1U) && f->ack){
 
-                        initB(&B, U16(self->ctx.up-1U), 0U, 0U, false, f->devAddr, counter, len - U8(sizeof(mic)));
+                        initB(&B, U16(self->ctx.up-1U), 0U, 0U, false, f->devAddr, counter, len - U8(sizeof(f->mic)));
                     }
                     else{
 
-                        initB(&B, 0U, 0U, 0U, false, f->devAddr, counter, len - U8(sizeof(mic)));
+                        initB(&B, 0U, 0U, 0U, false, f->devAddr, counter, len - U8(sizeof(f->mic)));
                     }
 
-                    mic = self->sm_interface->mic(self->sm, LDL_SM_KEY_SNWKSINT, &B, U8(sizeof(B.value)), in, len - U8(sizeof(mic)));
+                    (void)memcpy(arg->hdr, B.value, sizeof(arg->hdr));
 
-                    if(mic == f->mic){
+                    arg->key = LDL_SM_KEY_SNWKSINT;
+                    arg->hdrLen = U8(sizeof(arg->hdr));
 
-#if defined(LDL_ENABLE_L2_1_1)
-                        /* V1.1 encrypts the opts */
-                        if(SESS_VERSION(self->ctx) == 1U){
-#ifdef LDL_ENABLE_ERRATA_A1
-                            /* as per errata 26 Jan 2018 */
-                            initA(&A, f->dataPresent ? 2U : 1U, f->devAddr, false, f->counter, 0U);
-#else
-                            /* as per 1.1 spec */
-                            initA(&A, 0U, f->devAddr, false, f->counter, 0U);
-#endif
-                            self->sm_interface->ctr(self->sm, LDL_SM_KEY_NWKSENC, &A, f->opts, f->optsLen);
-                        }
-#endif
-                        initA(&A, 0U, f->devAddr, false, f->counter, 1U);
-
-                        self->sm_interface->ctr(self->sm, (f->port == 0U) ? LDL_SM_KEY_NWKSENC : LDL_SM_KEY_APPS, &A, f->data, f->dataLen);
-
-                        retval = true;
-                    }
-                    else{
-
-                        /* MIC failed */
-                        LDL_DEBUG("data MIC failed")
-                    }
+                    retval = true;
                 }
                 else{
 
@@ -400,57 +439,63 @@ bool LDL_OPS_receiveFrame(struct ldl_mac *self, struct ldl_frame_down *f, uint8_
     return retval;
 }
 
-/* static functions ***************************************************/
-
-static void initA(struct ldl_block *a, uint32_t c, uint32_t devAddr, bool up, uint32_t counter, uint8_t i)
+bool LDL_OPS_checkMIC(struct ldl_mac *self, struct ldl_frame_down *f, uint32_t mic)
 {
-    uint8_t pos = 0U;
-    uint8_t *ptr = a->value;
+    bool retval;
 
-    pos += putU8(&ptr[pos], 1U);
-    pos += putU32(&ptr[pos], c);
-    pos += putU8(&ptr[pos], up ? 0U : 1U);
-    pos += putU32(&ptr[pos], devAddr);
-    pos += putU32(&ptr[pos], counter);
-    pos += putU8(&ptr[pos], 0U);
-    (void)putU8(&ptr[pos], i);
-}
+    retval = false;
 
-static void initB(struct ldl_block *b, uint16_t confirmCounter, uint8_t rate, uint8_t chIndex, bool up, uint32_t devAddr, uint32_t upCounter, uint8_t len)
-{
-    uint8_t pos = 0U;
-    uint8_t *ptr = b->value;
+    if(f->mic == mic){
 
-    pos += putU8(&ptr[pos], 0x49U);
-    pos += putU16(&ptr[pos], confirmCounter);
-    pos += putU8(&ptr[pos], rate);
-    pos += putU8(&ptr[pos], chIndex);
-    pos += putU8(&ptr[pos], up ? 0U : 1U);
-    pos += putU32(&ptr[pos], devAddr);
-    pos += putU32(&ptr[pos], upCounter);
-    pos += putU8(&ptr[pos], 0U);
-    (void)putU8(&ptr[pos], len);
-}
+        switch(f->type){
+        default:
+        case FRAME_TYPE_JOIN_ACCEPT:
+            break;
 
-static uint32_t deriveDownCounter(struct ldl_mac *self, uint8_t port, uint16_t counter)
-{
-    uint32_t mine = ((SESS_VERSION(self->ctx) > 0U) && (port == 0U)) ? U32(self->ctx.nwkDown) : U32(self->ctx.appDown);
+        case FRAME_TYPE_DATA_UNCONFIRMED_DOWN:
+        case FRAME_TYPE_DATA_CONFIRMED_DOWN:
+        {
+            struct ldl_block A;
 
-    mine = mine << 16;
+#if defined(LDL_ENABLE_L2_1_1)
+            /* V1.1 encrypts the opts */
+            if(SESS_VERSION(self->ctx) == 1U){
+#ifdef LDL_ENABLE_ERRATA_A1
+                /* as per errata 26 Jan 2018 */
+                initA(&A, f->dataPresent ? 2U : 1U, f->devAddr, false, f->counter, 0U);
+#else
+                /* as per 1.1 spec */
+                initA(&A, 0U, f->devAddr, false, f->counter, 0U);
+#endif
+                self->sm_interface->ctr(self->sm, LDL_SM_KEY_NWKSENC, &A, f->opts, f->optsLen);
+            }
+#endif
+            initA(&A, 0U, f->devAddr, false, f->counter, 1U);
 
-    if(U32(counter) < mine){
+            self->sm_interface->ctr(self->sm, (f->port == 0U) ? LDL_SM_KEY_NWKSENC : LDL_SM_KEY_APPS, &A, f->data, f->dataLen);
+        }
+            break;
+        }
 
-        mine = mine + U32(0x10000) + U32(counter);
+        retval = true;
     }
     else{
 
-        mine = mine + U32(counter);
+        /* MIC failed */
+        if(f->type == FRAME_TYPE_JOIN_ACCEPT){
+
+            LDL_DEBUG("joinAccept MIC failed")
+        }
+        else{
+
+            LDL_DEBUG("data MIC failed")
+        }
     }
 
-    return mine;
+    return retval;
 }
 
-static uint8_t putEUI(uint8_t *buf, const uint8_t *value)
+uint8_t LDL_OPS_putEUI(uint8_t *buf, const uint8_t *value)
 {
     buf[0] = value[7];
     buf[1] = value[6];
@@ -464,14 +509,14 @@ static uint8_t putEUI(uint8_t *buf, const uint8_t *value)
     return 8U;
 }
 
-static uint8_t putU8(uint8_t *buf, uint8_t value)
+uint8_t LDL_OPS_putU8(uint8_t *buf, uint8_t value)
 {
     buf[0] = value;
 
     return 1U;
 }
 
-static uint8_t putU16(uint8_t *buf, uint16_t value)
+uint8_t LDL_OPS_putU16(uint8_t *buf, uint16_t value)
 {
     buf[0] = U8(value);
     buf[1] = U8(value >> 8);
@@ -479,7 +524,7 @@ static uint8_t putU16(uint8_t *buf, uint16_t value)
     return 2U;
 }
 
-static uint8_t putU24(uint8_t *buf, uint32_t value)
+uint8_t LDL_OPS_putU24(uint8_t *buf, uint32_t value)
 {
     buf[0] = U8(value);
     buf[1] = U8(value >> 8);
@@ -488,7 +533,7 @@ static uint8_t putU24(uint8_t *buf, uint32_t value)
     return 3U;
 }
 
-static uint8_t putU32(uint8_t *buf, uint32_t value)
+uint8_t LDL_OPS_putU32(uint8_t *buf, uint32_t value)
 {
     buf[0] = U8(value);
     buf[1] = U8(value >> 8);
@@ -497,3 +542,68 @@ static uint8_t putU32(uint8_t *buf, uint32_t value)
 
     return 4U;
 }
+
+/* static functions ***************************************************/
+
+static void initA(struct ldl_block *a, uint32_t c, uint32_t devAddr, bool up, uint32_t counter, uint8_t i)
+{
+    uint8_t pos = 0U;
+    uint8_t *ptr = a->value;
+
+    pos += LDL_OPS_putU8(&ptr[pos], 1U);
+    pos += LDL_OPS_putU32(&ptr[pos], c);
+    pos += LDL_OPS_putU8(&ptr[pos], up ? 0U : 1U);
+    pos += LDL_OPS_putU32(&ptr[pos], devAddr);
+    pos += LDL_OPS_putU32(&ptr[pos], counter);
+    pos += LDL_OPS_putU8(&ptr[pos], 0U);
+    (void)LDL_OPS_putU8(&ptr[pos], i);
+}
+
+static void initB(struct ldl_block *b, uint16_t confirmCounter, uint8_t rate, uint8_t chIndex, bool up, uint32_t devAddr, uint32_t upCounter, uint8_t len)
+{
+    uint8_t pos = 0U;
+    uint8_t *ptr = b->value;
+
+    pos += LDL_OPS_putU8(&ptr[pos], 0x49U);
+    pos += LDL_OPS_putU16(&ptr[pos], confirmCounter);
+    pos += LDL_OPS_putU8(&ptr[pos], rate);
+    pos += LDL_OPS_putU8(&ptr[pos], chIndex);
+    pos += LDL_OPS_putU8(&ptr[pos], up ? 0U : 1U);
+    pos += LDL_OPS_putU32(&ptr[pos], devAddr);
+    pos += LDL_OPS_putU32(&ptr[pos], upCounter);
+    pos += LDL_OPS_putU8(&ptr[pos], 0U);
+    (void)LDL_OPS_putU8(&ptr[pos], len);
+}
+
+static void putMIC(const struct ldl_mac *self, void *buffer, uint8_t size, uint32_t micF, uint32_t micS)
+{
+    /* unused if only 1.0 is enabled */
+    (void)self;
+
+    if(SESS_VERSION(self->ctx) == 1U){
+
+        LDL_Frame_updateMIC(buffer, size, ((micF << 16) | (micS & U32(0xffff))));
+    }
+    else{
+
+        LDL_Frame_updateMIC(buffer, size, micF);
+    }
+}
+
+static uint32_t deriveDownCounter(struct ldl_mac *self, uint8_t port, uint16_t counter)
+{
+    uint32_t mine = ((SESS_VERSION(self->ctx) > 0U) && (port == 0U)) ? U32(self->ctx.nwkDown) : U32(self->ctx.appDown);
+
+    mine = mine << 16;
+
+    if(U32(counter) < mine){
+
+        mine = mine + U32(0x10000) + U32(counter);
+    }
+    else{
+
+        mine = mine + U32(counter);
+    }
+
+    return mine;
+}
@@ -26,6 +26,14 @@
 #include "ldl_system.h"
 #include "ldl_internal.h"
 
+/* static function prototypes *****************************************/
+
+#ifdef LDL_ENABLE_CHIP_ASYNC
+static void transfersComplete(void *ctx, bool ok);
+static bool writeQueued(struct ldl_radio *self);
+static uint8_t *queueCopy(struct ldl_radio *self, const void *data, size_t size);
+#endif
+
 /* functions **********************************************************/
 
 const struct ldl_radio_interface *LDL_Radio_getInterface(const struct ldl_radio *self)
@@ -87,6 +95,136 @@ void LDL_Radio_handleInterrupt(struct ldl_radio *self, uint8_t n)
     }
 }
 
+bool LDL_Radio_beginTransfers(struct ldl_radio *self)
+{
+    LDL_PEDANTIC(self != NULL)
+
+    bool retval = true;
+
+#ifdef LDL_ENABLE_CHIP_ASYNC
+    LDL_PEDANTIC(!self->queue.open)
+
+    if(self->queue.failed){
+
+        self->queue.failed = false;
+        retval = false;
+    }
+
+    /* write directly if the last submission is outstanding since
+     * chip_write will wait for it anyway */
+    if((self->chip_submit != NULL) && !self->queue.busy){
+
+        self->queue.count = 0U;
+        self->queue.used = 0U;
+        self->queue.open = true;
+    }
+#endif
+
+    return retval;
+}
+
+void LDL_Radio_endTransfers(struct ldl_radio *self)
+{
+    LDL_PEDANTIC(self != NULL)
+
+#ifdef LDL_ENABLE_CHIP_ASYNC
+    if(self->queue.open){
+
+        self->queue.open = false;
+
+        if(self->queue.count > 0U){
+
+            self->queue.busy = true;
+
+            if(!self->chip_submit(self->chip, self->queue.transfer, self->queue.count, transfersComplete, self)){
+
+                self->queue.busy = false;
+
+                LDL_DEBUG("chip submission refused")
+
+                (void)writeQueued(self);
+            }
+        }
+    }
+#endif
+}
+
+bool LDL_Radio_write(struct ldl_radio *self, const void *opcode, size_t opcode_size, const void *data, size_t size, bool copy)
+{
+    LDL_PEDANTIC(self != NULL)
+
+    bool retval = true;
+    bool queued = false;
+
+#ifdef LDL_ENABLE_CHIP_ASYNC
+    struct ldl_chip_transfer *transfer;
+
+    if(self->queue.open){
+
+        if(self->queue.count < (sizeof(self->queue.transfer)/sizeof(*self->queue.transfer))){
+
+            transfer = &self->queue.transfer[self->queue.count];
+
+            transfer->opcode = queueCopy(self, opcode, opcode_size);
+            transfer->opcode_size = opcode_size;
+            transfer->data = (copy && (size > 0U)) ? queueCopy(self, data, size) : data;
+            transfer->size = size;
+
+            if((transfer->opcode != NULL) && ((transfer->data != NULL) || (size == 0U))){
+
+                self->queue.count++;
+                queued = true;
+            }
+        }
+
+        if(!queued){
+
+            /* out of space so the rest of this batch is written directly */
+            LDL_DEBUG("chip queue full")
+
+            self->queue.open = false;
+
+            retval = writeQueued(self);
+        }
+    }
+#else
+    (void)copy;
+#endif
+
+    if(retval && !queued){
+
+        retval = self->chip_write(self->chip, opcode, opcode_size, data, size);
+    }
+
+    return retval;
+}
+
+bool LDL_Radio_read(struct ldl_radio *self, const void *opcode, size_t opcode_size, void *data, size_t size)
+{
+    LDL_PEDANTIC(self != NULL)
+
+    bool retval = true;
+
+#ifdef LDL_ENABLE_CHIP_ASYNC
+    /* the read may depend on what has been queued */
+    if(self->queue.open && (self->queue.count > 0U)){
+
+        retval = writeQueued(self);
+
+        self->queue.count = 0U;
+        self->queue.used = 0U;
+        self->queue.open = retval;
+    }
+#endif
+
+    if(retval){
+
+        retval = self->chip_read(self->chip, opcode, opcode_size, data, size);
+    }
+
+    return retval;
+}
+
 int16_t LDL_Radio_getMinSNR(enum ldl_spreading_factor sf)
 {
     int16_t retval = 0;
@@ -134,7 +272,7 @@ uint32_t LDL_Radio_getAirTime(enum ldl_signal_bandwidth bw, enum ldl_spreading_f
      * Ts = 1 / Rs
      * Tpreamble = ( Npreamble x 4.25 ) x Tsym
      *
-     * Npayload = 8 + max( ceil[( 8PL - 4SF + 28 + 16CRC + 20IH ) / ( 4(SF - 2DE) )] x (CR + 4), 0 )
+     * Npayload = 8 + max( ceil[( 8PL - 4SF + 28 + 16CRC - 20IH ) / ( 4(SF - 2DE) )] x (CR + 4), 0 )
      *
      * Tpayload = Npayload x Ts
      *
@@ -161,7 +299,9 @@ uint32_t LDL_Radio_getAirTime(enum ldl_signal_bandwidth bw, enum ldl_spreading_f
     Ts = ((U32(1) << sf) * U32(1000000)) / LDL_Radio_bwToNumber(bw);
     Tpreamble = (Ts * U32(12)) +  (Ts / U32(4));
 
-    numerator = (U32(8) * U32(size)) - (U32(4) * U32(sf)) + U32(28) + ( crc ? U32(16) : U32(0) ) - ( header ? U32(20) : U32(0) );
+    /* IH is only set in implicit header mode */
+    numerator = (U32(8) * U32(size)) + U32(28) + ( crc ? U32(16) : U32(0) ) - ( header ? U32(0) : U32(20) );
+    numerator = (numerator > (U32(4) * U32(sf))) ? (numerator - (U32(4) * U32(sf))) : U32(0);
     denom = U32(4) * (U32(sf) - ( lowDataRateOptimize ? U32(2) : U32(0) ));
 
     Npayload = U32(8) + ((((numerator / denom) + (((numerator % denom) != 0U) ? U32(1) : U32(0))) * (U32(LDL_CR_5) + U32(4))));
@@ -194,3 +334,57 @@ uint32_t LDL_Radio_bwToNumber(enum ldl_signal_bandwidth bw)
     return retval;
 }
 
+/* static functions ***************************************************/
+
+#ifdef LDL_ENABLE_CHIP_ASYNC
+static void transfersComplete(void *ctx, bool ok)
+{
+    struct ldl_radio *self = (struct ldl_radio *)ctx;
+
+    if(!ok){
+
+        self->queue.failed = true;
+    }
+
+    self->queue.busy = false;
+}
+
+static bool writeQueued(struct ldl_radio *self)
+{
+    bool retval = true;
+    size_t i;
+    const struct ldl_chip_transfer *transfer;
+
+    for(i=0U; i < self->queue.count; i++){
+
+        transfer = &self->queue.transfer[i];
+
+        retval = self->chip_write(self->chip, transfer->opcode, transfer->opcode_size, transfer->data, transfer->size);
+        if(!retval){ break; }
+    }
+
+    /* values the driver expects to have been written may not have been */
+    if(!retval){
+
+        self->queue.failed = true;
+    }
+
+    return retval;
+}
+
+static uint8_t *queueCopy(struct ldl_radio *self, const void *data, size_t size)
+{
+    uint8_t *retval = NULL;
+
+    if((self->queue.used + size) <= sizeof(self->queue.buffer)){
+
+        retval = &self->queue.buffer[self->queue.used];
+
+        (void)memcpy(retval, data, size);
+
+        self->queue.used += size;
+    }
+
+    return retval;
+}
+#endif
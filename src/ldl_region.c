@@ -45,212 +45,410 @@
 
 #include <stddef.h>
 
+/* with only one region the descriptor is a compile time constant that
+ * the compiler can fold into the code that reads it */
+#if (defined(LDL_ENABLE_EU_863_870) + defined(LDL_ENABLE_US_902_928) + defined(LDL_ENABLE_AU_915_928) + defined(LDL_ENABLE_EU_433)) == 1
+
+    #define SINGLE_REGION
+
+    #define DESC_PROGMEM
+
+    /* gcc folds an assignment from the descriptor but not a memcpy
+     * of a pointer member */
+    #define memcpy_desc(DST, SRC, SIZE) (*(DST) = *(SRC))
+
+#else
+
+    #define DESC_PROGMEM PROGMEM
+    #define memcpy_desc memcpy_P
+
+#endif
+
 /* static function prototypes *****************************************/
 
-static bool upRateRange(enum ldl_region region, uint8_t chIndex, uint8_t *minRate, uint8_t *maxRate);
+static const struct ldl_region_desc *getRegion(enum ldl_region region);
+static bool upRateRange(const struct ldl_region_desc *desc, uint8_t chIndex, uint8_t *minRate, uint8_t *maxRate);
 
-/* functions **********************************************************/
+/* region descriptors *************************************************/
 
-void LDL_Region_convertRate(enum ldl_region region, uint8_t rate, enum ldl_spreading_factor *sf, enum ldl_signal_bandwidth *bw, uint8_t *mtu)
-{
-    LDL_PEDANTIC(sf != NULL)
-    LDL_PEDANTIC(bw != NULL)
-    LDL_PEDANTIC(mtu != NULL)
+/* fixed channel plans space uplink channels 200KHz apart and RX1
+ * channels 600KHz apart */
+#define UP_SPACING U32(200000)
+#define RX1_SPACING U32(600000)
+
+/* width of a cell in ldl_region_desc.bandMap */
+#define BAND_STEP U32(50000)
+
+/* bandMap cell outside of every band */
+#define BAND_GAP 0xffU
+
+/* rates are indexed by data rate (mtu of zero means not defined) */
+struct ldl_region_rate {
+
+    uint8_t sf;
+    uint8_t bw;
+    uint8_t mtu;
+};
+
+struct ldl_region_desc {
+
+    const struct ldl_region_rate *rates;
+
+    /* (tx_rate * rx1RatesWidth) + rx1_offset */
+    const uint8_t *rx1Rates;
+
+    /* dynamic channel plans only */
+    const uint32_t *defaultFreqs;
+
+    /* indexed by band */
+    const uint16_t *offTimeFactors;
+
+    /* band of each BAND_STEP above bandMapBase
+     *
+     * Bands in the map may not touch. A frequency on the boundary
+     * between a band and a gap belongs to the band.
+     *
+     * */
+    const uint8_t *bandMap;
+
+#ifndef LDL_TRACE_DISABLED
+    const char *name;
+#endif
+
+    /* valid centre frequencies (inclusive) */
+    uint32_t minFreq;
+    uint32_t maxFreq;
+
+    /* band 0 is bandMin..bandMapBase (inclusive) */
+    uint32_t bandMin;
+    uint32_t bandMapBase;
+
+    /* fixed channel plans only
+     *
+     * first frequency of the channels below firstWide and the
+     * channels from firstWide
+     *
+     * */
+    uint32_t upFreq[2U];
+    uint32_t rx1Freq;
+
+    uint32_t rx2Freq;
+
+    /* dBm x 100 */
+    int16_t maxEIRP;
+
+    uint8_t numRates;
+    uint8_t numBands;
+    uint8_t numBandCells;
+    uint8_t numDefaultFreqs;
+    uint8_t rx1RatesSize;
+    uint8_t rx1RatesWidth;
+    uint8_t numChannels;
+
+    /* channels from firstWide use upMinRate[1]..upMaxRate[1] */
+    uint8_t firstWide;
+    uint8_t upMinRate[2U];
+    uint8_t upMaxRate[2U];
+
+    uint8_t rx2Rate;
+    uint8_t maxPower;
+
+    /* joinRate - (trial % joinRateCycle) */
+    uint8_t joinRate;
+    uint8_t joinRateCycle;
+
+    /* lowest rate allowed when uplink dwell time is limited */
+    uint8_t dwellMinRate;
+
+    bool dynamic;
+    bool txParamSetup;
+};
+
+#ifndef LDL_TRACE_DISABLED
+    #define REGION_NAME(X) .name = X,
+#else
+    #define REGION_NAME(X)
+#endif
 
-    switch(region){
 #if defined(LDL_ENABLE_EU_863_870) || defined(LDL_ENABLE_EU_433)
-#   ifdef LDL_ENABLE_EU_863_870
-    case LDL_EU_863_870:
-#   endif
-#   ifdef LDL_ENABLE_EU_433
-    case LDL_EU_433:
-#   endif
-        switch(rate){
-        case 0U:
-            *sf = LDL_SF_12;
-            *bw = LDL_BW_125;
-            *mtu = 59U;
-            break;
-        case 1U:
-            *sf = LDL_SF_11;
-            *bw = LDL_BW_125;
-            *mtu = 59U;
-            break;
-        case 2U:
-            *sf = LDL_SF_10;
-            *bw = LDL_BW_125;
-            *mtu = 59U;
-            break;
-        case 3U:
-            *sf = LDL_SF_9;
-            *bw = LDL_BW_125;
-            *mtu = 123U;
-            break;
-        case 4U:
-            *sf = LDL_SF_8;
-            *bw = LDL_BW_125;
-            *mtu = 250U;
-            break;
-        case 5U:
-            *sf = LDL_SF_7;
-            *bw = LDL_BW_125;
-            *mtu = 250U;
-            break;
-        case 6U:
-            *sf = LDL_SF_7;
-            *bw = LDL_BW_250;
-            *mtu = 250U;
-            break;
-        default:
-            *sf = LDL_SF_7;
-            *bw = LDL_BW_125;
-            *mtu = 250U;
-            LDL_INFO("invalid rate")
-            break;
-        }
-        break;
+static const struct ldl_region_rate euRates[] PROGMEM = {
+    {LDL_SF_12, LDL_BW_125, 59U},
+    {LDL_SF_11, LDL_BW_125, 59U},
+    {LDL_SF_10, LDL_BW_125, 59U},
+    {LDL_SF_9, LDL_BW_125, 123U},
+    {LDL_SF_8, LDL_BW_125, 250U},
+    {LDL_SF_7, LDL_BW_125, 250U},
+    {LDL_SF_7, LDL_BW_250, 250U},
+};
+
+static const uint8_t euRX1Rates[] PROGMEM = {
+    0U, 0U, 0U, 0U, 0U, 0U,
+    1U, 0U, 0U, 0U, 0U, 0U,
+    2U, 1U, 0U, 0U, 0U, 0U,
+    3U, 2U, 1U, 0U, 0U, 0U,
+    4U, 3U, 2U, 1U, 0U, 0U,
+    5U, 4U, 3U, 2U, 1U, 0U,
+    6U, 5U, 4U, 3U, 2U, 1U,
+    7U, 6U, 5U, 4U, 3U, 2U,
+};
+#endif
+
+#ifdef LDL_ENABLE_EU_863_870
+static const uint16_t eu863OffTimeFactors[] PROGMEM = {
+    100U,       // 863.0   - 868.0     1.0%
+    100U,       // 868.0   - 868.6     1.0%
+    1000U,      // 868.7   - 869.2     0.1%
+    10U,        // 869.4   - 869.65   10.0%
+    100U,       // 869.7   - 870.0     1.0%
+};
+
+/* 868.0 to 870.0 */
+static const uint8_t eu863BandMap[] PROGMEM = {
+    1U, 1U, 1U, 1U, 1U, 1U, 1U, 1U, 1U, 1U, 1U, 1U,
+    BAND_GAP, BAND_GAP,
+    2U, 2U, 2U, 2U, 2U, 2U, 2U, 2U, 2U, 2U,
+    BAND_GAP, BAND_GAP, BAND_GAP, BAND_GAP,
+    3U, 3U, 3U, 3U, 3U,
+    BAND_GAP,
+    4U, 4U, 4U, 4U, 4U, 4U
+};
+
+static const uint32_t eu863DefaultFreqs[] PROGMEM = {
+    U32(868100000),
+    U32(868300000),
+    U32(868500000)
+};
+#endif
+
+#ifdef LDL_ENABLE_EU_433
+static const uint16_t eu433OffTimeFactors[] PROGMEM = {
+    100U
+};
+
+static const uint32_t eu433DefaultFreqs[] PROGMEM = {
+    U32(433175000),
+    U32(433375000),
+    U32(433575000)
+};
+#endif
+
+#if defined(LDL_ENABLE_US_902_928) || defined(LDL_ENABLE_AU_915_928)
+/* no duty cycle limit */
+static const uint16_t fixedOffTimeFactors[] PROGMEM = {
+    0U
+};
+#endif
+
+#ifdef LDL_ENABLE_US_902_928
+static const struct ldl_region_rate us902Rates[] PROGMEM = {
+    {LDL_SF_10, LDL_BW_125, 19U},
+    {LDL_SF_9, LDL_BW_125, 61U},
+    {LDL_SF_8, LDL_BW_125, 133U},
+    {LDL_SF_7, LDL_BW_125, 250U},
+    {LDL_SF_8, LDL_BW_500, 250U},
+    {0U, 0U, 0U},
+    {0U, 0U, 0U},
+    {0U, 0U, 0U},
+    {LDL_SF_12, LDL_BW_500, 61U},
+    {LDL_SF_11, LDL_BW_500, 137U},
+    {LDL_SF_10, LDL_BW_500, 250U},
+    {LDL_SF_9, LDL_BW_500, 250U},
+    {LDL_SF_8, LDL_BW_500, 250U},
+    {LDL_SF_7, LDL_BW_500, 250U},
+};
+
+static const uint8_t us902RX1Rates[] PROGMEM = {
+    10U, 9U,  8U,  8U,
+    11U, 10U, 9U,  8U,
+    12U, 11U, 10U, 9U,
+    13U, 12U, 11U, 10U,
+    13U, 13U, 12U, 11U,
+};
+#endif
+
+#ifdef LDL_ENABLE_AU_915_928
+static const struct ldl_region_rate au915Rates[] PROGMEM = {
+    {LDL_SF_12, LDL_BW_125, 59U},
+    {LDL_SF_11, LDL_BW_125, 59U},
+    {LDL_SF_10, LDL_BW_125, 59U},
+    {LDL_SF_9, LDL_BW_125, 123U},
+    {LDL_SF_8, LDL_BW_125, 250U},
+    {LDL_SF_7, LDL_BW_125, 250U},
+    {LDL_SF_8, LDL_BW_500, 250U},
+    {0U, 0U, 0U},
+    {LDL_SF_12, LDL_BW_500, 61U},
+    {LDL_SF_11, LDL_BW_500, 137U},
+    {LDL_SF_10, LDL_BW_500, 250U},
+    {LDL_SF_9, LDL_BW_500, 250U},
+    {LDL_SF_8, LDL_BW_500, 250U},
+    {LDL_SF_7, LDL_BW_500, 250U},
+};
+
+static const uint8_t au915RX1Rates[] PROGMEM = {
+    8U,  8U,  8U,  8U,  8U,  8U,
+    9U,  8U,  8U,  8U,  8U,  8U,
+    10U, 9U,  8U,  8U,  8U,  8U,
+    11U, 10U, 9U,  8U,  8U,  8U,
+    12U, 11U, 10U, 9U,  8U,  8U,
+    13U, 12U, 11U, 10U, 9U,  8U,
+    13U, 13U, 12U, 11U, 10U, 9U,
+};
+#endif
+
+/* indexed by enum ldl_region */
+static const struct ldl_region_desc regions[] DESC_PROGMEM = {
+#ifdef LDL_ENABLE_EU_863_870
+    [LDL_EU_863_870] = {
+        .rates = euRates,
+        .rx1Rates = euRX1Rates,
+        .defaultFreqs = eu863DefaultFreqs,
+        .offTimeFactors = eu863OffTimeFactors,
+        .bandMap = eu863BandMap,
+        REGION_NAME("LDL_EU_863_870")
+        .minFreq = U32(863000001),
+        .maxFreq = U32(869999999),
+        .bandMin = U32(863000000),
+        .bandMapBase = U32(868000000),
+        .rx2Freq = U32(869525000),
+        .maxEIRP = 1600,
+        .numRates = sizeof(euRates)/sizeof(*euRates),
+        .numBands = sizeof(eu863OffTimeFactors)/sizeof(*eu863OffTimeFactors),
+        .numBandCells = sizeof(eu863BandMap),
+        .numDefaultFreqs = sizeof(eu863DefaultFreqs)/sizeof(*eu863DefaultFreqs),
+        .rx1RatesSize = sizeof(euRX1Rates),
+        .rx1RatesWidth = 6U,
+        .numChannels = 16U,
+        .firstWide = 16U,
+        .upMaxRate = {5U, 0U},
+        .rx2Rate = 0U,
+        .maxPower = 7U,
+        .joinRate = 5U,
+        .joinRateCycle = 6U - U8(MIN_RATE),
+        .dynamic = true
+    },
 #endif
 #ifdef LDL_ENABLE_US_902_928
-    case LDL_US_902_928:
-
-        switch(rate){
-        case 0U:
-            *sf = LDL_SF_10;
-            *bw = LDL_BW_125;
-            *mtu = 19U;
-            break;
-        case 1U:
-            *sf = LDL_SF_9;
-            *bw = LDL_BW_125;
-            *mtu = 61U;
-            break;
-        case 2U:
-            *sf = LDL_SF_8;
-            *bw = LDL_BW_125;
-            *mtu = 133U;
-            break;
-        case 3U:
-            *sf = LDL_SF_7;
-            *bw = LDL_BW_125;
-            *mtu = 250U;
-            break;
-        case 4U:
-        case 12U:
-            *sf = LDL_SF_8;
-            *bw = LDL_BW_500;
-            *mtu = 250U;
-            break;
-        case 8U:
-            *sf = LDL_SF_12;
-            *bw = LDL_BW_500;
-            *mtu = 61U;
-            break;
-        case 9U:
-            *sf = LDL_SF_11;
-            *bw = LDL_BW_500;
-            *mtu = 137U;
-            break;
-        case 10U:
-            *sf = LDL_SF_10;
-            *bw = LDL_BW_500;
-            *mtu = 250U;
-            break;
-        case 11U:
-            *sf = LDL_SF_9;
-            *bw = LDL_BW_500;
-            *mtu = 250U;
-            break;
-        case 13U:
-            *sf = LDL_SF_7;
-            *bw = LDL_BW_500;
-            *mtu = 250U;
-            break;
-        default:
-            *sf = LDL_SF_7;
-            *bw = LDL_BW_125;
-            *mtu = 250U;
-            LDL_INFO("invalid rate")
-            break;
-        }
-        break;
+    [LDL_US_902_928] = {
+        .rates = us902Rates,
+        .rx1Rates = us902RX1Rates,
+        .defaultFreqs = NULL,
+        .offTimeFactors = fixedOffTimeFactors,
+        REGION_NAME("LDL_US_902_928")
+        .minFreq = U32(902000001),
+        .maxFreq = U32(927999999),
+        .bandMapBase = UINT32_MAX,
+        .upFreq = {U32(902300000), U32(903000000)},
+        .rx1Freq = U32(923300000),
+        .rx2Freq = U32(923300000),
+        .maxEIRP = 3000,
+        .numRates = sizeof(us902Rates)/sizeof(*us902Rates),
+        .numBands = sizeof(fixedOffTimeFactors)/sizeof(*fixedOffTimeFactors),
+        .rx1RatesSize = sizeof(us902RX1Rates),
+        .rx1RatesWidth = 4U,
+        .numChannels = 72U,
+        .firstWide = 64U,
+        .upMinRate = {0U, 4U},
+        .upMaxRate = {3U, 4U},
+        .rx2Rate = 8U,
+        .maxPower = 10U,
+        .joinRate = MIN_RATE,
+        .joinRateCycle = 1U
+    },
 #endif
 #ifdef LDL_ENABLE_AU_915_928
-    case LDL_AU_915_928:
-
-        switch(rate){
-        case 0U:
-            *sf = LDL_SF_12;
-            *bw = LDL_BW_125;
-            *mtu = 59U;
-            break;
-        case 1U:
-            *sf = LDL_SF_11;
-            *bw = LDL_BW_125;
-            *mtu = 59U;
-            break;
-        case 2U:
-            *sf = LDL_SF_10;
-            *bw = LDL_BW_125;
-            *mtu = 59U;
-            break;
-        case 3U:
-            *sf = LDL_SF_9;
-            *bw = LDL_BW_125;
-            *mtu = 123U;
-            break;
-        case 4U:
-            *sf = LDL_SF_8;
-            *bw = LDL_BW_125;
-            *mtu = 250U;
-            break;
-        case 5U:
-            *sf = LDL_SF_7;
-            *bw = LDL_BW_125;
-            *mtu = 250U;
-            break;
-        case 6U:
-        case 12U:
-            *sf = LDL_SF_8;
-            *bw = LDL_BW_500;
-            *mtu = 250U;
-            break;
-        case 8U:
-            *sf = LDL_SF_12;
-            *bw = LDL_BW_500;
-            *mtu = 61U;
-            break;
-        case 9U:
-            *sf = LDL_SF_11;
-            *bw = LDL_BW_500;
-            *mtu = 137U;
-            break;
-        case 10U:
-            *sf = LDL_SF_10;
-            *bw = LDL_BW_500;
-            *mtu = 250U;
-            break;
-        case 11U:
-            *sf = LDL_SF_9;
-            *bw = LDL_BW_500;
-            *mtu = 250U;
-            break;
-        case 13U:
-            *sf = LDL_SF_7;
-            *bw = LDL_BW_500;
-            *mtu = 250U;
-            break;
-        default:
-            *sf = LDL_SF_7;
-            *bw = LDL_BW_125;
-            *mtu = 250U;
-            LDL_INFO("invalid rate")
-            break;
-        }
-        break;
+    [LDL_AU_915_928] = {
+        .rates = au915Rates,
+        .rx1Rates = au915RX1Rates,
+        .defaultFreqs = NULL,
+        .offTimeFactors = fixedOffTimeFactors,
+        REGION_NAME("LDL_AU_915_928")
+        .minFreq = U32(915000001),
+        .maxFreq = U32(927999999),
+        .bandMapBase = UINT32_MAX,
+        .upFreq = {U32(915200000), U32(915900000)},
+        .rx1Freq = U32(923300000),
+        .rx2Freq = U32(923300000),
+        .maxEIRP = 3000,
+        .numRates = sizeof(au915Rates)/sizeof(*au915Rates),
+        .numBands = sizeof(fixedOffTimeFactors)/sizeof(*fixedOffTimeFactors),
+        .rx1RatesSize = sizeof(au915RX1Rates),
+        .rx1RatesWidth = 6U,
+        .numChannels = 72U,
+        .firstWide = 64U,
+        .upMinRate = {0U, 6U},
+        .upMaxRate = {5U, 6U},
+        .rx2Rate = 8U,
+        .maxPower = 10U,
+        .joinRate = 2U,
+        .joinRateCycle = 1U,
+        .dwellMinRate = 2U,
+        .txParamSetup = true
+    },
 #endif
-    default:
-        /* impossible */
-        break;
+#ifdef LDL_ENABLE_EU_433
+    [LDL_EU_433] = {
+        .rates = euRates,
+        .rx1Rates = euRX1Rates,
+        .defaultFreqs = eu433DefaultFreqs,
+        .offTimeFactors = eu433OffTimeFactors,
+        REGION_NAME("LDL_EU_433")
+        .minFreq = U32(433175000),
+        .maxFreq = U32(434665000),
+        .bandMapBase = UINT32_MAX,
+        .rx2Freq = U32(434665000),
+        .maxEIRP = 1215,
+        .numRates = sizeof(euRates)/sizeof(*euRates),
+        .numBands = sizeof(eu433OffTimeFactors)/sizeof(*eu433OffTimeFactors),
+        .numDefaultFreqs = sizeof(eu433DefaultFreqs)/sizeof(*eu433DefaultFreqs),
+        .rx1RatesSize = sizeof(euRX1Rates),
+        .rx1RatesWidth = 6U,
+        .numChannels = 16U,
+        .firstWide = 16U,
+        .upMaxRate = {5U, 0U},
+        .rx2Rate = 0U,
+        .maxPower = 5U,
+        .joinRate = 5U,
+        .joinRateCycle = 6U - U8(MIN_RATE),
+        .dynamic = true
+    },
+#endif
+};
+
+/* functions **********************************************************/
+
+void LDL_Region_convertRate(enum ldl_region region, uint8_t rate, enum ldl_spreading_factor *sf, enum ldl_signal_bandwidth *bw, uint8_t *mtu)
+{
+    LDL_PEDANTIC(sf != NULL)
+    LDL_PEDANTIC(bw != NULL)
+    LDL_PEDANTIC(mtu != NULL)
+
+    const struct ldl_region_desc *desc = getRegion(region);
+    const struct ldl_region_rate *rates;
+    struct ldl_region_rate r;
+    uint8_t numRates;
+
+    (void)memcpy_desc(&rates, &desc->rates, sizeof(rates));
+    (void)memcpy_desc(&numRates, &desc->numRates, sizeof(numRates));
+
+    r.mtu = 0U;
+
+    if(rate < numRates){
+
+        (void)memcpy_P(&r, &rates[rate], sizeof(r));
+    }
+
+    if(r.mtu > 0U){
+
+        *sf = (enum ldl_spreading_factor)r.sf;
+        *bw = (enum ldl_signal_bandwidth)r.bw;
+        *mtu = r.mtu;
+    }
+    else{
+
+        *sf = LDL_SF_7;
+        *bw = LDL_BW_125;
+        *mtu = 250U;
+        LDL_INFO("invalid rate")
     }
 }
 
@@ -258,131 +456,94 @@ bool LDL_Region_getBand(enum ldl_region region, uint32_t freq, uint8_t *band)
 {
     LDL_PEDANTIC(band != NULL)
 
-    bool retval = false;
+    const struct ldl_region_desc *desc = getRegion(region);
+    const uint8_t *map;
+    uint32_t min;
+    uint32_t base;
+    uint32_t offset;
+    uint32_t cell;
+    uint8_t numCells;
+    uint8_t b = BAND_GAP;
 
-    switch(region){
-#ifdef LDL_ENABLE_EU_863_870
-    case LDL_EU_863_870:
+    (void)memcpy_desc(&min, &desc->bandMin, sizeof(min));
+    (void)memcpy_desc(&base, &desc->bandMapBase, sizeof(base));
 
-        retval = true;
+    if(freq <= base){
 
-        if((freq >= U32(863000000)) && (freq <= U32(868000000))){
+        if(freq >= min){
 
-            *band = 0U;
+            b = 0U;
         }
-        else if((freq >= U32(868000000)) && (freq <= U32(868600000))){
+    }
+    else{
 
-            *band = 1U;
-        }
-        else if((freq >= U32(868700000)) && (freq <= U32(869200000))){
+        (void)memcpy_desc(&map, &desc->bandMap, sizeof(map));
+        (void)memcpy_desc(&numCells, &desc->numBandCells, sizeof(numCells));
 
-            *band = 2U;
-        }
-        else if((freq >= U32(869400000)) && (freq <= U32(869650000))){
+        offset = freq - base;
+        cell = offset / BAND_STEP;
 
-            *band = 3U;
-        }
-        else if((freq >= U32(869700000)) && (freq < U32(870000000))){
+        if(cell < U32(numCells)){
 
-            *band = 4U;
-        }
-        else{
+            (void)memcpy_P(&b, &map[cell], sizeof(b));
 
-            retval = false;
+            /* the upper edge of a band is also the lower edge of the next cell */
+            if((b == BAND_GAP) && ((offset % BAND_STEP) == 0U)){
+
+                (void)memcpy_P(&b, &map[cell - 1U], sizeof(b));
+            }
         }
-        break;
-#endif
-    default:
-        *band = 0U;
-        retval = true;
-        break;
     }
 
-    return retval;
+    *band = b;
+
+    return (b != BAND_GAP);
 }
 
 bool LDL_Region_isDynamic(enum ldl_region region)
 {
+    const struct ldl_region_desc *desc = getRegion(region);
     bool retval;
 
-    switch(region){
-    default:
-        retval = true;
-        break;
-#ifdef LDL_ENABLE_US_902_928
-    case LDL_US_902_928:
-        retval = false;
-        break;
-#endif
-#ifdef LDL_ENABLE_AU_915_928
-    case LDL_AU_915_928:
-        retval = false;
-        break;
-#endif
-    }
+    (void)memcpy_desc(&retval, &desc->dynamic, sizeof(retval));
 
     return retval;
 }
 
 bool LDL_Region_getChannel(enum ldl_region region, uint8_t chIndex, uint32_t *freq, uint8_t *minRate, uint8_t *maxRate)
 {
+    const struct ldl_region_desc *desc = getRegion(region);
+    uint32_t upFreq;
+    uint8_t numChannels;
+    uint8_t first;
+    bool dynamic;
     bool retval = false;
 
-    (void)chIndex;
-    (void)freq;
-    (void)minRate;
-    (void)maxRate;
+    (void)memcpy_desc(&dynamic, &desc->dynamic, sizeof(dynamic));
+    (void)memcpy_desc(&numChannels, &desc->numChannels, sizeof(numChannels));
 
-    switch(region){
-    default:
-        /* impossible */
-        break;
-#ifdef LDL_ENABLE_US_902_928
-    case LDL_US_902_928:
-
-        retval = true;
+    /* dynamic channels are held by the MAC */
+    if(!dynamic && (chIndex < numChannels)){
 
-        if(chIndex < 64U){
+        (void)memcpy_desc(&first, &desc->firstWide, sizeof(first));
 
-            *freq = U32(902300000) + ( U32(200000) * U32(chIndex));
-            *minRate = 0U;
-            *maxRate = 3U;
-        }
-        else if(chIndex < 72U){
+        if(chIndex < first){
 
-            *freq = U32(903000000) + ( U32(200000) * U32(chIndex - U32(64)));
-            *minRate = 4U;
-            *maxRate = 4U;
+            first = 0U;
+            (void)memcpy_desc(&upFreq, &desc->upFreq[0], sizeof(upFreq));
+            (void)memcpy_desc(minRate, &desc->upMinRate[0], sizeof(*minRate));
+            (void)memcpy_desc(maxRate, &desc->upMaxRate[0], sizeof(*maxRate));
         }
         else{
 
-            retval = false;
-        }
-        break;
-#endif
-#ifdef LDL_ENABLE_AU_915_928
-    case LDL_AU_915_928:
-
-        retval = true;
-
-        if(chIndex < 64U){
-
-            *freq = U32(915200000) + ( U32(200000) * U32(chIndex));
-            *minRate = 0U;
-            *maxRate = 5U;
+            (void)memcpy_desc(&upFreq, &desc->upFreq[1], sizeof(upFreq));
+            (void)memcpy_desc(minRate, &desc->upMinRate[1], sizeof(*minRate));
+            (void)memcpy_desc(maxRate, &desc->upMaxRate[1], sizeof(*maxRate));
         }
-        else if(chIndex < 72U){
 
-            *freq = U32(915900000) + ( U32(200000) * (U32(chIndex) - U32(64)));
-            *minRate = 6U;
-            *maxRate = 6U;
-        }
-        else{
+        *freq = upFreq + (UP_SPACING * U32(chIndex - first));
 
-            retval = false;
-        }
-        break;
-#endif
+        retval = true;
     }
 
     return retval;
@@ -390,24 +551,10 @@ bool LDL_Region_getChannel(enum ldl_region region, uint8_t chIndex, uint32_t *fr
 
 uint8_t LDL_Region_numChannels(enum ldl_region region)
 {
+    const struct ldl_region_desc *desc = getRegion(region);
     uint8_t retval;
 
-    switch(region){
-    default:
-        retval = 16U;
-        break;
-#if defined(LDL_ENABLE_US_902_928)  || defined(LDL_ENABLE_AU_915_928)
-#   ifdef LDL_ENABLE_US_902_928
-    case LDL_US_902_928:
-#   endif
-#   ifdef LDL_ENABLE_AU_915_928
-    case LDL_AU_915_928:
-#   endif
-
-        retval = 72U;
-        break;
-#endif
-    }
+    (void)memcpy_desc(&retval, &desc->numChannels, sizeof(retval));
 
     return retval;
 }
@@ -416,37 +563,28 @@ void LDL_Region_getDefaultChannels(enum ldl_region region, struct ldl_mac *mac)
 {
     LDL_PEDANTIC(mac != NULL)
 
+    const struct ldl_region_desc *desc = getRegion(region);
+    const uint32_t *freqs;
+    uint32_t freq;
+    uint8_t numFreqs;
     uint8_t minRate;
     uint8_t maxRate;
+    uint8_t i;
 
-    switch(region){
-    default:
-        /* impossible */
-        break;
-#ifdef LDL_ENABLE_EU_863_870
-    case LDL_EU_863_870:
+    (void)memcpy_desc(&freqs, &desc->defaultFreqs, sizeof(freqs));
+    (void)memcpy_desc(&numFreqs, &desc->numDefaultFreqs, sizeof(numFreqs));
 
-        (void)upRateRange(region, 0U, &minRate, &maxRate);
+    for(i=0U; i < numFreqs; i++){
 
-        (void)LDL_MAC_addChannel(mac, 0U, U32(868100000), minRate, maxRate);
-        (void)LDL_MAC_addChannel(mac, 1U, U32(868300000), minRate, maxRate);
-        (void)LDL_MAC_addChannel(mac, 2U, U32(868500000), minRate, maxRate);
-        break;
-#endif
-#ifdef LDL_ENABLE_EU_433
-    case LDL_EU_433:
+        (void)memcpy_P(&freq, &freqs[i], sizeof(freq));
 
-        (void)upRateRange(region, 0U, &minRate, &maxRate);
+        if(upRateRange(desc, i, &minRate, &maxRate)){
 
-        (void)LDL_MAC_addChannel(mac, 0U, U32(433175000), minRate, maxRate);
-        (void)LDL_MAC_addChannel(mac, 1U, U32(433375000), minRate, maxRate);
-        (void)LDL_MAC_addChannel(mac, 2U, U32(433575000), minRate, maxRate);
-        break;
-#endif
+            (void)LDL_MAC_addChannel(mac, i, freq, minRate, maxRate);
+        }
     }
 }
 
-#if defined(LDL_ENABLE_EU_863_870) || defined(LDL_ENABLE_EU_433)
 static uint8_t unpackCFListFreq(const uint8_t *cfList, uint32_t *freq)
 {
     *freq = cfList[2];
@@ -459,9 +597,7 @@ static uint8_t unpackCFListFreq(const uint8_t *cfList, uint32_t *freq)
 
     return 3U;
 }
-#endif
 
-#if defined(LDL_ENABLE_US_902_928) || defined(LDL_ENABLE_AU_915_928)
 static uint8_t unpackCFListMask(const uint8_t *cfList, uint16_t *mask)
 {
     *mask = cfList[1];
@@ -470,119 +606,80 @@ static uint8_t unpackCFListMask(const uint8_t *cfList, uint16_t *mask)
 
     return 2U;
 }
-#endif
 
 void LDL_Region_processCFList(enum ldl_region region, struct ldl_mac *mac, const uint8_t *cfList, uint8_t cfListLen)
 {
-    if(cfListLen == 16U){
+    const struct ldl_region_desc *desc = getRegion(region);
+    bool dynamic;
 
-        switch(region){
-        default:
-            /* impossible */
-            break;
+    (void)memcpy_desc(&dynamic, &desc->dynamic, sizeof(dynamic));
 
-#if defined(LDL_ENABLE_EU_863_870) || defined(LDL_ENABLE_EU_433)
+    if(cfListLen == 16U){
 
-#   ifdef LDL_ENABLE_EU_863_870
-        case LDL_EU_863_870:
-#   endif
-#   ifdef LDL_ENABLE_EU_433
-        case LDL_EU_433:
-#   endif
-           /* 0 means frequency list */
-           if(cfList[15] == 0U){
+        /* 0 means frequency list */
+        if(dynamic && (cfList[15] == 0U)){
 
-                uint8_t minRate;
-                uint8_t maxRate;
-                uint32_t freq;
-                uint8_t i;
-                uint8_t pos;
+            uint8_t minRate;
+            uint8_t maxRate;
+            uint32_t freq;
+            uint8_t i;
+            uint8_t pos;
 
-                for(i=3U,pos=0U; i < 8U; i++){
+            for(i=3U,pos=0U; i < 8U; i++){
 
-                     pos += unpackCFListFreq(&cfList[pos], &freq);
+                pos += unpackCFListFreq(&cfList[pos], &freq);
 
-                     (void)upRateRange(region, i, &minRate, &maxRate);
+                if(upRateRange(desc, i, &minRate, &maxRate)){
 
-                     (void)LDL_MAC_addChannel(mac, i, freq, minRate, maxRate);
+                    (void)LDL_MAC_addChannel(mac, i, freq, minRate, maxRate);
                 }
             }
-            break;
-#endif
-
-#if defined(LDL_ENABLE_US_902_928) || defined(LDL_ENABLE_AU_915_928)
-
-#   ifdef LDL_ENABLE_US_902_928
-        case LDL_US_902_928:
-#   endif
-#   ifdef LDL_ENABLE_AU_915_928
-        case LDL_AU_915_928:
-#   endif
-            /* 1 means mask list */
-           if(cfList[15] == 1U){
+        }
+        /* 1 means mask list */
+        else if(!dynamic && (cfList[15] == 1U)){
 
-                uint16_t mask;
-                uint8_t i;
-                uint8_t b;
-                uint8_t pos;
+            uint16_t mask;
+            uint8_t i;
+            uint8_t b;
+            uint8_t pos;
 
-                for(i=0U,pos=0U; i < 5U; i++){
+            for(i=0U,pos=0U; i < 5U; i++){
 
-                    pos += unpackCFListMask(&cfList[pos], &mask);
+                pos += unpackCFListMask(&cfList[pos], &mask);
 
-                     for(b=0U; b < 16U; b++){
+                for(b=0U; b < 16U; b++){
 
-                        if((mask & (U16(1) << b)) > 0U){
+                    if((mask & (U16(1) << b)) > 0U){
 
-                            (void)LDL_MAC_unmaskChannel(mac, (i * 16U) + b);
-                        }
-                        else{
+                        (void)LDL_MAC_unmaskChannel(mac, (i * 16U) + b);
+                    }
+                    else{
 
-                            (void)LDL_MAC_maskChannel(mac, (i * 16U) + b);
-                        }
+                        (void)LDL_MAC_maskChannel(mac, (i * 16U) + b);
                     }
                 }
             }
-            break;
-#endif
+        }
+        else{
+
+            /* not applicable */
         }
     }
 }
 
 uint32_t LDL_Region_getOffTimeFactor(enum ldl_region region, uint8_t band)
 {
-    uint32_t retval = 0;
+    const struct ldl_region_desc *desc = getRegion(region);
+    const uint16_t *factors;
+    uint8_t numBands;
+    uint16_t retval = 0U;
 
-    switch(region){
-    default:
-        /* impossible */
-        break;
-#ifdef LDL_ENABLE_EU_863_870
-    case LDL_EU_863_870:
-
-        switch(band){
-        case 0U:
-        case 1U:
-        case 4U:
-            retval = U32(100);      // 1.0%
-            break;
-        case 2U:
-            retval = U32(1000);     // 0.1%
-            break;
-        case 3U:
-            retval = U32(10);       // 10.0%
-            break;
-        default:
-            /* impossible */
-            break;
-        }
-        break;
-#endif
-#ifdef LDL_ENABLE_EU_433
-    case LDL_EU_433:
-        retval = U32(100);
-        break;
-#endif
+    (void)memcpy_desc(&factors, &desc->offTimeFactors, sizeof(factors));
+    (void)memcpy_desc(&numBands, &desc->numBands, sizeof(numBands));
+
+    if(band < numBands){
+
+        (void)memcpy_P(&retval, &factors[band], sizeof(retval));
     }
 
     return retval;
@@ -594,7 +691,7 @@ bool LDL_Region_validateRate(enum ldl_region region, uint8_t chIndex, uint8_t mi
     uint8_t min;
     uint8_t max;
 
-    if(upRateRange(region, chIndex, &min, &max)){
+    if(upRateRange(getRegion(region), chIndex, &min, &max)){
 
         if((minRate >= min) && (maxRate <= max)){
 
@@ -607,7 +704,9 @@ bool LDL_Region_validateRate(enum ldl_region region, uint8_t chIndex, uint8_t mi
 
 bool LDL_Region_validateFreq(enum ldl_region region, uint32_t freq)
 {
-    bool retval;
+    const struct ldl_region_desc *desc = getRegion(region);
+    uint32_t min;
+    uint32_t max;
 
     /* todo: take bw as argument to double check we are actually within bounds
      *
@@ -615,144 +714,56 @@ bool LDL_Region_validateFreq(enum ldl_region region, uint32_t freq)
      *
      * */
 
-    switch(region){
-    default:
-        /* impossible */
-        retval = false;
-        break;
-#ifdef LDL_ENABLE_EU_863_870
-    case LDL_EU_863_870:
-        retval = (freq > U32(863000000)) && (freq < U32(870000000));
-        break;
-#endif
-#ifdef LDL_ENABLE_EU_433
-    case LDL_EU_433:
-        retval = (freq >= U32(433175000)) && (freq <= U32(434665000));
-        break;
-#endif
-#ifdef LDL_ENABLE_US_902_928
-    case LDL_US_902_928:
-        retval = (freq > U32(902000000)) && (freq < U32(928000000));
-        break;
-#endif
-#ifdef LDL_ENABLE_AU_915_928
-    case LDL_AU_915_928:
-        retval = (freq > U32(915000000)) && (freq < U32(928000000));
-        break;
-#endif
-    }
+    (void)memcpy_desc(&min, &desc->minFreq, sizeof(min));
+    (void)memcpy_desc(&max, &desc->maxFreq, sizeof(max));
 
-    return retval;
+    return (freq >= min) && (freq <= max);
 }
 
 void LDL_Region_getRX1DataRate(enum ldl_region region, uint8_t tx_rate, uint8_t rx1_offset, uint8_t *rx1_rate)
 {
     LDL_PEDANTIC(rx1_rate != NULL)
 
-    const uint8_t *ptr = NULL;
-    uint8_t i = 0U;
-    size_t size = 0U;
+    const struct ldl_region_desc *desc = getRegion(region);
+    const uint8_t *rates;
+    uint8_t width;
+    uint8_t size;
+    uint8_t i;
 
-    switch(region){
-    default:
-        /* impossible */
-        break;
-#if defined(LDL_ENABLE_EU_863_870) || defined(LDL_ENABLE_EU_433)
-#   ifdef LDL_ENABLE_EU_863_870
-    case LDL_EU_863_870:
-#   endif
-#   ifdef LDL_ENABLE_EU_433
-    case LDL_EU_433:
-#   endif
-    {
-        static const uint8_t rates[] PROGMEM = {
-            0U, 0U, 0U, 0U, 0U, 0U,
-            1U, 0U, 0U, 0U, 0U, 0U,
-            2U, 1U, 0U, 0U, 0U, 0U,
-            3U, 2U, 1U, 0U, 0U, 0U,
-            4U, 3U, 2U, 1U, 0U, 0U,
-            5U, 4U, 3U, 2U, 1U, 0U,
-            6U, 5U, 4U, 3U, 2U, 1U,
-            7U, 6U, 5U, 4U, 3U, 2U,
-        };
-
-        i = (tx_rate * 6U) + rx1_offset;
-        ptr = rates;
-        size = sizeof(rates);
-    }
-        break;
-#endif
-#ifdef LDL_ENABLE_US_902_928
-    case LDL_US_902_928:
-    {
-        static const uint8_t rates[] PROGMEM = {
-            10U, 9U,  8U,  8U,
-            11U, 10U, 9U,  8U,
-            12U, 11U, 10U, 9U,
-            13U, 12U, 11U, 10U,
-            13U, 13U, 12U, 11U,
-        };
-
-        i = (tx_rate * 4U) + rx1_offset;
-        ptr = rates;
-        size = sizeof(rates);
-    }
-        break;
-#endif
-#ifdef LDL_ENABLE_AU_915_928
-    case LDL_AU_915_928:
-    {
-        static const uint8_t rates[] PROGMEM = {
-            8U,  8U,  8U,  8U,  8U,  8U,
-            9U,  8U,  8U,  8U,  8U,  8U,
-            10U, 9U,  8U,  8U,  8U,  8U,
-            11U, 10U, 9U,  8U,  8U,  8U,
-            12U, 11U, 10U, 9U,  8U,  8U,
-            13U, 12U, 11U, 10U, 9U,  8U,
-            13U, 13U, 12U, 11U, 10U, 9U,
-        };
-
-        i = (tx_rate * 6U) + rx1_offset;
-        ptr = rates;
-        size = sizeof(rates);
-    }
-        break;
-#endif
-    }
+    (void)memcpy_desc(&rates, &desc->rx1Rates, sizeof(rates));
+    (void)memcpy_desc(&width, &desc->rx1RatesWidth, sizeof(width));
+    (void)memcpy_desc(&size, &desc->rx1RatesSize, sizeof(size));
 
-    if(ptr != NULL){
+    i = U8((tx_rate * width) + rx1_offset);
 
-        if(i < size){
+    if(i < size){
 
-            (void)memcpy_P(rx1_rate, &ptr[i], sizeof(*rx1_rate));
-        }
-        else{
+        (void)memcpy_P(rx1_rate, &rates[i], sizeof(*rx1_rate));
+    }
+    else{
 
-            *rx1_rate = tx_rate;
-            LDL_INFO("out of range error")
-        }
+        *rx1_rate = tx_rate;
+        LDL_INFO("out of range error")
     }
 }
 
 void LDL_Region_getRX1Freq(enum ldl_region region, uint32_t txFreq, uint8_t chIndex, uint32_t *freq)
 {
-    (void)chIndex;
+    const struct ldl_region_desc *desc = getRegion(region);
+    uint32_t rx1Freq;
+    bool dynamic;
+
+    (void)memcpy_desc(&dynamic, &desc->dynamic, sizeof(dynamic));
+
+    if(dynamic){
 
-    switch(region){
-    default:
         *freq = txFreq;
-        break;
-#if defined(LDL_ENABLE_US_902_928)  || defined(LDL_ENABLE_AU_915_928)
-#   ifdef LDL_ENABLE_US_902_928
-    case LDL_US_902_928:
-#   endif
-#   ifdef LDL_ENABLE_AU_915_928
-    case LDL_AU_915_928:
-#   endif
-
-        *freq = U32(923300000) + ((U32(chIndex) % U32(8)) * U32(600000));
-        break;
-#endif
+    }
+    else{
+
+        (void)memcpy_desc(&rx1Freq, &desc->rx1Freq, sizeof(rx1Freq));
+
+        *freq = rx1Freq + ((U32(chIndex) % U32(8)) * RX1_SPACING);
     }
 }
 
@@ -779,216 +790,70 @@ uint8_t LDL_Region_getRX1Offset(enum ldl_region region)
 
 uint32_t LDL_Region_getRX2Freq(enum ldl_region region)
 {
+    const struct ldl_region_desc *desc = getRegion(region);
     uint32_t retval;
 
-    switch(region){
-    default:
-#ifdef LDL_ENABLE_EU_863_870
-    case LDL_EU_863_870:
-        retval = U32(869525000);
-        break;
-#endif
-#ifdef LDL_ENABLE_EU_433
-    case LDL_EU_433:
-        retval = U32(434665000);
-        break;
-#endif
-#ifdef LDL_ENABLE_US_902_928
-    case LDL_US_902_928:
-        retval = U32(923300000);
-        break;
-#endif
-#ifdef LDL_ENABLE_AU_915_928
-    case LDL_AU_915_928:
-        retval = U32(923300000);
-        break;
-#endif
-    }
+    (void)memcpy_desc(&retval, &desc->rx2Freq, sizeof(retval));
 
     return retval;
 }
 
 uint8_t LDL_Region_getRX2Rate(enum ldl_region region)
 {
+    const struct ldl_region_desc *desc = getRegion(region);
     uint8_t retval;
 
-    switch(region){
-    default:
-#ifdef LDL_ENABLE_EU_863_870
-    case LDL_EU_863_870:
-        retval = 0;
-        break;
-#endif
-#ifdef LDL_ENABLE_EU_433
-    case LDL_EU_433:
-        retval = 0;
-        break;
-#endif
-#ifdef LDL_ENABLE_US_902_928
-    case LDL_US_902_928:
-        retval = 8;
-        break;
-#endif
-#ifdef LDL_ENABLE_AU_915_928
-    case LDL_AU_915_928:
-        retval = 8;
-        break;
-#endif
-    }
+    (void)memcpy_desc(&retval, &desc->rx2Rate, sizeof(retval));
 
     return retval;
 }
 
 bool LDL_Region_validateTXPower(enum ldl_region region, uint8_t power)
 {
-    bool retval = false;
-
-    switch(region){
-#ifdef LDL_ENABLE_EU_863_870
-    case LDL_EU_863_870:
-
-        if(power <= 7U){
-
-            retval = true;
-        }
-        break;
-#endif
-#ifdef LDL_ENABLE_EU_433
-    case LDL_EU_433:
-
-        if(power <= 5U){
-
-            retval = true;
-        }
-        break;
-#endif
-#if defined(LDL_ENABLE_US_902_928)  || defined(LDL_ENABLE_AU_915_928)
-#   ifdef LDL_ENABLE_US_902_928
-    case LDL_US_902_928:
-#   endif
-#   ifdef LDL_ENABLE_AU_915_928
-    case LDL_AU_915_928:
-#   endif
-
-        if(power <= 10U){
+    const struct ldl_region_desc *desc = getRegion(region);
+    uint8_t maxPower;
 
-            retval = true;
-        }
-        break;
-#endif
-    default:
-        /* impossible */
-        break;
-    }
+    (void)memcpy_desc(&maxPower, &desc->maxPower, sizeof(maxPower));
 
-    return retval;
+    return (power <= maxPower);
 }
 
 int16_t LDL_Region_getTXPower(enum ldl_region region, uint8_t power)
 {
-    int16_t retval = 0;
-
-    switch(region){
-#ifdef LDL_ENABLE_EU_863_870
-    case LDL_EU_863_870:
-
-        if(power <= 7U){
-
-            retval = S16(1600) - (S16(power) * S16(200));
-        }
-        else{
-
-            retval = S16(1600 - (7 * 200));
-        }
-        break;
-#endif
-#ifdef LDL_ENABLE_EU_433
-    case LDL_EU_433:
-
-        if(power <= 5U){
-
-            retval = S16(1215) - (S16(power) * S16(200));
-        }
-        else{
-
-            retval = S16(1215 - (5 * 200));
-        }
-        break;
-#endif
-#if defined(LDL_ENABLE_US_902_928)  || defined(LDL_ENABLE_AU_915_928)
-#   ifdef LDL_ENABLE_US_902_928
-    case LDL_US_902_928:
-#   endif
-#   ifdef LDL_ENABLE_AU_915_928
-    case LDL_AU_915_928:
-#   endif
-
-        if(power <= 10U){
+    const struct ldl_region_desc *desc = getRegion(region);
+    uint8_t maxPower;
+    int16_t maxEIRP;
 
-            retval = S16(3000) - (S16(power) * S16(200));
-        }
-        else{
-
-            retval = S16(3000 - (10 * 200));
-        }
-        break;
-#endif
-    default:
-        /* impossible */
-        break;
-    }
+    (void)memcpy_desc(&maxPower, &desc->maxPower, sizeof(maxPower));
+    (void)memcpy_desc(&maxEIRP, &desc->maxEIRP, sizeof(maxEIRP));
 
-    return retval;
+    /* each step is 2dB down from max EIRP */
+    return maxEIRP - (S16((power <= maxPower) ? power : maxPower) * S16(200));
 }
 
 uint8_t LDL_Region_getJoinRate(enum ldl_region region, uint32_t trial)
 {
-    uint8_t retval = 0;
+    const struct ldl_region_desc *desc = getRegion(region);
+    uint8_t rate;
+    uint8_t cycle;
 
-    (void)trial;
+    (void)memcpy_desc(&rate, &desc->joinRate, sizeof(rate));
+    (void)memcpy_desc(&cycle, &desc->joinRateCycle, sizeof(cycle));
 
-    switch(region){
-#ifdef LDL_ENABLE_EU_863_870
-    case LDL_EU_863_870:
-        retval = U8(5) - U8(trial % U32(6U - U8(MIN_RATE)));
-        break;
-#endif
-#ifdef LDL_ENABLE_EU_433
-    case LDL_EU_433:
-        retval = U8(5) - U8(trial % U32(6U - U8(MIN_RATE)));
-        break;
-#endif
-#ifdef LDL_ENABLE_US_902_928
-    case LDL_US_902_928:
-        retval = MIN_RATE;
-        break;
-#endif
-#ifdef LDL_ENABLE_AU_915_928
-    case LDL_AU_915_928:
-        retval = 2;
-        break;
-#endif
-    default:
-        /* impossible */
-        break;
-    }
-
-    return retval;
+    return rate - U8(trial % U32(cycle));
 }
 
 uint8_t LDL_Region_getJoinIndex(enum ldl_region region, uint32_t trial, uint32_t random)
 {
-    uint8_t retval;
+    const struct ldl_region_desc *desc = getRegion(region);
+    uint8_t retval = 0U;
+    bool dynamic;
 
-    (void)trial;
-    (void)random;
+    (void)memcpy_desc(&dynamic, &desc->dynamic, sizeof(dynamic));
 
-    switch(region){
-    default:
-        retval = 0;
-        break;
-#ifdef LDL_ENABLE_US_902_928
-    case LDL_US_902_928:
+    /* fixed channel plans alternate between a random 125KHz channel
+     * from each sub-band and the 500KHz channels */
+    if(!dynamic){
 
         if((trial & 1U) > 0U){
 
@@ -998,21 +863,6 @@ uint8_t LDL_Region_getJoinIndex(enum ldl_region region, uint32_t trial, uint32_t
 
             retval = U8((((trial >> 1) % U32(8)) * U32(8)) + (random % U32(8)));
         }
-        break;
-#endif
-#ifdef LDL_ENABLE_AU_915_928
-    case LDL_AU_915_928:
-
-        if((trial & 1U) > 0U){
-
-            retval = U8(U32(64) + ((trial >> 1) % U32(8)));
-        }
-        else{
-
-            retval = U8((((trial >> 1) % U32(8)) * U32(8)) + (random % U32(8)));
-        }
-        break;
-#endif
     }
 
     return retval;
@@ -1037,33 +887,10 @@ uint32_t LDL_Region_getMaxDCycleOffLimit(enum ldl_region region)
 #ifndef LDL_TRACE_DISABLED
 const char *LDL_Region_enumToString(enum ldl_region region)
 {
+    const struct ldl_region_desc *desc = getRegion(region);
     const char *retval;
 
-    switch(region){
-    default:
-        retval = "undefined";
-        break;
-#ifdef LDL_ENABLE_EU_863_870
-    case LDL_EU_863_870:
-        retval = "LDL_EU_863_870";
-        break;
-#endif
-#ifdef LDL_ENABLE_EU_433
-    case LDL_EU_433:
-        retval = "LDL_EU_433";
-        break;
-#endif
-#ifdef LDL_ENABLE_US_902_928
-    case LDL_US_902_928:
-        retval = "LDL_US_902_928";
-        break;
-#endif
-#ifdef LDL_ENABLE_AU_915_928
-    case LDL_AU_915_928:
-        retval = "LDL_AU_915_928";
-        break;
-#endif
-    }
+    (void)memcpy_desc(&retval, &desc->name, sizeof(retval));
 
     return retval;
 }
@@ -1071,111 +898,67 @@ const char *LDL_Region_enumToString(enum ldl_region region)
 
 bool LDL_Region_txParamSetupImplemented(enum ldl_region region)
 {
+    const struct ldl_region_desc *desc = getRegion(region);
     bool retval;
 
-    switch(region){
-#ifdef LDL_ENABLE_AU_915_928
-    case LDL_AU_915_928:
-        retval = true;
-        break;
-#endif
-    default:
-        retval = false;
-        break;
-    }
+    (void)memcpy_desc(&retval, &desc->txParamSetup, sizeof(retval));
 
     return retval;
 }
 
 uint8_t LDL_Region_applyUplinkDwell(enum ldl_region region, bool dwell, uint8_t rate)
 {
-    uint8_t retval;
-
-    (void)dwell;
-
-    switch(region){
-#ifdef LDL_ENABLE_AU_915_928
-    case LDL_AU_915_928:
-
-        retval = (dwell && (rate < 2U)) ? 2U : rate;
-        break;
-#endif
-    default:
+    const struct ldl_region_desc *desc = getRegion(region);
+    uint8_t min;
 
-        retval = rate;
-        break;
-    }
+    (void)memcpy_desc(&min, &desc->dwellMinRate, sizeof(min));
 
-    return retval;
+    return (dwell && (rate < min)) ? min : rate;
 }
 
 /* static functions ***************************************************/
 
-static bool upRateRange(enum ldl_region region, uint8_t chIndex, uint8_t *minRate, uint8_t *maxRate)
+static const struct ldl_region_desc *getRegion(enum ldl_region region)
 {
-    bool retval = false;
+#ifdef SINGLE_REGION
+    (void)region;
 
-    switch(region){
-#if defined(LDL_ENABLE_EU_863_870) || defined(LDL_ENABLE_EU_433)
-#   ifdef LDL_ENABLE_EU_863_870
-    case LDL_EU_863_870:
-#   endif
-#   ifdef LDL_ENABLE_EU_433
-    case LDL_EU_433:
-#   endif
+    return &regions[0];
+#else
+    size_t i = (size_t)region;
 
-        if(chIndex < 16U){
+    LDL_PEDANTIC(i < (sizeof(regions)/sizeof(*regions)))
 
-            *minRate = 0U;
-            *maxRate = 5U;
-            retval = true;
-        }
-        break;
+    /* anything not in enum ldl_region gets the first region
+     * rather than reading past the table */
+    return &regions[(i < (sizeof(regions)/sizeof(*regions))) ? i : 0U];
 #endif
-#ifdef LDL_ENABLE_US_902_928
-    case LDL_US_902_928:
-
-        if(chIndex <= 71U){
-
-            if(chIndex <= 63U){
-
-                *minRate = 0U;
-                *maxRate = 3U;
-            }
-            else{
+}
 
-                *minRate = 4U;
-                *maxRate = 4U;
-            }
+static bool upRateRange(const struct ldl_region_desc *desc, uint8_t chIndex, uint8_t *minRate, uint8_t *maxRate)
+{
+    uint8_t numChannels;
+    uint8_t first;
+    bool retval = false;
 
-            retval = true;
-        }
-        break;
-#endif
-#ifdef LDL_ENABLE_AU_915_928
-    case LDL_AU_915_928:
+    (void)memcpy_desc(&numChannels, &desc->numChannels, sizeof(numChannels));
 
-        if(chIndex <= 71U){
+    if(chIndex < numChannels){
 
-            if(chIndex <= 63U){
+        (void)memcpy_desc(&first, &desc->firstWide, sizeof(first));
 
-                *minRate = 0U;
-                *maxRate = 5U;
-            }
-            else{
+        if(chIndex < first){
 
-                *minRate = 6U;
-                *maxRate = 6U;
-            }
+            (void)memcpy_desc(minRate, &desc->upMinRate[0], sizeof(*minRate));
+            (void)memcpy_desc(maxRate, &desc->upMaxRate[0], sizeof(*maxRate));
+        }
+        else{
 
-            retval = true;
+            (void)memcpy_desc(minRate, &desc->upMinRate[1], sizeof(*minRate));
+            (void)memcpy_desc(maxRate, &desc->upMaxRate[1], sizeof(*maxRate));
         }
-        break;
-#endif
-    default:
-        *minRate = 0U;
-        *maxRate = 0U;
-        break;
+
+        retval = true;
     }
 
     return retval;
@@ -1184,3 +967,4 @@ static bool upRateRange(enum ldl_region region, uint8_t chIndex, uint8_t *minRat
 #ifndef LDL_ENABLE_AVR
     #undef memcpy_P
 #endif
+#undef memcpy_desc
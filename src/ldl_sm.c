@@ -29,13 +29,37 @@
 
 #include <string.h>
 
-static void *getKey(struct ldl_sm *self, enum ldl_sm_key desc);
+/* defines ************************************************************/
+
+/* blocks encrypted and MIC'd per pass of secureField() */
+#define FIELD_BLOCKS 4U
+
+/* static function prototypes *****************************************/
+
+static struct ldl_key *getKey(struct ldl_sm *self, enum ldl_sm_key desc);
+static const struct ldl_aes_ctx *getCipher(struct ldl_sm *self, enum ldl_sm_key desc, struct ldl_aes_ctx *buffer);
+static void initMIC(struct ldl_sm *self, enum ldl_sm_key desc, struct ldl_cmac_ctx *ctx, struct ldl_aes_ctx *buffer);
+static void expandKeys(struct ldl_sm *self);
+#ifdef LDL_ENABLE_SM_KEY_CACHE
+static void expandKey(struct ldl_key *key);
+#endif
+static void updateMIC(struct ldl_cmac_ctx *f, struct ldl_cmac_ctx *s, const void *data, uint8_t len);
+static void secureField(const struct ldl_aes_ctx *cipher, const void *iv, uint8_t *data, uint8_t len, struct ldl_cmac_ctx *f, struct ldl_cmac_ctx *s);
+static uint32_t micToInt(const uint8_t *mic);
+static void deriveKey(struct ldl_sm *self, enum ldl_sm_key desc, const struct ldl_aes_ctx *root, uint8_t *iv, uint8_t type);
+static void copyKey(struct ldl_sm *self, enum ldl_sm_key to, enum ldl_sm_key from);
 
 static const struct ldl_sm_interface interface = {
     .update_session_key = LDL_SM_updateSessionKey,
     .mic = LDL_SM_mic,
     .ecb = LDL_SM_ecb,
-    .ctr = LDL_SM_ctr
+    .ctr = LDL_SM_ctr,
+#ifdef LDL_ENABLE_SM_KEY_CACHE
+    .secure_data = LDL_SM_secureData,
+#else
+    .secure_data = NULL,
+#endif
+    .derive_session_keys = LDL_SM_deriveSessionKeys
 };
 
 /* functions **********************************************************/
@@ -49,8 +73,10 @@ void LDL_SM_init(struct ldl_sm *self, const void *appKey)
     if(appKey != NULL){
 
         /* not a mistake, internally we call this LDL_SM_KEY_NWK */
-        (void)memcpy(getKey(self, LDL_SM_KEY_NWK), appKey, LDL_KEY_SIZE);
+        (void)memcpy(getKey(self, LDL_SM_KEY_NWK)->value, appKey, LDL_KEY_SIZE);
     }
+
+    expandKeys(self);
 }
 #endif
 
@@ -62,13 +88,15 @@ void LDL_SM_init(struct ldl_sm *self, const void *appKey, const void *nwkKey)
 
     if(appKey != NULL){
 
-        (void)memcpy(getKey(self, LDL_SM_KEY_APP), appKey, LDL_KEY_SIZE);
+        (void)memcpy(getKey(self, LDL_SM_KEY_APP)->value, appKey, LDL_KEY_SIZE);
     }
 
     if(nwkKey != NULL){
 
-        (void)memcpy(getKey(self, LDL_SM_KEY_NWK), nwkKey, LDL_KEY_SIZE);
+        (void)memcpy(getKey(self, LDL_SM_KEY_NWK)->value, nwkKey, LDL_KEY_SIZE);
     }
+
+    expandKeys(self);
 }
 #endif
 
@@ -79,7 +107,8 @@ const struct ldl_sm_interface *LDL_SM_getInterface(void)
 
 void LDL_SM_updateSessionKey(struct ldl_sm *self, enum ldl_sm_key keyDesc, enum ldl_sm_key rootDesc, const void *iv)
 {
-    struct ldl_aes_ctx ctx;
+    struct ldl_aes_ctx buffer;
+    struct ldl_key *key;
 
     switch(keyDesc){
     case LDL_SM_KEY_FNWKSINT:
@@ -89,11 +118,15 @@ void LDL_SM_updateSessionKey(struct ldl_sm *self, enum ldl_sm_key keyDesc, enum
     case LDL_SM_KEY_JSINT:
     case LDL_SM_KEY_JSENC:
 
-        LDL_AES_init(&ctx, getKey(self, rootDesc));
+        key = getKey(self, keyDesc);
+
+        (void)memcpy(key->value, iv, LDL_KEY_SIZE);
 
-        (void)memcpy(getKey(self, keyDesc), iv, LDL_KEY_SIZE);
+        LDL_AES_encrypt(getCipher(self, rootDesc, &buffer), key->value);
 
-        LDL_AES_encrypt(&ctx, getKey(self, keyDesc));
+#ifdef LDL_ENABLE_SM_KEY_CACHE
+        expandKey(key);
+#endif
         break;
 
     default:
@@ -102,19 +135,185 @@ void LDL_SM_updateSessionKey(struct ldl_sm *self, enum ldl_sm_key keyDesc, enum
     }
 }
 
+void LDL_SM_deriveSessionKeys(struct ldl_sm *self, const struct ldl_sm_join_param *param)
+{
+    struct ldl_aes_ctx nwkBuffer;
+    const struct ldl_aes_ctx *nwk;
+    uint8_t iv[LDL_KEY_SIZE];
+    uint8_t pos;
+
+    (void)memset(iv, 0, sizeof(iv));
+
+    /* iv[0] is the key type and is set by deriveKey() */
+    pos = 1U;
+    pos += LDL_OPS_putU24(&iv[pos], param->joinNonce);
+
+    nwk = getCipher(self, LDL_SM_KEY_NWK, &nwkBuffer);
+
+#if defined(LDL_ENABLE_L2_1_1)
+    if(param->version > 0U){
+
+        struct ldl_aes_ctx appBuffer;
+        uint8_t i;
+
+        for(i=0U; i < 8U; i++){
+
+            iv[pos + i] = param->joinEUI[7U - i];
+        }
+
+        pos += 8U;
+        (void)LDL_OPS_putU16(&iv[pos], param->devNonce);
+
+        deriveKey(self, LDL_SM_KEY_FNWKSINT, nwk, iv, 1U);
+        deriveKey(self, LDL_SM_KEY_APPS, getCipher(self, LDL_SM_KEY_APP, &appBuffer), iv, 2U);
+        deriveKey(self, LDL_SM_KEY_SNWKSINT, nwk, iv, 3U);
+        deriveKey(self, LDL_SM_KEY_NWKSENC, nwk, iv, 4U);
+    }
+    else
+#endif
+    {
+        pos += LDL_OPS_putU24(&iv[pos], param->netID);
+        (void)LDL_OPS_putU16(&iv[pos], param->devNonce);
+
+        deriveKey(self, LDL_SM_KEY_APPS, nwk, iv, 2U);
+        deriveKey(self, LDL_SM_KEY_FNWKSINT, nwk, iv, 1U);
+
+        /* 1.0.x uses the same key for all three */
+        copyKey(self, LDL_SM_KEY_SNWKSINT, LDL_SM_KEY_FNWKSINT);
+        copyKey(self, LDL_SM_KEY_NWKSENC, LDL_SM_KEY_FNWKSINT);
+    }
+}
+
 uint32_t LDL_SM_mic(struct ldl_sm *self, enum ldl_sm_key desc, const void *hdr, uint8_t hdrLen, const void *data, uint8_t dataLen)
 {
     uint32_t retval;
     uint8_t mic[sizeof(retval)];
-    struct ldl_aes_ctx aes_ctx;
+    struct ldl_aes_ctx buffer;
     struct ldl_cmac_ctx ctx;
 
-    LDL_AES_init(&aes_ctx, getKey(self, desc));
-    LDL_CMAC_init(&ctx, &aes_ctx);
+    initMIC(self, desc, &ctx, &buffer);
     LDL_CMAC_update(&ctx, hdr, hdrLen);
     LDL_CMAC_update(&ctx, data, dataLen);
     LDL_CMAC_finish(&ctx, &mic, U8(sizeof(mic)));
 
+    retval = micToInt(mic);
+
+    return retval;
+}
+
+void LDL_SM_ecb(struct ldl_sm *self, enum ldl_sm_key desc, void *b)
+{
+    struct ldl_aes_ctx buffer;
+
+    LDL_AES_encrypt(getCipher(self, desc, &buffer), b);
+}
+
+void LDL_SM_ctr(struct ldl_sm *self, enum ldl_sm_key desc, const void *iv, void *data, uint8_t len)
+{
+    struct ldl_aes_ctx buffer;
+
+    LDL_CTR_encrypt(getCipher(self, desc, &buffer), iv, data, data, len);
+}
+
+void LDL_SM_secureData(struct ldl_sm *self, const struct ldl_sm_data_frame *frame, uint32_t *micF, uint32_t *micS)
+{
+    struct ldl_aes_ctx bufferF;
+    struct ldl_aes_ctx bufferS;
+    struct ldl_aes_ctx buffer;
+    struct ldl_cmac_ctx ctxF;
+    struct ldl_cmac_ctx ctxS;
+    struct ldl_cmac_ctx *s = NULL;
+    uint8_t mic[sizeof(*micF)];
+    uint8_t pos;
+
+    LDL_PEDANTIC((frame->optsLen == 0U) || ((frame->optsOffset + frame->optsLen) <= frame->dataOffset))
+    LDL_PEDANTIC((frame->dataOffset + frame->dataLen) <= frame->len)
+
+    initMIC(self, LDL_SM_KEY_FNWKSINT, &ctxF, &bufferF);
+    LDL_CMAC_update(&ctxF, frame->b0, 16U);
+
+    if(frame->b1 != NULL){
+
+        s = &ctxS;
+
+        initMIC(self, LDL_SM_KEY_SNWKSINT, s, &bufferS);
+        LDL_CMAC_update(s, frame->b1, 16U);
+    }
+
+    pos = 0U;
+
+    if(frame->optsLen > 0U){
+
+        updateMIC(&ctxF, s, frame->msg, frame->optsOffset);
+
+        secureField(getCipher(self, frame->optsKey, &buffer), frame->optsIV, &frame->msg[frame->optsOffset], frame->optsLen, &ctxF, s);
+
+        pos = frame->optsOffset + frame->optsLen;
+    }
+
+    updateMIC(&ctxF, s, &frame->msg[pos], frame->dataOffset - pos);
+
+    if(frame->dataLen > 0U){
+
+        secureField(getCipher(self, frame->dataKey, &buffer), frame->dataIV, &frame->msg[frame->dataOffset], frame->dataLen, &ctxF, s);
+    }
+
+    pos = frame->dataOffset + frame->dataLen;
+
+    updateMIC(&ctxF, s, &frame->msg[pos], frame->len - pos);
+
+    LDL_CMAC_finish(&ctxF, &mic, U8(sizeof(mic)));
+
+    *micF = micToInt(mic);
+
+    if(s != NULL){
+
+        LDL_CMAC_finish(s, &mic, U8(sizeof(mic)));
+
+        *micS = micToInt(mic);
+    }
+}
+
+/* static functions ***************************************************/
+
+static void updateMIC(struct ldl_cmac_ctx *f, struct ldl_cmac_ctx *s, const void *data, uint8_t len)
+{
+    LDL_CMAC_update(f, data, len);
+
+    if(s != NULL){
+
+        LDL_CMAC_update(s, data, len);
+    }
+}
+
+static void secureField(const struct ldl_aes_ctx *cipher, const void *iv, uint8_t *data, uint8_t len, struct ldl_cmac_ctx *f, struct ldl_cmac_ctx *s)
+{
+    /* a few blocks at a time so that the CTR batch is kept and the
+     * ciphertext is still in cache when it reaches the CMAC */
+    uint8_t a[16U];
+    uint8_t pos;
+    uint8_t size;
+
+    (void)memcpy(a, iv, sizeof(a));
+
+    for(pos=0U; pos < len; pos += size){
+
+        size = U8(len - pos);
+        size = (size > U8(FIELD_BLOCKS * sizeof(a))) ? U8(FIELD_BLOCKS * sizeof(a)) : size;
+
+        LDL_CTR_encrypt(cipher, a, &data[pos], &data[pos], size);
+
+        updateMIC(f, s, &data[pos], size);
+
+        /* counter for the next pass */
+        a[15] += FIELD_BLOCKS;
+    }
+}
+
+static uint32_t micToInt(const uint8_t *mic)
+{
+    uint32_t retval;
+
     /* intepret the 4th byte as most significant */
     retval = mic[3];
     retval <<= 8;
@@ -128,25 +327,35 @@ uint32_t LDL_SM_mic(struct ldl_sm *self, enum ldl_sm_key desc, const void *hdr,
     return retval;
 }
 
-void LDL_SM_ecb(struct ldl_sm *self, enum ldl_sm_key desc, void *b)
+static void deriveKey(struct ldl_sm *self, enum ldl_sm_key desc, const struct ldl_aes_ctx *root, uint8_t *iv, uint8_t type)
 {
-    struct ldl_aes_ctx ctx;
+    struct ldl_key *key = getKey(self, desc);
+
+    iv[0] = type;
+
+    (void)memcpy(key->value, iv, LDL_KEY_SIZE);
 
-    LDL_AES_init(&ctx, getKey(self, desc));
-    LDL_AES_encrypt(&ctx, b);
+    LDL_AES_encrypt(root, key->value);
+
+#ifdef LDL_ENABLE_SM_KEY_CACHE
+    expandKey(key);
+#endif
 }
 
-void LDL_SM_ctr(struct ldl_sm *self, enum ldl_sm_key desc, const void *iv, void *data, uint8_t len)
+static void copyKey(struct ldl_sm *self, enum ldl_sm_key to, enum ldl_sm_key from)
 {
-    struct ldl_aes_ctx ctx;
+    struct ldl_key *dst = getKey(self, to);
+    const struct ldl_key *src = getKey(self, from);
 
-    LDL_AES_init(&ctx, getKey(self, desc));
-    LDL_CTR_encrypt(&ctx, iv, data, data, len);
-}
+    /* keys share a slot when only 1.0.x is enabled */
+    if(dst != src){
 
-/* static functions ***************************************************/
+        /* includes the expanded key if cached */
+        (void)memcpy(dst, src, sizeof(*dst));
+    }
+}
 
-static void *getKey(struct ldl_sm *self, enum ldl_sm_key desc)
+static struct ldl_key *getKey(struct ldl_sm *self, enum ldl_sm_key desc)
 {
     size_t i = (size_t)desc;
 
@@ -173,5 +382,55 @@ static void *getKey(struct ldl_sm *self, enum ldl_sm_key desc)
 
     LDL_PEDANTIC(i < sizeof(self->keys)/sizeof(*self->keys))
 
-    return self->keys[i].value;
+    return &self->keys[i];
+}
+
+static const struct ldl_aes_ctx *getCipher(struct ldl_sm *self, enum ldl_sm_key desc, struct ldl_aes_ctx *buffer)
+{
+#ifdef LDL_ENABLE_SM_KEY_CACHE
+    (void)buffer;
+
+    return &getKey(self, desc)->ctx;
+#else
+    LDL_AES_init(buffer, getKey(self, desc)->value);
+
+    return buffer;
+#endif
+}
+
+static void initMIC(struct ldl_sm *self, enum ldl_sm_key desc, struct ldl_cmac_ctx *ctx, struct ldl_aes_ctx *buffer)
+{
+#ifdef LDL_ENABLE_SM_KEY_CACHE
+    const struct ldl_key *key = getKey(self, desc);
+
+    (void)buffer;
+
+    LDL_CMAC_initWithSubkeys(ctx, &key->ctx, &key->subkeys);
+#else
+    LDL_CMAC_init(ctx, getCipher(self, desc, buffer));
+#endif
 }
+
+static void expandKeys(struct ldl_sm *self)
+{
+#ifdef LDL_ENABLE_SM_KEY_CACHE
+    size_t i;
+
+    /* every slot is expanded (including those still zeroed) so that
+     * the result is the same as without the cache */
+    for(i=0U; i < (sizeof(self->keys)/sizeof(*self->keys)); i++){
+
+        expandKey(&self->keys[i]);
+    }
+#else
+    (void)self;
+#endif
+}
+
+#ifdef LDL_ENABLE_SM_KEY_CACHE
+static void expandKey(struct ldl_key *key)
+{
+    LDL_AES_init(&key->ctx, key->value);
+    LDL_CMAC_subkeys(&key->subkeys, &key->ctx);
+}
+#endif
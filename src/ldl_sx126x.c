@@ -97,6 +97,16 @@
 #define REG_XTA_TRIM            0x0911
 #define REG_XTB_TRIM            0x0912
 
+/* bits in state.sx126x.shadow.valid */
+#define SHADOW_PACKET_TYPE          0x01U
+#define SHADOW_BUFFER_BASE_ADDRESS  0x02U
+#define SHADOW_RF_FREQUENCY         0x04U
+#define SHADOW_MODULATION_PARAMS    0x08U
+#define SHADOW_PACKET_PARAMS        0x10U
+#define SHADOW_DIO_IRQ_PARAMS       0x20U
+#define SHADOW_SYNC_WORD            0x40U
+#define SHADOW_SYMB_NUM_TIMEOUT     0x80U
+
 enum ldl_radio_sx126x_packet_type {
 
     PACKET_TYPE_GFSK,
@@ -284,6 +294,10 @@ static bool SetPaConfig(struct ldl_radio *self, uint8_t paDutyCycle, uint8_t hpM
 
 static bool SetSyncWord(struct ldl_radio *self, uint16_t value);
 
+static bool writeShadowed(struct ldl_radio *self, uint8_t flag, uint8_t *shadow, const uint8_t *opcode, size_t size);
+static bool prepareTransmit(struct ldl_radio *self, const struct ldl_radio_tx_setting *settings, const void *data, uint8_t len);
+static void beginTransfers(struct ldl_radio *self);
+
 static const struct ldl_radio_interface interface = {
 
     .set_mode = LDL_SX126X_setMode,
@@ -292,7 +306,9 @@ static const struct ldl_radio_interface interface = {
     .transmit = LDL_SX126X_transmit,
     .receive = LDL_SX126X_receive,
     .receive_entropy = LDL_SX126X_receiveEntropy,
-    .get_status = LDL_SX126X_getStatus
+    .get_status = LDL_SX126X_getStatus,
+    .prepare_transmit = LDL_SX126X_prepareTransmit,
+    .start_transmit = LDL_SX126X_startTransmit
 };
 
 /* functions **********************************************************/
@@ -357,6 +373,8 @@ void LDL_SX126X_setMode(struct ldl_radio *self, enum ldl_radio_mode mode)
         }
 #endif
         self->chip_set_mode(self->chip, LDL_CHIP_MODE_RESET);
+
+        self->state.sx126x.shadow.valid = 0U;
     }
         break;
 
@@ -392,7 +410,11 @@ void LDL_SX126X_setMode(struct ldl_radio *self, enum ldl_radio_mode mode)
         case LDL_RADIO_MODE_HOLD:
 
             (void)ClearIrqStatus(self, UINT16_MAX);
+#ifdef LDL_ENABLE_SX126X_WARM_SLEEP
+            (void)SetSleep(self, SLEEP_MODE_WARM);
+#else
             (void)SetSleep(self, SLEEP_MODE_COLD);
+#endif
             self->chip_set_mode(self->chip, LDL_CHIP_MODE_SLEEP);
             break;
 
@@ -488,6 +510,7 @@ void LDL_SX126X_setMode(struct ldl_radio *self, enum ldl_radio_mode mode)
     LDL_TRACE("new_mode=%i cur_mode=%i", mode, self->mode)
 
     self->mode = mode;
+    self->tx_ready = false;
 }
 
 void LDL_SX126X_transmit(struct ldl_radio *self, const struct ldl_radio_tx_setting *settings, const void *data, uint8_t len)
@@ -497,75 +520,59 @@ void LDL_SX126X_transmit(struct ldl_radio *self, const struct ldl_radio_tx_setti
 
     bool ok;
 
-    /* note this is dbm x 100 */
-    int16_t dbm = settings->eirp - self->tx_gain;
-
-    do{
+    beginTransfers(self);
 
-        ok = SetPacketType(self, PACKET_TYPE_LORA);
-        if(!ok){ break; }
+    ok = prepareTransmit(self, settings, data, len);
 
-        if(self->state.sx126x.image_calibration_pending){
+    if(ok){
 
-            ok = CalibrateImage(self, settings->freq);
-            if(!ok){ break; }
+        ok = SetTx(self, 0);
+    }
 
-            self->state.sx126x.image_calibration_pending = false;
-        }
+    LDL_Radio_endTransfers(self);
 
-        /* set power up here so that IO has time to settle */
-        ok = SetPower(self, dbm);
-        if(!ok){ break; }
+    if(!ok){
 
-        ok = SetBufferBaseAddress(self, 0, 0);
-        if(!ok){ break; }
+        LDL_DEBUG("chip was busy")
+    }
+}
 
-        ok = SetRfFrequency(self, settings->freq);
-        if(!ok){ break; }
+void LDL_SX126X_prepareTransmit(struct ldl_radio *self, const struct ldl_radio_tx_setting *settings, const void *data, uint8_t len)
+{
+    LDL_PEDANTIC(self != NULL)
+    LDL_PEDANTIC((self->type == LDL_RADIO_SX1261) || (self->type == LDL_RADIO_SX1262) || (self->type == LDL_RADIO_WL55))
 
-        ok = WriteBuffer(self, 0U, data, len);
-        if(!ok){ break; }
+    beginTransfers(self);
 
-        {
-            struct _modulation_params arg;
+    self->tx_ready = prepareTransmit(self, settings, data, len);
 
-            arg.sf = settings->sf;
-            arg.bw = settings->bw;
-            arg.cr = LDL_CR_5;
-            arg.LowDataRateOptimize = ((arg.bw == LDL_BW_125) && ((arg.sf == LDL_SF_11) || (arg.sf == LDL_SF_12))) ? true : false;
+    LDL_Radio_endTransfers(self);
 
-            ok = SetModulationParams(self, &arg);
-            if(!ok){ break; }
-        }
+    if(!self->tx_ready){
 
-        {
-            struct _packet_params arg;
-
-            arg.preamble_length = 8U;
-            arg.fixed_length_header = false;
-            arg.payload_length = len;
-            arg.crc_on = true;
-            arg.invert_iq = false;
-
-            ok = SetPacketParams(self, &arg);
-            if(!ok){ break; }
-        }
+        LDL_DEBUG("chip was busy")
+    }
+}
 
-        /* TxDone on DIO1 */
-        ok = SetDioIrqParams(self, 1, 1, 0, 0);
-        if(!ok){ break; }
+void LDL_SX126X_startTransmit(struct ldl_radio *self)
+{
+    LDL_PEDANTIC(self != NULL)
+    LDL_PEDANTIC((self->type == LDL_RADIO_SX1261) || (self->type == LDL_RADIO_SX1262) || (self->type == LDL_RADIO_WL55))
 
-        ok = SetSyncWord(self, 0x3444);
-        if(!ok){ break; }
+    if(!self->tx_ready){
 
-        ok = SetTx(self, 0);
+        LDL_DEBUG("nothing to transmit")
     }
-    while(false);
-
-    if(!ok){
+    else if(!SetTx(self, 0)){
 
         LDL_DEBUG("chip was busy")
     }
+    else{
+
+        /* nothing */
+    }
+
+    self->tx_ready = false;
 }
 
 void LDL_SX126X_receive(struct ldl_radio *self, const struct ldl_radio_rx_setting *settings)
@@ -576,6 +583,8 @@ void LDL_SX126X_receive(struct ldl_radio *self, const struct ldl_radio_rx_settin
     bool ok;
     uint8_t timeout = (settings->timeout > U16(UINT8_MAX)) ? U8(UINT8_MAX) : U8(settings->timeout);
 
+    beginTransfers(self);
+
     do{
 
         self->chip_set_mode(self->chip, LDL_CHIP_MODE_RX);
@@ -638,6 +647,8 @@ void LDL_SX126X_receive(struct ldl_radio *self, const struct ldl_radio_rx_settin
     }
     while(false);
 
+    LDL_Radio_endTransfers(self);
+
     if(!ok){
 
         LDL_ERROR("chip was busy")
@@ -684,6 +695,8 @@ void LDL_SX126X_receiveEntropy(struct ldl_radio *self)
 
     self->chip_set_mode(self->chip, LDL_CHIP_MODE_RX);
 
+    beginTransfers(self);
+
     do{
 
         ok = SetPacketType(self, PACKET_TYPE_LORA);
@@ -696,6 +709,8 @@ void LDL_SX126X_receiveEntropy(struct ldl_radio *self)
     }
     while(false);
 
+    LDL_Radio_endTransfers(self);
+
     if(!ok){
 
         LDL_ERROR("chip was busy")
@@ -715,7 +730,7 @@ uint32_t LDL_SX126X_readEntropy(struct ldl_radio *self)
         0
     };
 
-    (void)self->chip_read(self->chip, opcode, sizeof(opcode), &retval, sizeof(retval));
+    (void)LDL_Radio_read(self, opcode, sizeof(opcode), &retval, sizeof(retval));
 
     return retval;
 }
@@ -758,6 +773,9 @@ static void init_state(struct ldl_radio *self, enum ldl_radio_type type, const s
     self->chip_read = arg->chip_read;
     self->chip_write = arg->chip_write;
     self->chip_set_mode = arg->chip_set_mode;
+#ifdef LDL_ENABLE_CHIP_ASYNC
+    self->chip_submit = arg->chip_submit;
+#endif
 
     self->tx_gain = arg->tx_gain;
     self->xtal = arg->xtal;
@@ -910,7 +928,13 @@ static bool SetSleep(struct ldl_radio *self, enum _sleep_mode mode)
         (mode == SLEEP_MODE_WARM) ? 4U : 0U
     };
 
-    return self->chip_write(self->chip, opcode, sizeof(opcode), NULL, 0U);
+    /* configuration is only retained by a warm start */
+    if(mode == SLEEP_MODE_COLD){
+
+        self->state.sx126x.shadow.valid = 0U;
+    }
+
+    return LDL_Radio_write(self, opcode, sizeof(opcode), NULL, 0U, true);
 }
 
 static bool SetStandby(struct ldl_radio *self, enum _standby_config value)
@@ -920,7 +944,7 @@ static bool SetStandby(struct ldl_radio *self, enum _standby_config value)
         U8(value)
     };
 
-    return self->chip_write(self->chip, opcode, sizeof(opcode), NULL, 0U);
+    return LDL_Radio_write(self, opcode, sizeof(opcode), NULL, 0U, true);
 }
 
 static bool SetTx(struct ldl_radio *self, uint32_t timeout)
@@ -932,7 +956,7 @@ static bool SetTx(struct ldl_radio *self, uint32_t timeout)
         U8(timeout)
     };
 
-    return self->chip_write(self->chip, opcode, sizeof(opcode), NULL, 0U);
+    return LDL_Radio_write(self, opcode, sizeof(opcode), NULL, 0U, true);
 }
 
 static bool SetRx(struct ldl_radio *self, uint32_t timeout)
@@ -944,7 +968,7 @@ static bool SetRx(struct ldl_radio *self, uint32_t timeout)
         U8(timeout)
     };
 
-    return self->chip_write(self->chip, opcode, sizeof(opcode), NULL, 0U);
+    return LDL_Radio_write(self, opcode, sizeof(opcode), NULL, 0U, true);
 }
 
 #if 0
@@ -954,7 +978,7 @@ static bool SetFs(struct ldl_radio *self)
         OPCODE_SET_FS
     };
 
-    return self->chip_write(self->chip, opcode, sizeof(opcode), NULL, 0U);
+    return LDL_Radio_write(self, opcode, sizeof(opcode), NULL, 0U, true);
 }
 
 static bool StopTimerOnPreamble(struct ldl_radio *self, bool enable)
@@ -964,7 +988,7 @@ static bool StopTimerOnPreamble(struct ldl_radio *self, bool enable)
         enable ? 1U : 0U
     };
 
-    return self->chip_write(self->chip, opcode, sizeof(opcode), NULL, 0U);
+    return LDL_Radio_write(self, opcode, sizeof(opcode), NULL, 0U, true);
 }
 
 static bool SetCAD(struct ldl_radio *self)
@@ -973,7 +997,7 @@ static bool SetCAD(struct ldl_radio *self)
         OPCODE_SET_CAD
     };
 
-    return self->chip_write(self->chip, opcode, sizeof(opcode), NULL, 0U);
+    return LDL_Radio_write(self, opcode, sizeof(opcode), NULL, 0U, true);
 }
 
 static bool SetTxInfinitePreamble(struct ldl_radio *self)
@@ -982,7 +1006,7 @@ static bool SetTxInfinitePreamble(struct ldl_radio *self)
         OPCODE_SET_TX_INFINITE_PREAMBLE
     };
 
-    return self->chip_write(self->chip, opcode, sizeof(opcode), NULL, 0U);
+    return LDL_Radio_write(self, opcode, sizeof(opcode), NULL, 0U, true);
 }
 
 static bool GetRssiInst(struct ldl_radio *self, uint32_t *rssi)
@@ -996,7 +1020,7 @@ static bool GetRssiInst(struct ldl_radio *self, uint32_t *rssi)
 
     uint8_t buffer[2];
 
-    if(self->chip_read(self->chip, opcode, sizeof(opcode), buffer, sizeof(buffer))){
+    if(LDL_Radio_read(self, opcode, sizeof(opcode), buffer, sizeof(buffer))){
 
         *rssi = buffer[0];
         *rssi <<= 8;
@@ -1014,7 +1038,7 @@ static bool SetTxContinuousWave(struct ldl_radio *self)
         OPCODE_SET_TX_CONTINUOUS_WAVE
     };
 
-    return self->chip_write(self->chip, opcode, sizeof(opcode), NULL, 0U);
+    return LDL_Radio_write(self, opcode, sizeof(opcode), NULL, 0U, true);
 }
 
 static bool SetRxTxFallbackMode(struct ldl_radio *self, enum _rx_tx_fallback_mode value)
@@ -1030,7 +1054,7 @@ static bool SetRxTxFallbackMode(struct ldl_radio *self, enum _rx_tx_fallback_mod
         mode[value]
     };
 
-    return self->chip_write(self->chip, opcode, sizeof(opcode), NULL, 0U);
+    return LDL_Radio_write(self, opcode, sizeof(opcode), NULL, 0U, true);
 }
 
 static bool GetPacketType(struct ldl_radio *self, enum ldl_radio_sx126x_packet_type *type)
@@ -1044,7 +1068,7 @@ static bool GetPacketType(struct ldl_radio *self, enum ldl_radio_sx126x_packet_t
         0
     };
 
-    if(self->chip_read(self->chip, opcode, sizeof(opcode), buffer, sizeof(buffer))){
+    if(LDL_Radio_read(self, opcode, sizeof(opcode), buffer, sizeof(buffer))){
 
         retval = true;
 
@@ -1071,7 +1095,7 @@ static bool SetRegulatorMode(struct ldl_radio *self, enum ldl_sx126x_regulator v
         U8(value)
     };
 
-    return self->chip_write(self->chip, opcode, sizeof(opcode), NULL, 0U);
+    return LDL_Radio_write(self, opcode, sizeof(opcode), NULL, 0U, true);
 }
 
 static bool Calibrate(struct ldl_radio *self, uint8_t param)
@@ -1081,7 +1105,7 @@ static bool Calibrate(struct ldl_radio *self, uint8_t param)
         param & 0x7fU
     };
 
-    return self->chip_write(self->chip, opcode, sizeof(opcode), NULL, 0U);
+    return LDL_Radio_write(self, opcode, sizeof(opcode), NULL, 0U, true);
 }
 
 static bool CalibrateImage(struct ldl_radio *self, uint32_t freq)
@@ -1122,7 +1146,7 @@ static bool CalibrateImage(struct ldl_radio *self, uint32_t freq)
         f2
     };
 
-    return self->chip_write(self->chip, opcode, sizeof(opcode), NULL, 0U);
+    return LDL_Radio_write(self, opcode, sizeof(opcode), NULL, 0U, true);
 }
 
 static bool SetPaConfig(struct ldl_radio *self, uint8_t paDutyCycle, uint8_t hpMax, uint8_t pa)
@@ -1135,7 +1159,7 @@ static bool SetPaConfig(struct ldl_radio *self, uint8_t paDutyCycle, uint8_t hpM
         1
     };
 
-    return self->chip_write(self->chip, opcode, sizeof(opcode), NULL, 0U);
+    return LDL_Radio_write(self, opcode, sizeof(opcode), NULL, 0U, true);
 }
 
 static bool SetDioIrqParams(struct ldl_radio *self, uint16_t irq, uint16_t dio1, uint16_t dio2, uint16_t dio3)
@@ -1152,7 +1176,7 @@ static bool SetDioIrqParams(struct ldl_radio *self, uint16_t irq, uint16_t dio1,
         U8(dio3)
     };
 
-    return self->chip_write(self->chip, opcode, sizeof(opcode), NULL, 0U);
+    return writeShadowed(self, SHADOW_DIO_IRQ_PARAMS, self->state.sx126x.shadow.dio_irq_params, opcode, sizeof(opcode));
 }
 
 static bool GetIrqStatus(struct ldl_radio *self, uint16_t *irq)
@@ -1166,7 +1190,7 @@ static bool GetIrqStatus(struct ldl_radio *self, uint16_t *irq)
 
     uint8_t buffer[2];
 
-    if(self->chip_read(self->chip, opcode, sizeof(opcode), buffer, sizeof(buffer))){
+    if(LDL_Radio_read(self, opcode, sizeof(opcode), buffer, sizeof(buffer))){
 
         *irq = buffer[0];
         *irq <<= 8;
@@ -1186,7 +1210,7 @@ static bool ClearIrqStatus(struct ldl_radio *self, uint16_t irq)
         U8(irq)
     };
 
-    return self->chip_write(self->chip, opcode, sizeof(opcode), NULL, 0U);
+    return LDL_Radio_write(self, opcode, sizeof(opcode), NULL, 0U, true);
 }
 
 #if defined(LDL_ENABLE_SX1261) || defined(LDL_ENABLE_SX1262)
@@ -1197,7 +1221,7 @@ static bool SetDIO2AsRfSwitchCtrl(struct ldl_radio *self, enum ldl_sx126x_txen s
         U8(setting)
     };
 
-    return self->chip_write(self->chip, opcode, sizeof(opcode), NULL, 0U);
+    return LDL_Radio_write(self, opcode, sizeof(opcode), NULL, 0U, true);
 }
 #endif
 
@@ -1214,7 +1238,7 @@ static bool SetDIO3AsTcxoCtrl(struct ldl_radio *self, enum ldl_sx126x_voltage se
         U8(ticks)
     };
 
-    return self->chip_write(self->chip, opcode, sizeof(opcode), NULL, 0U);
+    return LDL_Radio_write(self, opcode, sizeof(opcode), NULL, 0U, true);
 }
 
 static bool SetRfFrequency(struct ldl_radio *self, uint32_t freq)
@@ -1229,7 +1253,7 @@ static bool SetRfFrequency(struct ldl_radio *self, uint32_t freq)
         U8(f)
     };
 
-    return self->chip_write(self->chip, opcode, sizeof(opcode), NULL, 0U);
+    return writeShadowed(self, SHADOW_RF_FREQUENCY, self->state.sx126x.shadow.rf_frequency, opcode, sizeof(opcode));
 }
 
 static bool SetPacketType(struct ldl_radio *self, enum ldl_radio_sx126x_packet_type type)
@@ -1239,7 +1263,13 @@ static bool SetPacketType(struct ldl_radio *self, enum ldl_radio_sx126x_packet_t
         U8(type)
     };
 
-    return self->chip_write(self->chip, opcode, sizeof(opcode), NULL, 0U);
+    /* modulation and packet parameters must follow a new packet type */
+    if(((self->state.sx126x.shadow.valid & SHADOW_PACKET_TYPE) == 0U) || (self->state.sx126x.shadow.packet_type[0] != opcode[1])){
+
+        self->state.sx126x.shadow.valid &= U8(~(SHADOW_MODULATION_PARAMS | SHADOW_PACKET_PARAMS));
+    }
+
+    return writeShadowed(self, SHADOW_PACKET_TYPE, self->state.sx126x.shadow.packet_type, opcode, sizeof(opcode));
 }
 
 static bool SetTxParams(struct ldl_radio *self, int8_t power, enum _ramp_time ramp_time)
@@ -1250,7 +1280,7 @@ static bool SetTxParams(struct ldl_radio *self, int8_t power, enum _ramp_time ra
         U8(ramp_time)
     };
 
-    return self->chip_write(self->chip, opcode, sizeof(opcode), NULL, 0U);
+    return LDL_Radio_write(self, opcode, sizeof(opcode), NULL, 0U, true);
 }
 
 static bool SetModulationParams(struct ldl_radio *self, const struct _modulation_params *value)
@@ -1269,7 +1299,7 @@ static bool SetModulationParams(struct ldl_radio *self, const struct _modulation
         value->LowDataRateOptimize ? 1U : 0U
     };
 
-    return self->chip_write(self->chip, opcode, sizeof(opcode), NULL, 0U);
+    return writeShadowed(self, SHADOW_MODULATION_PARAMS, self->state.sx126x.shadow.modulation_params, opcode, sizeof(opcode));
 }
 
 static bool SetPacketParams(struct ldl_radio *self, const struct _packet_params *value)
@@ -1284,22 +1314,18 @@ static bool SetPacketParams(struct ldl_radio *self, const struct _packet_params
         value->invert_iq ? 1U : 0U
     };
 
-    return self->chip_write(self->chip, opcode, sizeof(opcode), NULL, 0U);
+    return writeShadowed(self, SHADOW_PACKET_PARAMS, self->state.sx126x.shadow.packet_params, opcode, sizeof(opcode));
 }
 
 static bool SetBufferBaseAddress(struct ldl_radio *self, uint8_t tx_base_addr, uint8_t rx_base_addr)
 {
-    bool retval;
-
     uint8_t opcode[] = {
         OPCODE_SET_BUFFER_BASE_ADDRESS,
         tx_base_addr,
         rx_base_addr
     };
 
-    retval = self->chip_write(self->chip, opcode, sizeof(opcode), NULL, 0U);
-
-    return retval;
+    return writeShadowed(self, SHADOW_BUFFER_BASE_ADDRESS, self->state.sx126x.shadow.buffer_base_address, opcode, sizeof(opcode));
 }
 
 static bool SetLoRaSymbNumTimeout(struct ldl_radio *self, uint8_t SymbNum)
@@ -1309,7 +1335,7 @@ static bool SetLoRaSymbNumTimeout(struct ldl_radio *self, uint8_t SymbNum)
         SymbNum
     };
 
-    return self->chip_write(self->chip, opcode, sizeof(opcode), NULL, 0U);
+    return writeShadowed(self, SHADOW_SYMB_NUM_TIMEOUT, self->state.sx126x.shadow.symb_num_timeout, opcode, sizeof(opcode));
 }
 
 static bool GetRxBufferStatus(struct ldl_radio *self, uint8_t *PayloadLengthRx, uint8_t *RxStartBufferPointer)
@@ -1323,7 +1349,7 @@ static bool GetRxBufferStatus(struct ldl_radio *self, uint8_t *PayloadLengthRx,
 
     uint8_t buffer[2];
 
-    if(self->chip_read(self->chip, opcode, sizeof(opcode), buffer, sizeof(buffer))){
+    if(LDL_Radio_read(self, opcode, sizeof(opcode), buffer, sizeof(buffer))){
 
         *PayloadLengthRx = buffer[0];
         *RxStartBufferPointer = buffer[1];
@@ -1345,7 +1371,7 @@ static bool GetPacketStatus(struct ldl_radio *self, union _packet_status *value)
 
     uint8_t buffer[3];
 
-    if(self->chip_read(self->chip, opcode, sizeof(opcode), buffer, sizeof(buffer))){
+    if(LDL_Radio_read(self, opcode, sizeof(opcode), buffer, sizeof(buffer))){
 
         value->lora.rssi_pkt = -((int8_t)buffer[0])/2;
         value->lora.snr_pkt = ((int8_t)buffer[1])/4;
@@ -1371,7 +1397,7 @@ static bool GetDeviceErrors(struct ldl_radio *self, struct _device_errors *value
 
     uint8_t buffer[2];
 
-    if(self->chip_read(self->chip, opcode, sizeof(opcode), buffer, sizeof(buffer))){
+    if(LDL_Radio_read(self, opcode, sizeof(opcode), buffer, sizeof(buffer))){
 
         errors = buffer[0];
         errors <<= 8;
@@ -1399,7 +1425,7 @@ static bool ClearDeviceErrors(struct ldl_radio *self)
         0
     };
 
-    return self->chip_write(self->chip, opcode, sizeof(opcode), NULL, 0U);
+    return LDL_Radio_write(self, opcode, sizeof(opcode), NULL, 0U, true);
 }
 
 static void printDeviceErrors(struct ldl_radio *self)
@@ -1451,7 +1477,7 @@ static bool GetStatus(struct ldl_radio *self, uint8_t *value)
         OPCODE_GET_STATUS
     };
 
-    return self->chip_read(self->chip, opcode, sizeof(opcode), value, sizeof(*value));
+    return LDL_Radio_read(self, opcode, sizeof(opcode), value, sizeof(*value));
 }
 #endif
 
@@ -1466,7 +1492,7 @@ static bool ReadReg(struct ldl_radio *self, uint16_t reg, uint8_t *data)
         0
     };
 
-    return self->chip_read(self->chip, opcode, sizeof(opcode), data, sizeof(*data));
+    return LDL_Radio_read(self, opcode, sizeof(opcode), data, sizeof(*data));
 }
 
 static bool WriteReg(struct ldl_radio *self, uint16_t reg, uint8_t data)
@@ -1477,7 +1503,7 @@ static bool WriteReg(struct ldl_radio *self, uint16_t reg, uint8_t data)
         U8(reg)
     };
 
-    return self->chip_write(self->chip, opcode, sizeof(opcode), &data, sizeof(data));
+    return LDL_Radio_write(self, opcode, sizeof(opcode), &data, sizeof(data), true);
 }
 #endif
 
@@ -1489,7 +1515,7 @@ static bool ReadBuffer(struct ldl_radio *self, uint8_t offset, uint8_t *data, ui
         0
     };
 
-    return self->chip_read(self->chip, opcode, sizeof(opcode), data, size);
+    return LDL_Radio_read(self, opcode, sizeof(opcode), data, size);
 }
 
 static bool WriteBuffer(struct ldl_radio *self, uint8_t offset, const uint8_t *data, uint8_t size)
@@ -1499,7 +1525,7 @@ static bool WriteBuffer(struct ldl_radio *self, uint8_t offset, const uint8_t *d
         U8(offset)
     };
 
-    return self->chip_write(self->chip, opcode, sizeof(opcode), data, size);
+    return LDL_Radio_write(self, opcode, sizeof(opcode), data, size, false);
 }
 
 static bool SetSyncWord(struct ldl_radio *self, uint16_t value)
@@ -1512,7 +1538,108 @@ static bool SetSyncWord(struct ldl_radio *self, uint16_t value)
         U8(value)
     };
 
-    return self->chip_write(self->chip, opcode, sizeof(opcode), NULL, 0U);
+    return writeShadowed(self, SHADOW_SYNC_WORD, self->state.sx126x.shadow.sync_word, opcode, sizeof(opcode));
+}
+
+static bool prepareTransmit(struct ldl_radio *self, const struct ldl_radio_tx_setting *settings, const void *data, uint8_t len)
+{
+    bool ok;
+
+    /* note this is dbm x 100 */
+    int16_t dbm = settings->eirp - self->tx_gain;
+
+    do{
+
+        ok = SetPacketType(self, PACKET_TYPE_LORA);
+        if(!ok){ break; }
+
+        if(self->state.sx126x.image_calibration_pending){
+
+            ok = CalibrateImage(self, settings->freq);
+            if(!ok){ break; }
+
+            self->state.sx126x.image_calibration_pending = false;
+        }
+
+        /* set power up here so that IO has time to settle */
+        ok = SetPower(self, dbm);
+        if(!ok){ break; }
+
+        ok = SetBufferBaseAddress(self, 0, 0);
+        if(!ok){ break; }
+
+        ok = SetRfFrequency(self, settings->freq);
+        if(!ok){ break; }
+
+        ok = WriteBuffer(self, 0U, data, len);
+        if(!ok){ break; }
+
+        {
+            struct _modulation_params arg;
+
+            arg.sf = settings->sf;
+            arg.bw = settings->bw;
+            arg.cr = LDL_CR_5;
+            arg.LowDataRateOptimize = ((arg.bw == LDL_BW_125) && ((arg.sf == LDL_SF_11) || (arg.sf == LDL_SF_12))) ? true : false;
+
+            ok = SetModulationParams(self, &arg);
+            if(!ok){ break; }
+        }
+
+        {
+            struct _packet_params arg;
+
+            arg.preamble_length = 8U;
+            arg.fixed_length_header = false;
+            arg.payload_length = len;
+            arg.crc_on = true;
+            arg.invert_iq = false;
+
+            ok = SetPacketParams(self, &arg);
+            if(!ok){ break; }
+        }
+
+        /* TxDone on DIO1 */
+        ok = SetDioIrqParams(self, 1, 1, 0, 0);
+        if(!ok){ break; }
+
+        ok = SetSyncWord(self, 0x3444);
+        if(!ok){ break; }
+    }
+    while(false);
+
+    return ok;
+}
+
+static bool writeShadowed(struct ldl_radio *self, uint8_t flag, uint8_t *shadow, const uint8_t *opcode, size_t size)
+{
+    bool retval = true;
+
+    /* the first byte is the opcode */
+    if(((self->state.sx126x.shadow.valid & flag) == 0U) || (memcmp(shadow, &opcode[1], size - 1U) != 0)){
+
+        self->state.sx126x.shadow.valid &= U8(~flag);
+
+        retval = LDL_Radio_write(self, opcode, size, NULL, 0U, true);
+
+        if(retval){
+
+            (void)memcpy(shadow, &opcode[1], size - 1U);
+            self->state.sx126x.shadow.valid |= flag;
+        }
+    }
+
+    return retval;
+}
+
+static void beginTransfers(struct ldl_radio *self)
+{
+    if(!LDL_Radio_beginTransfers(self)){
+
+        /* some of what was submitted last time may not have been written */
+        self->state.sx126x.shadow.valid = 0U;
+        self->state.sx126x.image_calibration_pending = true;
+    }
 }
 
 #endif
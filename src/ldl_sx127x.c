@@ -158,31 +158,41 @@ static const struct ldl_radio_interface interface = {
     .transmit = LDL_SX127X_transmit,
     .receive = LDL_SX127X_receive,
     .receive_entropy = LDL_SX127X_receiveEntropy,
-    .get_status = LDL_SX127X_getStatus
+    .get_status = LDL_SX127X_getStatus,
+    .prepare_transmit = LDL_SX127X_prepareTransmit,
+    .start_transmit = LDL_SX127X_startTransmit
 };
 
 /* static function prototypes *****************************************/
 
 #ifdef LDL_ENABLE_SX1272
 static void SX1272_setPower(struct ldl_radio *self, int16_t dbm);
-static void SX1272_setModemConfig1(struct ldl_radio *self, const struct modem_config *config);
-static void SX1272_setModemConfig2(struct ldl_radio *self, const struct modem_config *config);
+static uint8_t SX1272_modemConfig1(const struct modem_config *config);
+static uint8_t SX1272_modemConfig2(const struct modem_config *config);
 #endif
 
 #ifdef LDL_ENABLE_SX1276
 static void SX1276_setPower(struct ldl_radio *self, int16_t dbm);
-static void SX1276_setModemConfig1(struct ldl_radio *self, const struct modem_config *config);
-static void SX1276_setModemConfig2(struct ldl_radio *self, const struct modem_config *config);
-static void SX1276_setModemConfig3(struct ldl_radio *self, const struct modem_config *config);
+static uint8_t SX1276_modemConfig1(const struct modem_config *config);
+static uint8_t SX1276_modemConfig2(const struct modem_config *config);
+static uint8_t SX1276_modemConfig3(const struct modem_config *config);
 #endif
 
 static void init_state(struct ldl_radio *self, enum ldl_radio_type type, const struct ldl_sx127x_init_arg *arg);
 static uint8_t readFIFO(struct ldl_radio *self, uint8_t *data, uint8_t max);
 static void setFreq(struct ldl_radio *self, uint32_t freq);
+static void setModemConfig(struct ldl_radio *self, const struct modem_config *config);
 static uint8_t readReg(struct ldl_radio *self, enum ldl_radio_sx1272_sx1276_register reg);
 static void writeReg(struct ldl_radio *self, enum ldl_radio_sx1272_sx1276_register reg, uint8_t data);
 static void burstRead(struct ldl_radio *self, enum ldl_radio_sx1272_sx1276_register reg, uint8_t *data, uint8_t len);
 static void burstWrite(struct ldl_radio *self, enum ldl_radio_sx1272_sx1276_register reg, const uint8_t *data, uint8_t len);
+static void writeConfig(struct ldl_radio *self, enum ldl_radio_sx1272_sx1276_register reg, const uint8_t *data, uint8_t len);
+static void writeConfigReg(struct ldl_radio *self, enum ldl_radio_sx1272_sx1276_register reg, uint8_t data);
+static bool isShadowed(const struct ldl_radio *self, uint8_t reg, uint8_t data);
+static void updateShadow(struct ldl_radio *self, uint8_t reg, const uint8_t *data, uint8_t len);
+static void writeFailed(struct ldl_radio *self);
+static void beginTransfers(struct ldl_radio *self);
+static bool prepareTransmit(struct ldl_radio *self, const struct ldl_radio_tx_setting *settings, const void *data, uint8_t len);
 static void setOpRXSingle(struct ldl_radio *self);
 static void setOpTX(struct ldl_radio *self);
 static void setOpRXContinuous(struct ldl_radio *self);
@@ -250,6 +260,8 @@ void LDL_SX127X_setMode(struct ldl_radio *self, enum ldl_radio_mode mode)
         }
 #endif
         self->chip_set_mode(self->chip, LDL_CHIP_MODE_RESET);
+
+        (void)memset(self->state.sx127x.shadow_valid, 0, sizeof(self->state.sx127x.shadow_valid));
     }
         break;
 
@@ -365,89 +377,79 @@ void LDL_SX127X_setMode(struct ldl_radio *self, enum ldl_radio_mode mode)
 #endif
 
     self->mode = mode;
+    self->tx_ready = false;
 }
 
 void LDL_SX127X_transmit(struct ldl_radio *self, const struct ldl_radio_tx_setting *settings, const void *data, uint8_t len)
 {
     LDL_PEDANTIC(self != NULL)
-    LDL_PEDANTIC(settings != NULL)
-    LDL_PEDANTIC((data != NULL) || (len == 0U))
-    LDL_PEDANTIC(settings->freq != 0U)
-    LDL_PEDANTIC(self->mode == LDL_RADIO_MODE_TX)
     LDL_PEDANTIC((self->type == LDL_RADIO_SX1272) || (self->type == LDL_RADIO_SX1276))
 
-    struct modem_config config = {
-        .sf = settings->sf,
-        .bw = settings->bw,
-        .timeout = 0U,
-        .crc = true
-    };
-
-    int16_t dbm = settings->eirp - self->tx_gain;
-
 #ifdef LDL_ENABLE_RADIO_DEBUG
     debugLogReset(self);
 #endif
 
-#ifdef LDL_ENABLE_SX1272
-    if(self->type == LDL_RADIO_SX1272){
+    beginTransfers(self);
 
-        SX1272_setPower(self, dbm);
-        SX1272_setModemConfig1(self, &config);
-        SX1272_setModemConfig2(self, &config);
-    }
-#endif
-#ifdef LDL_ENABLE_SX1276
-    if(self->type == LDL_RADIO_SX1276){
+    if(prepareTransmit(self, settings, data, len)){
 
-        SX1276_setPower(self, dbm);
-        SX1276_setModemConfig1(self, &config);
-        SX1276_setModemConfig2(self, &config);
-        SX1276_setModemConfig3(self, &config);
+        setOpTX(self);                                  // TX
     }
-#endif
 
-    writeReg(self, RegSyncWord, 0x34U);                 // set sync word
-    writeReg(self, RegInvertIQ, 0x27U);                 // non-invert IQ
-    writeReg(self, RegDioMapping1, 0x40U);              // DIO0 (TX_COMPLETE) DIO1 (RX_DONE)
-    writeReg(self, RegIrqFlags, 0xffU);                 // clear interrupts
-    writeReg(self, RegIrqFlagsMask, 0xf7U);             // unmask TX_DONE interrupt
-    writeReg(self, RegFifoTxBaseAddr, 0U);              // set tx base
-    writeReg(self, RegFifoAddrPtr, 0U);                 // set address pointer
-    writeReg(self, LoraRegPayloadLength, len);          // bytes to transmit
-    burstWrite(self, RegFifo, data, len);               // write buffer
+    LDL_Radio_endTransfers(self);
 
-    setFreq(self, settings->freq);                      // set carrier frequency
+    if(self->state.sx127x.write_failed){
 
-    /* read everything back for debug */
-#ifdef LDL_ENABLE_RADIO_DEBUG
-    (void)readReg(self, RegModemConfig1);
-    (void)readReg(self, RegModemConfig2);
-#ifdef LDL_ENABLE_SX1276
-    if(self->type == LDL_RADIO_SX1276){
-        (void)readReg(self, RegModemConfig3);
+        LDL_DEBUG("chip write failed")
     }
+
+#ifdef LDL_ENABLE_RADIO_DEBUG
+    debugLogFlush(self, __FUNCTION__);
 #endif
-    (void)readReg(self, RegSyncWord);
-    (void)readReg(self, RegInvertIQ);
-    (void)readReg(self, RegDioMapping1);
-    (void)readReg(self, RegIrqFlags);
-    (void)readReg(self, RegIrqFlagsMask);
-    (void)readReg(self, RegFifoTxBaseAddr);
-    (void)readReg(self, RegFifoAddrPtr);
-    (void)readReg(self, LoraRegPayloadLength);
-    (void)readReg(self, RegFrfMsb);
-    (void)readReg(self, RegFrfMid);
-    (void)readReg(self, RegFrfLsb);
+}
+
+void LDL_SX127X_prepareTransmit(struct ldl_radio *self, const struct ldl_radio_tx_setting *settings, const void *data, uint8_t len)
+{
+    LDL_PEDANTIC(self != NULL)
+    LDL_PEDANTIC((self->type == LDL_RADIO_SX1272) || (self->type == LDL_RADIO_SX1276))
+
+#ifdef LDL_ENABLE_RADIO_DEBUG
+    debugLogReset(self);
 #endif
 
-    setOpTX(self);                                      // TX
+    beginTransfers(self);
+
+    self->tx_ready = prepareTransmit(self, settings, data, len);
+
+    LDL_Radio_endTransfers(self);
+
+    if(!self->tx_ready){
+
+        LDL_DEBUG("chip write failed")
+    }
 
 #ifdef LDL_ENABLE_RADIO_DEBUG
     debugLogFlush(self, __FUNCTION__);
 #endif
 }
 
+void LDL_SX127X_startTransmit(struct ldl_radio *self)
+{
+    LDL_PEDANTIC(self != NULL)
+    LDL_PEDANTIC((self->type == LDL_RADIO_SX1272) || (self->type == LDL_RADIO_SX1276))
+
+    if(self->tx_ready){
+
+        setOpTX(self);                                  // TX
+    }
+    else{
+
+        LDL_DEBUG("nothing to transmit")
+    }
+
+    self->tx_ready = false;
+}
+
 void LDL_SX127X_receive(struct ldl_radio *self, const struct ldl_radio_rx_setting *settings)
 {
     LDL_PEDANTIC(self != NULL)
@@ -482,32 +484,21 @@ void LDL_SX127X_receive(struct ldl_radio *self, const struct ldl_radio_rx_settin
     debugLogReset(self);
 #endif
 
-    self->chip_set_mode(self->chip, LDL_CHIP_MODE_RX);                  // configure accessory IO
+    beginTransfers(self);
 
-#ifdef LDL_ENABLE_SX1272
-    if(self->type == LDL_RADIO_SX1272){
+    self->chip_set_mode(self->chip, LDL_CHIP_MODE_RX);                  // configure accessory IO
 
-        SX1272_setModemConfig1(self, &config);
-        SX1272_setModemConfig2(self, &config);
-    }
-#endif
-#ifdef LDL_ENABLE_SX1276
-    if(self->type == LDL_RADIO_SX1276){
+    /* RegIrqFlagsMask and RegIrqFlags */
+    static const uint8_t irq[] = {0x3fU, 0xffU};
 
-        SX1276_setModemConfig1(self, &config);
-        SX1276_setModemConfig2(self, &config);
-        SX1276_setModemConfig3(self, &config);
-    }
-#endif
+    setModemConfig(self, &config);                              // includes symbol timeout
 
-    writeReg(self, RegSymbTimeoutLsb, U8(timeout));         // set symbol timeout
-    writeReg(self, RegSyncWord, 0x34);                      // set sync word
-    writeReg(self, RegLna, 0x23);                           // LNA gain to max, LNA boost enable
-    writeReg(self, RegPayloadMaxLength, settings->max);     // max payload
-    writeReg(self, RegInvertIQ, U8(0x40 + 0x27));           // invert IQ
-    writeReg(self, RegDioMapping1, 0U);                     // DIO0 (RX_TIMEOUT) DIO1 (RX_DONE)
-    writeReg(self, RegIrqFlags, 0xff);                      // clear all interrupts
-    writeReg(self, RegIrqFlagsMask, 0x3f);                  // unmask RX_TIMEOUT and RX_DONE interrupt
+    writeConfigReg(self, RegSyncWord, 0x34);                    // set sync word
+    writeConfigReg(self, RegLna, 0x23);                         // LNA gain to max, LNA boost enable
+    writeConfigReg(self, RegPayloadMaxLength, settings->max);   // max payload
+    writeConfigReg(self, RegInvertIQ, U8(0x40 + 0x27));         // invert IQ
+    writeConfigReg(self, RegDioMapping1, 0U);                   // DIO0 (RX_TIMEOUT) DIO1 (RX_DONE)
+    burstWrite(self, RegIrqFlagsMask, irq, U8(sizeof(irq)));    // unmask RX_TIMEOUT and RX_DONE interrupt and clear all interrupts
     writeReg(self, RegFifoAddrPtr, 0);
 
     setFreq(self, settings->freq);                          // set carrier frequency
@@ -537,6 +528,8 @@ void LDL_SX127X_receive(struct ldl_radio *self, const struct ldl_radio_rx_settin
 
     setOpRXSingle(self);                                    // single RX
 
+    LDL_Radio_endTransfers(self);
+
 #ifdef LDL_ENABLE_RADIO_DEBUG
     debugLogFlush(self, __FUNCTION__);
 #endif
@@ -594,6 +587,8 @@ void LDL_SX127X_receiveEntropy(struct ldl_radio *self)
     debugLogReset(self);
 #endif
 
+    beginTransfers(self);
+
     self->chip_set_mode(self->chip, LDL_CHIP_MODE_RX);  // configure accessory IO
     writeReg(self, RegIrqFlags, 0xffU);                 // clear all interrupts
     writeReg(self, RegIrqFlagsMask, 0xffU);             // mask all interrupts
@@ -616,6 +611,8 @@ void LDL_SX127X_receiveEntropy(struct ldl_radio *self)
 
     setOpRXContinuous(self);                                        // continuous RX
 
+    LDL_Radio_endTransfers(self);
+
 #ifdef LDL_ENABLE_RADIO_DEBUG
     debugLogFlush(self, __FUNCTION__);
 #endif
@@ -665,6 +662,78 @@ void LDL_SX127X_getStatus(struct ldl_radio *self, struct ldl_radio_status *statu
 
 /* static functions ***************************************************/
 
+static bool prepareTransmit(struct ldl_radio *self, const struct ldl_radio_tx_setting *settings, const void *data, uint8_t len)
+{
+    LDL_PEDANTIC(settings != NULL)
+    LDL_PEDANTIC((data != NULL) || (len == 0U))
+    LDL_PEDANTIC(settings->freq != 0U)
+    LDL_PEDANTIC(self->mode == LDL_RADIO_MODE_TX)
+
+    struct modem_config config = {
+        .sf = settings->sf,
+        .bw = settings->bw,
+        .timeout = 0U,
+        .crc = true
+    };
+
+    int16_t dbm = settings->eirp - self->tx_gain;
+
+    /* RegFifoAddrPtr and RegFifoTxBaseAddr */
+    static const uint8_t fifo[] = {0U, 0U};
+
+    /* RegIrqFlagsMask and RegIrqFlags */
+    static const uint8_t irq[] = {0xf7U, 0xffU};
+
+#ifdef LDL_ENABLE_SX1272
+    if(self->type == LDL_RADIO_SX1272){
+
+        SX1272_setPower(self, dbm);
+    }
+#endif
+#ifdef LDL_ENABLE_SX1276
+    if(self->type == LDL_RADIO_SX1276){
+
+        SX1276_setPower(self, dbm);
+    }
+#endif
+
+    setModemConfig(self, &config);
+
+    writeConfigReg(self, RegSyncWord, 0x34U);           // set sync word
+    writeConfigReg(self, RegInvertIQ, 0x27U);           // non-invert IQ
+    writeConfigReg(self, RegDioMapping1, 0x40U);        // DIO0 (TX_COMPLETE) DIO1 (RX_DONE)
+    burstWrite(self, RegFifoAddrPtr, fifo, U8(sizeof(fifo)));  // set address pointer and tx base
+    burstWrite(self, RegIrqFlagsMask, irq, U8(sizeof(irq)));   // unmask TX_DONE interrupt and clear interrupts
+    writeReg(self, LoraRegPayloadLength, len);          // bytes to transmit
+    burstWrite(self, RegFifo, data, len);               // write buffer
+
+    setFreq(self, settings->freq);                      // set carrier frequency
+
+    /* read everything back for debug */
+#ifdef LDL_ENABLE_RADIO_DEBUG
+    (void)readReg(self, RegModemConfig1);
+    (void)readReg(self, RegModemConfig2);
+#ifdef LDL_ENABLE_SX1276
+    if(self->type == LDL_RADIO_SX1276){
+        (void)readReg(self, RegModemConfig3);
+    }
+#endif
+    (void)readReg(self, RegSyncWord);
+    (void)readReg(self, RegInvertIQ);
+    (void)readReg(self, RegDioMapping1);
+    (void)readReg(self, RegIrqFlags);
+    (void)readReg(self, RegIrqFlagsMask);
+    (void)readReg(self, RegFifoTxBaseAddr);
+    (void)readReg(self, RegFifoAddrPtr);
+    (void)readReg(self, LoraRegPayloadLength);
+    (void)readReg(self, RegFrfMsb);
+    (void)readReg(self, RegFrfMid);
+    (void)readReg(self, RegFrfLsb);
+#endif
+
+    return !self->state.sx127x.write_failed;
+}
+
 static void init_state(struct ldl_radio *self, enum ldl_radio_type type, const struct ldl_sx127x_init_arg *arg)
 {
     LDL_PEDANTIC(self != NULL)
@@ -682,6 +751,9 @@ static void init_state(struct ldl_radio *self, enum ldl_radio_type type, const s
     self->chip_read = arg->chip_read;
     self->chip_write = arg->chip_write;
     self->chip_set_mode = arg->chip_set_mode;
+#ifdef LDL_ENABLE_CHIP_ASYNC
+    self->chip_submit = arg->chip_submit;
+#endif
 
     self->state.sx127x.pa = arg->pa;
     self->tx_gain = arg->tx_gain;
@@ -751,8 +823,8 @@ static void SX1272_setPower(struct ldl_radio *self, int16_t dbm)
             paConfig = 0U;
         }
 
-        writeReg(self, RegPaConfig, paConfig);
-        writeReg(self, SX1272RegPaDac, paDac);
+        writeConfigReg(self, RegPaConfig, paConfig);
+        writeConfigReg(self, SX1272RegPaDac, paDac);
         break;
 
     case LDL_SX127X_PA_BOOST:
@@ -786,8 +858,8 @@ static void SX1272_setPower(struct ldl_radio *self, int16_t dbm)
             }
         }
 
-        writeReg(self, RegPaConfig, paConfig);
-        writeReg(self, SX1272RegPaDac, paDac);
+        writeConfigReg(self, RegPaConfig, paConfig);
+        writeConfigReg(self, SX1272RegPaDac, paDac);
         break;
     }
 #ifdef LDL_ENABLE_RADIO_DEBUG
@@ -796,7 +868,7 @@ static void SX1272_setPower(struct ldl_radio *self, int16_t dbm)
 #endif
 }
 
-static void SX1272_setModemConfig1(struct ldl_radio *self, const struct modem_config *config)
+static uint8_t SX1272_modemConfig1(const struct modem_config *config)
 {
     bool low_rate = (config->bw == LDL_BW_125) && ((config->sf == LDL_SF_11) || (config->sf == LDL_SF_12));
     uint8_t bw;
@@ -819,10 +891,10 @@ static void SX1272_setModemConfig1(struct ldl_radio *self, const struct modem_co
      * implicitHeaderModeOn (1bit) (0)
      * rxPayloadCrcOn       (1bit) (1)
      * lowDataRateOptimize  (1bit)      */
-    writeReg(self, RegModemConfig1, bw | 8U | 0U | (config->crc ? 2U : 0U) | (low_rate ? 1U : 0U));
+    return bw | 8U | 0U | (config->crc ? 2U : 0U) | (low_rate ? 1U : 0U);
 }
 
-static void SX1272_setModemConfig2(struct ldl_radio *self, const struct modem_config *config)
+static uint8_t SX1272_modemConfig2(const struct modem_config *config)
 {
     uint8_t sf = (U8(config->sf) & U8(0xf)) << 4;
 
@@ -830,7 +902,7 @@ static void SX1272_setModemConfig2(struct ldl_radio *self, const struct modem_co
      * txContinuousMode     (1bit) (0)
      * agcAutoOn            (1bit) (1)
      * symbTimeout(9:8)     (2bit) (0)  */
-    writeReg(self, RegModemConfig2, sf | 0U | 4U | (U8(config->timeout >> 8) & 3U));
+    return sf | 0U | 4U | (U8(config->timeout >> 8) & 3U);
 }
 #endif
 
@@ -899,8 +971,8 @@ static void SX1276_setPower(struct ldl_radio *self, int16_t dbm)
             paConfig = 0x10U;
         }
 
-        writeReg(self, RegPaConfig, paConfig);
-        writeReg(self, SX1276RegPaDac, paDac);
+        writeConfigReg(self, RegPaConfig, paConfig);
+        writeConfigReg(self, SX1276RegPaDac, paDac);
         break;
 
     /* 2dBm to 17dBm
@@ -938,8 +1010,8 @@ static void SX1276_setPower(struct ldl_radio *self, int16_t dbm)
             }
         }
 
-        writeReg(self, RegPaConfig, paConfig);
-        writeReg(self, SX1276RegPaDac, paDac);
+        writeConfigReg(self, RegPaConfig, paConfig);
+        writeConfigReg(self, SX1276RegPaDac, paDac);
         break;
     }
 
@@ -949,7 +1021,7 @@ static void SX1276_setPower(struct ldl_radio *self, int16_t dbm)
 #endif
 }
 
-static void SX1276_setModemConfig1(struct ldl_radio *self, const struct modem_config *config)
+static uint8_t SX1276_modemConfig1(const struct modem_config *config)
 {
     uint8_t bw;
 
@@ -969,10 +1041,10 @@ static void SX1276_setModemConfig1(struct ldl_radio *self, const struct modem_co
     /* bandwidth            (4bit)
      * codingRate           (3bit) (LDL_CR_5)
      * implicitHeaderModeOn (1bit) (0)  */
-    writeReg(self, RegModemConfig1, bw | 2U | 0U);
+    return bw | 2U | 0U;
 }
 
-static void SX1276_setModemConfig2(struct ldl_radio *self, const struct modem_config *config)
+static uint8_t SX1276_modemConfig2(const struct modem_config *config)
 {
     uint8_t sf = (U8(config->sf) & U8(0xf)) << 4;
 
@@ -980,10 +1052,10 @@ static void SX1276_setModemConfig2(struct ldl_radio *self, const struct modem_co
      * txContinuousMode     (1bit) (0)
      * rxPayloadCrcOn       (1bit) (1)
      * symbTimeout(9:8)     (2bit) (0)  */
-    writeReg(self, RegModemConfig2, sf | 0U | (config->crc ? 4U : 0U) | 0U | (U8(config->timeout >> 8) & 3U));
+    return sf | 0U | (config->crc ? 4U : 0U) | 0U | (U8(config->timeout >> 8) & 3U);
 }
 
-static void SX1276_setModemConfig3(struct ldl_radio *self, const struct modem_config *config)
+static uint8_t SX1276_modemConfig3(const struct modem_config *config)
 {
     bool low_rate = (config->bw == LDL_BW_125) && ((config->sf == LDL_SF_11) || (config->sf == LDL_SF_12));
 
@@ -991,7 +1063,7 @@ static void SX1276_setModemConfig3(struct ldl_radio *self, const struct modem_co
      * lowDataRateOptimize  (1bit)
      * agcAutoOn            (1bit) (1)
      * unused               (2bit) (0)  */
-    writeReg(self, RegModemConfig3, 0U | (low_rate ? 8U : 0U) | 4U | 0U);
+    return 0U | (low_rate ? 8U : 0U) | 4U | 0U;
 }
 #endif
 
@@ -999,9 +1071,59 @@ static void setFreq(struct ldl_radio *self, uint32_t freq)
 {
     uint32_t f = U32((U64(freq) << 19) / U64(32000000));
 
-    writeReg(self, RegFrfMsb, U8(f >> 16));
-    writeReg(self, RegFrfMid, U8(f >> 8));
-    writeReg(self, RegFrfLsb, U8(f));
+    uint8_t first = 0U;
+
+    uint8_t frf[] = {
+        U8(f >> 16),
+        U8(f >> 8),
+        U8(f)
+    };
+
+    /* a new frequency is only applied when RegFrfLsb is written so
+     * only leading registers that already hold the value are skipped */
+    while((first < U8(sizeof(frf))) && isShadowed(self, U8(RegFrfMsb) + first, frf[first])){
+
+        first++;
+    }
+
+    if(first < U8(sizeof(frf))){
+
+        burstWrite(self, (enum ldl_radio_sx1272_sx1276_register)(U8(RegFrfMsb) + first), &frf[first], U8(sizeof(frf)) - first);
+    }
+}
+
+static void setModemConfig(struct ldl_radio *self, const struct modem_config *config)
+{
+    /* RegModemConfig1, RegModemConfig2 and RegSymbTimeoutLsb */
+    uint8_t modem[3U];
+
+    modem[0] = 0U;
+    modem[1] = 0U;
+    modem[2] = U8(config->timeout);
+
+#ifdef LDL_ENABLE_SX1272
+    if(self->type == LDL_RADIO_SX1272){
+
+        modem[0] = SX1272_modemConfig1(config);
+        modem[1] = SX1272_modemConfig2(config);
+    }
+#endif
+#ifdef LDL_ENABLE_SX1276
+    if(self->type == LDL_RADIO_SX1276){
+
+        modem[0] = SX1276_modemConfig1(config);
+        modem[1] = SX1276_modemConfig2(config);
+    }
+#endif
+
+    writeConfig(self, RegModemConfig1, modem, U8(sizeof(modem)));
+
+#ifdef LDL_ENABLE_SX1276
+    if(self->type == LDL_RADIO_SX1276){
+
+        writeConfigReg(self, RegModemConfig3, SX1276_modemConfig3(config));
+    }
+#endif
 }
 
 static uint8_t readFIFO(struct ldl_radio *self, uint8_t *data, uint8_t max)
@@ -1020,12 +1142,86 @@ static uint8_t readFIFO(struct ldl_radio *self, uint8_t *data, uint8_t max)
     return size;
 }
 
+/* write a range of configuration registers
+ *
+ * Registers at either end of the range that already hold the same
+ * value are skipped. Only use this for registers that
+ * the chip does not change by itself (and not RegFrf, see setFreq()).
+ *
+ * */
+static void writeConfig(struct ldl_radio *self, enum ldl_radio_sx1272_sx1276_register reg, const uint8_t *data, uint8_t len)
+{
+    uint8_t first = 0U;
+    uint8_t last = len;
+
+    while((first < last) && isShadowed(self, U8(reg) + first, data[first])){
+
+        first++;
+    }
+
+    while((last > first) && isShadowed(self, U8(reg) + last - 1U, data[last - 1U])){
+
+        last--;
+    }
+
+    if(first < last){
+
+        burstWrite(self, (enum ldl_radio_sx1272_sx1276_register)(U8(reg) + first), &data[first], last - first);
+    }
+}
+
+static void writeConfigReg(struct ldl_radio *self, enum ldl_radio_sx1272_sx1276_register reg, uint8_t data)
+{
+    writeConfig(self, reg, &data, 1U);
+}
+
+static bool isShadowed(const struct ldl_radio *self, uint8_t reg, uint8_t data)
+{
+    return (reg < LDL_SX127X_SHADOW_SIZE)
+        && ((self->state.sx127x.shadow_valid[reg >> 3] & (1U << (reg & 7U))) > 0U)
+        && (self->state.sx127x.shadow[reg] == data);
+}
+
+static void updateShadow(struct ldl_radio *self, uint8_t reg, const uint8_t *data, uint8_t len)
+{
+    uint8_t i;
+
+    /* the FIFO is not a register */
+    if(reg != U8(RegFifo)){
+
+        for(i=0U; (i < len) && ((reg + i) < LDL_SX127X_SHADOW_SIZE); i++){
+
+            self->state.sx127x.shadow[reg + i] = data[i];
+            self->state.sx127x.shadow_valid[(reg + i) >> 3] |= U8(1U << ((reg + i) & 7U));
+        }
+    }
+}
+
+static void writeFailed(struct ldl_radio *self)
+{
+    /* the chip may or may not have the value */
+    (void)memset(self->state.sx127x.shadow_valid, 0, sizeof(self->state.sx127x.shadow_valid));
+
+    self->state.sx127x.write_failed = true;
+}
+
+static void beginTransfers(struct ldl_radio *self)
+{
+    self->state.sx127x.write_failed = false;
+
+    if(!LDL_Radio_beginTransfers(self)){
+
+        /* some of what was submitted last time may not have been written */
+        (void)memset(self->state.sx127x.shadow_valid, 0, sizeof(self->state.sx127x.shadow_valid));
+    }
+}
+
 static uint8_t readReg(struct ldl_radio *self, enum ldl_radio_sx1272_sx1276_register reg)
 {
     uint8_t data;
     uint8_t opcode = U8(reg) & 0x7FU;
 
-    self->chip_read(self->chip, &opcode, sizeof(opcode), &data, U8(sizeof(data)));
+    (void)LDL_Radio_read(self, &opcode, sizeof(opcode), &data, U8(sizeof(data)));
 
 #ifdef LDL_ENABLE_RADIO_DEBUG
     debugLogPush(self, opcode, &data, sizeof(data));
@@ -1038,7 +1234,7 @@ static void burstRead(struct ldl_radio *self, enum ldl_radio_sx1272_sx1276_regis
 {
     uint8_t opcode = U8(reg) & 0x7FU;
 
-    self->chip_read(self->chip, &opcode, sizeof(opcode), data, len);
+    (void)LDL_Radio_read(self, &opcode, sizeof(opcode), data, len);
 
 #ifdef LDL_ENABLE_RADIO_DEBUG
     debugLogPush(self, opcode, data, len);
@@ -1049,7 +1245,14 @@ static void writeReg(struct ldl_radio *self, enum ldl_radio_sx1272_sx1276_regist
 {
     uint8_t opcode = U8(reg) | 0x80U;
 
-    self->chip_write(self->chip, &opcode, sizeof(opcode), &data, 1U);
+    if(LDL_Radio_write(self, &opcode, sizeof(opcode), &data, 1U, true)){
+
+        updateShadow(self, U8(reg), &data, 1U);
+    }
+    else{
+
+        writeFailed(self);
+    }
 
 #ifdef LDL_ENABLE_RADIO_DEBUG
     debugLogPush(self, opcode, &data, sizeof(data));
@@ -1060,7 +1263,15 @@ static void burstWrite(struct ldl_radio *self, enum ldl_radio_sx1272_sx1276_regi
 {
     uint8_t opcode = U8(reg) | 0x80U;
 
-    self->chip_write(self->chip, &opcode, sizeof(opcode), data, len);
+    /* FIFO data is the caller's buffer which stays put until TX is complete */
+    if(LDL_Radio_write(self, &opcode, sizeof(opcode), data, len, (reg != RegFifo))){
+
+        updateShadow(self, U8(reg), data, len);
+    }
+    else{
+
+        writeFailed(self);
+    }
 
 #ifdef LDL_ENABLE_RADIO_DEBUG
     debugLogPush(self, opcode, data, len);
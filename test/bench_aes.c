@@ -0,0 +1,93 @@
+/* cycles (or nanoseconds) per block for the AES implementation
+ * selected at build time
+ *
+ * build and run both implementations with `make bench`
+ *
+ * */
+
+#include "ldl_aes.h"
+
+#include <stdio.h>
+#include <string.h>
+#include <time.h>
+
+#if defined(__x86_64__) || defined(__i386__)
+    #include <x86intrin.h>
+    #define HAVE_TSC
+#endif
+
+#if defined(LDL_ENABLE_AES_NI)
+    #define IMPL "aes-ni"
+#elif defined(LDL_ENABLE_AES_TTABLE)
+    #define IMPL "ttable"
+#else
+    #define IMPL "byte"
+#endif
+
+#define BLOCKS 100000UL
+#define RUNS 10U
+
+static uint64_t nanoseconds(void)
+{
+    struct timespec ts;
+
+    (void)clock_gettime(CLOCK_MONOTONIC, &ts);
+
+    return ((uint64_t)ts.tv_sec * 1000000000ULL) + (uint64_t)ts.tv_nsec;
+}
+
+int main(void)
+{
+    static const uint8_t key[] = {0x2b,0x7e,0x15,0x16,0x28,0xae,0xd2,0xa6,0xab,0xf7,0x15,0x88,0x09,0xcf,0x4f,0x3c};
+    struct ldl_aes_ctx ctx;
+    uint8_t block[16U];
+    unsigned long i;
+    unsigned run;
+    uint64_t ns;
+    uint64_t best_ns = UINT64_MAX;
+#ifdef HAVE_TSC
+    uint64_t cycles;
+    uint64_t best_cycles = UINT64_MAX;
+#endif
+
+    (void)memset(block, 0, sizeof(block));
+
+    LDL_AES_init(&ctx, key);
+
+#ifdef LDL_AES_BACKEND
+    if(ctx.backend == NULL){
+
+        printf("aes %s: backend not available, measuring portable implementation\n", IMPL);
+    }
+#endif
+
+    /* the best run is the least disturbed by the host */
+    for(run=0U; run < RUNS; run++){
+
+        ns = nanoseconds();
+#ifdef HAVE_TSC
+        cycles = __rdtsc();
+#endif
+        for(i=0U; i < BLOCKS; i++){
+
+            LDL_AES_encrypt(&ctx, block);
+        }
+#ifdef HAVE_TSC
+        cycles = __rdtsc() - cycles;
+        best_cycles = (cycles < best_cycles) ? cycles : best_cycles;
+#endif
+        ns = nanoseconds() - ns;
+        best_ns = (ns < best_ns) ? ns : best_ns;
+    }
+
+#ifdef HAVE_TSC
+    printf("aes %s: %.1f cycles/block %.1f ns/block\n", IMPL, (double)best_cycles / BLOCKS, (double)best_ns / BLOCKS);
+#else
+    printf("aes %s: %.1f ns/block\n", IMPL, (double)best_ns / BLOCKS);
+#endif
+
+    /* printing the result stops the compiler discarding the work */
+    printf("(last block %02x%02x)\n", block[0], block[15]);
+
+    return 0;
+}
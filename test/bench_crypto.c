@@ -0,0 +1,367 @@
+/* cost of the cryptographic operations behind each frame
+ *
+ * prints one CSV record per operation and size:
+ *
+ * impl,version,cache,op,bytes,ns_per_op,ns_per_byte,aes_per_op
+ *
+ * - impl is the AES implementation selected at build time
+ * - version is the LoRaWAN version the frames were secured for
+ * - cache is yes if LDL_ENABLE_SM_KEY_CACHE was defined
+ * - bytes is the number of bytes processed (payload size for frames)
+ * - ns_per_byte is empty when bytes is zero
+ * - aes_per_op counts block encryptions (including those needed for
+ *   CMAC subkeys when they are not cached)
+ *
+ * build and run every variant with `make bench_crypto`
+ *
+ * pass --no-header to leave out the header record
+ *
+ * */
+
+#include "ldl_aes.h"
+#include "ldl_cmac.h"
+#include "ldl_ctr.h"
+#include "ldl_frame.h"
+#include "ldl_mac.h"
+#include "ldl_ops.h"
+#include "ldl_sm.h"
+#include "ldl_sm_internal.h"
+
+#include <stdio.h>
+#include <string.h>
+#include <time.h>
+
+#if defined(LDL_ENABLE_AES_NI)
+    #define IMPL "aes-ni"
+#elif defined(LDL_ENABLE_AES_TTABLE)
+    #define IMPL "ttable"
+#else
+    #define IMPL "byte"
+#endif
+
+#if defined(LDL_ENABLE_L2_1_1)
+    #define VERSION "1.1"
+#else
+    #define VERSION "1.0.4"
+#endif
+
+#ifdef LDL_ENABLE_SM_KEY_CACHE
+    #define CACHE "yes"
+#else
+    #define CACHE "no"
+#endif
+
+#define RUNS 5U
+#define DEV_ADDR 0x01020304UL
+
+typedef void (*bench_fn)(uint8_t size);
+
+static const uint8_t key[] = {0x2B, 0x7E, 0x15, 0x16, 0x28, 0xAE, 0xD2, 0xA6, 0xAB, 0xF7, 0x15, 0x88, 0x09, 0xCF, 0x4F, 0x3C};
+
+/* 0 to the largest FRMPayload (DR5 and above) */
+static const uint8_t sizes[] = {0U, 1U, 16U, 32U, 51U, 64U, 115U, 128U, 222U, 242U};
+
+static bool counting;
+static unsigned long aesCount;
+
+static struct ldl_aes_ctx aes;
+static struct ldl_cmac_subkeys subkeys;
+static struct ldl_sm sm;
+static struct ldl_mac mac;
+
+static uint8_t input[UINT8_MAX];
+static uint8_t output[UINT8_MAX];
+static uint8_t downlink[UINT8_MAX];
+static uint8_t downlinkLen;
+
+/* counting backend ***************************************************/
+
+static bool countInit(struct ldl_aes_ctx *ctx)
+{
+    (void)ctx;
+
+    return true;
+}
+
+static void countEncrypt(const struct ldl_aes_ctx *ctx, void *s)
+{
+    struct ldl_aes_ctx plain;
+
+    aesCount++;
+
+    (void)memcpy(&plain, ctx, sizeof(plain));
+    plain.backend = NULL;
+
+    LDL_AES_encrypt(&plain, s);
+}
+
+static const struct ldl_aes_backend countBackend = {
+    .init = countInit,
+    .encrypt = countEncrypt,
+    .encrypt_blocks = NULL
+};
+
+const struct ldl_aes_backend *bench_getBackend(void)
+{
+    const struct ldl_aes_backend *retval;
+
+    if(counting){
+
+        retval = &countBackend;
+    }
+    else{
+
+#ifdef LDL_ENABLE_AES_NI
+        retval = LDL_AES_NI_getBackend();
+#else
+        retval = NULL;
+#endif
+    }
+
+    return retval;
+}
+
+/* setup **************************************************************/
+
+static uint64_t nanoseconds(void)
+{
+    struct timespec ts;
+
+    (void)clock_gettime(CLOCK_MONOTONIC, &ts);
+
+    return ((uint64_t)ts.tv_sec * 1000000000ULL) + (uint64_t)ts.tv_nsec;
+}
+
+static uint8_t putU32(uint8_t *buf, uint32_t value)
+{
+    buf[0] = (uint8_t)value;
+    buf[1] = (uint8_t)(value >> 8);
+    buf[2] = (uint8_t)(value >> 16);
+    buf[3] = (uint8_t)(value >> 24);
+
+    return 4U;
+}
+
+/* key schedules pick up the backend when they are initialised */
+static void setup(void)
+{
+    size_t i;
+
+    LDL_AES_init(&aes, key);
+    LDL_CMAC_subkeys(&subkeys, &aes);
+
+    (void)memset(&sm, 0, sizeof(sm));
+
+    for(i=0U; i < sizeof(sm.keys)/sizeof(*sm.keys); i++){
+
+        (void)memcpy(sm.keys[i].value, key, sizeof(sm.keys[i].value));
+#ifdef LDL_ENABLE_SM_KEY_CACHE
+        LDL_AES_init(&sm.keys[i].ctx, sm.keys[i].value);
+        LDL_CMAC_subkeys(&sm.keys[i].subkeys, &sm.keys[i].ctx);
+#endif
+    }
+
+    (void)memset(&mac, 0, sizeof(mac));
+
+    mac.sm = &sm;
+    mac.sm_interface = LDL_SM_getInterface();
+    mac.op = LDL_OP_DATA_UNCONFIRMED;
+    mac.ctx.devAddr = DEV_ADDR;
+    mac.tx.rate = 5U;
+    mac.tx.chIndex = 2U;
+#if defined(LDL_ENABLE_L2_1_1)
+    mac.ctx.version = 1U;
+#endif
+}
+
+/* unconfirmed downlink on port 1 (same key in every slot) */
+static uint8_t makeDownlink(uint8_t *buffer, uint8_t size)
+{
+    uint8_t pos = 0U;
+    uint8_t block[16U];
+    uint32_t mic;
+
+    buffer[pos++] = 0x60U;
+    pos += putU32(&buffer[pos], DEV_ADDR);
+    buffer[pos++] = 0x00U;  /* FCtrl */
+    buffer[pos++] = 0x01U;  /* FCnt */
+    buffer[pos++] = 0x00U;
+
+    if(size > 0U){
+
+        buffer[pos++] = 1U;
+
+        (void)memcpy(&buffer[pos], input, size);
+
+        (void)memset(block, 0, sizeof(block));
+        block[0] = 0x01U;
+        block[5] = 1U;
+        (void)putU32(&block[6], DEV_ADDR);
+        (void)putU32(&block[10], 1U);
+        block[15] = 1U;
+
+        LDL_SM_ctr(&sm, LDL_SM_KEY_APPS, block, &buffer[pos], size);
+
+        pos += size;
+    }
+
+    (void)memset(block, 0, sizeof(block));
+    block[0] = 0x49U;
+    block[5] = 1U;
+    (void)putU32(&block[6], DEV_ADDR);
+    (void)putU32(&block[10], 1U);
+    block[15] = pos;
+
+    mic = LDL_SM_mic(&sm, LDL_SM_KEY_SNWKSINT, block, sizeof(block), buffer, pos);
+
+    pos += putU32(&buffer[pos], mic);
+
+    return pos;
+}
+
+/* operations *********************************************************/
+
+static void benchAES(uint8_t size)
+{
+    (void)size;
+
+    LDL_AES_encrypt(&aes, output);
+}
+
+static void benchCMAC(uint8_t size)
+{
+    struct ldl_cmac_ctx ctx;
+
+    LDL_CMAC_initWithSubkeys(&ctx, &aes, &subkeys);
+    LDL_CMAC_update(&ctx, input, size);
+    LDL_CMAC_finish(&ctx, output, 4U);
+}
+
+static void benchCTR(uint8_t size)
+{
+    static const uint8_t iv[16U] = {0x01U};
+
+    LDL_CTR_encrypt(&aes, iv, input, output, size);
+}
+
+static void benchPrepareData(uint8_t size)
+{
+    struct ldl_frame_data f;
+
+    (void)memset(&f, 0, sizeof(f));
+
+    f.type = FRAME_TYPE_DATA_UNCONFIRMED_UP;
+    f.devAddr = DEV_ADDR;
+    f.counter = 1U;
+    f.port = 1U;
+    f.data = input;
+    f.dataLen = size;
+
+    (void)LDL_OPS_prepareData(&mac, &f, output, UINT8_MAX);
+}
+
+static void benchReceiveFrame(uint8_t size)
+{
+    struct ldl_frame_down f;
+
+    (void)size;
+
+    /* decrypted in place so a fresh copy is needed every time */
+    (void)memcpy(output, downlink, downlinkLen);
+
+    if(!LDL_OPS_receiveFrame(&mac, &f, output, downlinkLen)){
+
+        fprintf(stderr, "receive_frame: frame rejected\n");
+    }
+}
+
+/* harness ************************************************************/
+
+static void measure(const char *name, bench_fn fn, uint8_t size, uint8_t bytes, unsigned long iterations)
+{
+    unsigned long i;
+    unsigned run;
+    uint64_t ns;
+    uint64_t best = UINT64_MAX;
+    double perOp;
+
+    /* counting pass goes through the counting backend */
+    counting = true;
+    setup();
+
+    aesCount = 0U;
+    fn(size);
+
+    counting = false;
+    setup();
+
+    /* the best run is the least disturbed by the host */
+    for(run=0U; run < RUNS; run++){
+
+        ns = nanoseconds();
+
+        for(i=0U; i < iterations; i++){
+
+            fn(size);
+        }
+
+        ns = nanoseconds() - ns;
+        best = (ns < best) ? ns : best;
+    }
+
+    perOp = (double)best / (double)iterations;
+
+    printf("%s,%s,%s,%s,%u,%.1f,", IMPL, VERSION, CACHE, name, bytes, perOp);
+
+    if(bytes > 0U){
+
+        printf("%.2f", perOp / (double)bytes);
+    }
+
+    printf(",%lu\n", aesCount);
+}
+
+int main(int argc, char **argv)
+{
+    size_t i;
+
+    if(!((argc > 1) && (strcmp(argv[1], "--no-header") == 0))){
+
+        printf("impl,version,cache,op,bytes,ns_per_op,ns_per_byte,aes_per_op\n");
+    }
+
+    for(i=0U; i < sizeof(input); i++){
+
+        input[i] = (uint8_t)i;
+    }
+
+    measure("aes", benchAES, 16U, 16U, 100000UL);
+
+    for(i=0U; i < sizeof(sizes); i++){
+
+        measure("cmac", benchCMAC, sizes[i], sizes[i], 20000UL);
+    }
+
+    for(i=0U; i < sizeof(sizes); i++){
+
+        measure("ctr", benchCTR, sizes[i], sizes[i], 20000UL);
+    }
+
+    for(i=0U; i < sizeof(sizes); i++){
+
+        measure("prepare_data", benchPrepareData, sizes[i], sizes[i], 5000UL);
+    }
+
+    for(i=0U; i < sizeof(sizes); i++){
+
+        setup();
+        downlinkLen = makeDownlink(downlink, sizes[i]);
+
+        measure("receive_frame", benchReceiveFrame, sizes[i], sizes[i], 5000UL);
+    }
+
+    /* printing the result stops the compiler discarding the work */
+    fprintf(stderr, "(last byte %02x)\n", output[0]);
+
+    return 0;
+}
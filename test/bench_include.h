@@ -0,0 +1,17 @@
+#ifndef BENCH_INCLUDE_H
+#define BENCH_INCLUDE_H
+
+/* target include for bench_crypto
+ *
+ * no logging, and every key schedule asks bench_crypto.c for a backend
+ * so that it can count block encryptions
+ *
+ * */
+
+struct ldl_aes_backend;
+
+const struct ldl_aes_backend *bench_getBackend(void);
+
+#define LDL_AES_BACKEND bench_getBackend()
+
+#endif
@@ -0,0 +1,189 @@
+/* nanoseconds per call for the region queries the MAC makes
+ * during a TX/RX cycle
+ *
+ * build and run with `make bench`
+ *
+ * */
+
+#include "ldl_region.h"
+
+#include <stdio.h>
+#include <string.h>
+#include <time.h>
+
+#define CALLS 1000000UL
+#define RUNS 5U
+
+typedef uint32_t (*bench_fn)(enum ldl_region region, uint32_t i);
+
+struct region_info {
+
+    enum ldl_region region;
+    const char *name;
+    uint8_t maxRate;
+    uint32_t freq;
+};
+
+/* the region functions that manage channels call back into the MAC */
+bool LDL_MAC_addChannel(struct ldl_mac *self, uint8_t chIndex, uint32_t freq, uint8_t minRate, uint8_t maxRate)
+{
+    (void)self;
+    (void)chIndex;
+    (void)freq;
+    (void)minRate;
+    (void)maxRate;
+
+    return true;
+}
+
+bool LDL_MAC_maskChannel(struct ldl_mac *self, uint8_t chIndex)
+{
+    (void)self;
+    (void)chIndex;
+
+    return true;
+}
+
+bool LDL_MAC_unmaskChannel(struct ldl_mac *self, uint8_t chIndex)
+{
+    (void)self;
+    (void)chIndex;
+
+    return true;
+}
+
+static const struct region_info regions[] = {
+#ifdef LDL_ENABLE_EU_863_870
+    {LDL_EU_863_870, "EU_863_870", 5U, 868100000UL},
+#endif
+#ifdef LDL_ENABLE_US_902_928
+    {LDL_US_902_928, "US_902_928", 3U, 902300000UL},
+#endif
+#ifdef LDL_ENABLE_AU_915_928
+    {LDL_AU_915_928, "AU_915_928", 5U, 915200000UL},
+#endif
+#ifdef LDL_ENABLE_EU_433
+    {LDL_EU_433, "EU_433", 5U, 433175000UL},
+#endif
+};
+
+static const struct region_info *info;
+
+static uint64_t nanoseconds(void)
+{
+    struct timespec ts;
+
+    (void)clock_gettime(CLOCK_MONOTONIC, &ts);
+
+    return ((uint64_t)ts.tv_sec * 1000000000ULL) + (uint64_t)ts.tv_nsec;
+}
+
+/* operations *********************************************************/
+
+static uint32_t benchConvertRate(enum ldl_region region, uint32_t i)
+{
+    enum ldl_spreading_factor sf;
+    enum ldl_signal_bandwidth bw;
+    uint8_t mtu;
+
+    LDL_Region_convertRate(region, (uint8_t)(i % (info->maxRate + 1U)), &sf, &bw, &mtu);
+
+    return (uint32_t)sf + (uint32_t)bw + mtu;
+}
+
+static uint32_t benchGetBand(enum ldl_region region, uint32_t i)
+{
+    uint8_t band = 0U;
+
+    (void)LDL_Region_getBand(region, info->freq + ((i % 8U) * 200000UL), &band);
+
+    return band;
+}
+
+static uint32_t benchGetChannel(enum ldl_region region, uint32_t i)
+{
+    uint32_t freq = 0U;
+    uint8_t minRate = 0U;
+    uint8_t maxRate = 0U;
+
+    (void)LDL_Region_getChannel(region, (uint8_t)(i % LDL_Region_numChannels(region)), &freq, &minRate, &maxRate);
+
+    return freq + minRate + maxRate;
+}
+
+static uint32_t benchGetRX1DataRate(enum ldl_region region, uint32_t i)
+{
+    uint8_t rate = 0U;
+
+    LDL_Region_getRX1DataRate(region, (uint8_t)(i % (info->maxRate + 1U)), (uint8_t)(i % 4U), &rate);
+
+    return rate;
+}
+
+static uint32_t benchGetOffTimeFactor(enum ldl_region region, uint32_t i)
+{
+    return LDL_Region_getOffTimeFactor(region, (uint8_t)(i % 5U));
+}
+
+static uint32_t benchValidateFreq(enum ldl_region region, uint32_t i)
+{
+    return LDL_Region_validateFreq(region, info->freq + (i % 8U)) ? 1U : 0U;
+}
+
+static uint32_t benchGetTXPower(enum ldl_region region, uint32_t i)
+{
+    return (uint32_t)LDL_Region_getTXPower(region, (uint8_t)(i % 5U));
+}
+
+/* harness ************************************************************/
+
+static uint32_t measure(const char *name, bench_fn fn)
+{
+    uint32_t sink = 0U;
+    uint32_t i;
+    unsigned run;
+    uint64_t ns;
+    uint64_t best = UINT64_MAX;
+
+    /* the best run is the least disturbed by the host */
+    for(run=0U; run < RUNS; run++){
+
+        ns = nanoseconds();
+
+        for(i=0U; i < CALLS; i++){
+
+            sink += fn(info->region, i);
+        }
+
+        ns = nanoseconds() - ns;
+        best = (ns < best) ? ns : best;
+    }
+
+    printf("region %s %s: %.2f ns/call\n", info->name, name, (double)best / CALLS);
+
+    return sink;
+}
+
+int main(void)
+{
+    size_t i;
+    uint32_t sink = 0U;
+
+    for(i=0U; i < sizeof(regions)/sizeof(*regions); i++){
+
+        info = &regions[i];
+
+        sink += measure("convertRate", benchConvertRate);
+        sink += measure("getBand", benchGetBand);
+        sink += measure("getChannel", benchGetChannel);
+        sink += measure("getRX1DataRate", benchGetRX1DataRate);
+        sink += measure("getOffTimeFactor", benchGetOffTimeFactor);
+        sink += measure("validateFreq", benchValidateFreq);
+        sink += measure("getTXPower", benchGetTXPower);
+    }
+
+    /* printing the result stops the compiler discarding the work */
+    printf("(sink %08x)\n", (unsigned)sink);
+
+    return 0;
+}
@@ -17,6 +17,14 @@ extern FILE * trace_desc;
 #define LDL_TRACE_HEX(PTR, LEN) print_hex(trace_desc, PTR, LEN);
 #define LDL_TRACE_FINAL() fprintf(trace_desc, "\n");
 
+/* fails the test if a critical section is entered while already held
+ * (not every target can nest them, e.g. the Ruby wrapper uses a mutex) */
+void mock_critical_enter(void *app);
+void mock_critical_leave(void *app);
+
+#define LDL_SYSTEM_ENTER_CRITICAL(APP) mock_critical_enter(APP);
+#define LDL_SYSTEM_LEAVE_CRITICAL(APP) mock_critical_leave(APP);
+
 #define LDL_ASSERT(X) assert((X));
 #define LDL_PEDANTIC(X) LDL_ASSERT(X)
 
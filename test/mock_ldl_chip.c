@@ -0,0 +1,111 @@
+#include "mock_ldl_chip.h"
+
+#include <string.h>
+
+void mock_chip_init(struct mock_chip *self, bool registers)
+{
+    (void)memset(self, 0, sizeof(*self));
+
+    self->registers = registers;
+}
+
+void mock_chip_clear(struct mock_chip *self)
+{
+    self->count = 0U;
+    self->transactions = 0U;
+}
+
+bool mock_chip_write(void *self, const void *opcode, size_t opcode_size, const void *data, size_t size)
+{
+    struct mock_chip *c = (struct mock_chip *)self;
+    uint8_t op = *(const uint8_t *)opcode;
+    size_t i;
+
+    (void)opcode_size;
+
+    if(c->count < MOCK_CHIP_MAX_WRITES){
+
+        c->writes[c->count] = c->registers ? (op & 0x7fU) : op;
+        c->count++;
+    }
+
+    c->transactions++;
+
+    /* the FIFO address does not increment */
+    for(i=0U; c->registers && ((op & 0x7fU) > 0U) && (i < size); i++){
+
+        c->regs[(op & 0x7fU) + i] = ((const uint8_t *)data)[i];
+    }
+
+    return !c->fail;
+}
+
+bool mock_chip_read(void *self, const void *opcode, size_t opcode_size, void *data, size_t size)
+{
+    struct mock_chip *c = (struct mock_chip *)self;
+
+    (void)opcode_size;
+
+    c->transactions++;
+
+    if(c->registers){
+
+        (void)memcpy(data, &c->regs[*(const uint8_t *)opcode & 0x7fU], size);
+    }
+    else{
+
+        (void)memset(data, 0, size);
+    }
+
+    return true;
+}
+
+void mock_chip_set_mode(void *self, enum ldl_chip_mode mode)
+{
+    (void)self;
+    (void)mode;
+}
+
+void mock_chip_rx_settings(struct ldl_radio_rx_setting *value, uint32_t freq, enum ldl_spreading_factor sf)
+{
+    (void)memset(value, 0, sizeof(*value));
+
+    value->freq = freq;
+    value->sf = sf;
+    value->bw = LDL_BW_125;
+    value->timeout = 8U;
+    value->max = 64U;
+}
+
+void mock_chip_tx_settings(struct ldl_radio_tx_setting *value, uint32_t freq, enum ldl_spreading_factor sf)
+{
+    (void)memset(value, 0, sizeof(*value));
+
+    value->freq = freq;
+    value->sf = sf;
+    value->bw = LDL_BW_125;
+    value->eirp = 1400;
+}
+
+void mock_chip_go(struct ldl_radio *radio, enum ldl_radio_mode mode)
+{
+    LDL_Radio_getInterface(radio)->set_mode(radio, mode);
+}
+
+size_t mock_chip_receive(struct mock_chip *self, struct ldl_radio *radio, const struct ldl_radio_rx_setting *value)
+{
+    mock_chip_clear(self);
+
+    LDL_Radio_getInterface(radio)->receive(radio, value);
+
+    return self->transactions;
+}
+
+size_t mock_chip_transmit(struct mock_chip *self, struct ldl_radio *radio, const struct ldl_radio_tx_setting *value, const void *data, uint8_t len)
+{
+    mock_chip_clear(self);
+
+    LDL_Radio_getInterface(radio)->transmit(radio, value, data, len);
+
+    return self->transactions;
+}
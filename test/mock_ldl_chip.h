@@ -0,0 +1,65 @@
+#ifndef MOCK_LDL_CHIP_H
+#define MOCK_LDL_CHIP_H
+
+/* a chip that records what a radio driver writes to it
+ *
+ * Pass the mock as the chip pointer together with mock_chip_write,
+ * mock_chip_read and mock_chip_set_mode.
+ *
+ * With registers set, writes go into an SX127x register map and reads
+ * come back from it. Otherwise reads return zeros, which is enough
+ * for the SX126x.
+ *
+ * */
+
+#include "ldl_chip.h"
+#include "ldl_radio.h"
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#define MOCK_CHIP_MAX_WRITES 64U
+
+struct mock_chip {
+
+    /* SX127x register map (if registers is true) */
+    bool registers;
+    uint8_t regs[0x80];
+
+    /* first byte of the opcode for each write (the register for SX127x) */
+    uint8_t writes[MOCK_CHIP_MAX_WRITES];
+    size_t count;
+
+    /* writes and reads */
+    size_t transactions;
+
+    /* every write reports failure */
+    bool fail;
+};
+
+void mock_chip_init(struct mock_chip *self, bool registers);
+
+/* forget the writes and transactions recorded so far */
+void mock_chip_clear(struct mock_chip *self);
+
+bool mock_chip_write(void *self, const void *opcode, size_t opcode_size, const void *data, size_t size);
+bool mock_chip_read(void *self, const void *opcode, size_t opcode_size, void *data, size_t size);
+void mock_chip_set_mode(void *self, enum ldl_chip_mode mode);
+
+/* settings for an RX window or a TX at 125KHz */
+void mock_chip_rx_settings(struct ldl_radio_rx_setting *value, uint32_t freq, enum ldl_spreading_factor sf);
+void mock_chip_tx_settings(struct ldl_radio_tx_setting *value, uint32_t freq, enum ldl_spreading_factor sf);
+
+/* change mode through the radio interface */
+void mock_chip_go(struct ldl_radio *radio, enum ldl_radio_mode mode);
+
+/* clear, then receive or transmit through the radio interface
+ *
+ * returns the number of transactions with the chip
+ *
+ * */
+size_t mock_chip_receive(struct mock_chip *self, struct ldl_radio *radio, const struct ldl_radio_rx_setting *value);
+size_t mock_chip_transmit(struct mock_chip *self, struct ldl_radio *radio, const struct ldl_radio_tx_setting *value, const void *data, uint8_t len);
+
+#endif
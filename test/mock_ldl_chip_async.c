@@ -0,0 +1,118 @@
+#include "mock_ldl_chip_async.h"
+#include "mock_ldl_system.h"
+
+#include <string.h>
+
+static void complete(struct mock_chip_async *self);
+
+void mock_chip_async_init(struct mock_chip_async *self, void *chip, ldl_chip_write_fn write, ldl_chip_read_fn read, uint32_t latency)
+{
+    (void)memset(self, 0, sizeof(*self));
+
+    self->chip = chip;
+    self->write = write;
+    self->read = read;
+    self->latency = latency;
+}
+
+bool mock_chip_async_write(void *self, const void *opcode, size_t opcode_size, const void *data, size_t size)
+{
+    struct mock_chip_async *mock = (struct mock_chip_async *)self;
+
+    if(mock->busy){
+
+        mock->waited++;
+        complete(mock);
+    }
+
+    return mock->write(mock->chip, opcode, opcode_size, data, size);
+}
+
+bool mock_chip_async_read(void *self, const void *opcode, size_t opcode_size, void *data, size_t size)
+{
+    struct mock_chip_async *mock = (struct mock_chip_async *)self;
+
+    if(mock->busy){
+
+        mock->waited++;
+        complete(mock);
+    }
+
+    return mock->read(mock->chip, opcode, opcode_size, data, size);
+}
+
+bool mock_chip_async_submit(void *self, const struct ldl_chip_transfer *transfer, size_t count, ldl_chip_complete_fn cb, void *ctx)
+{
+    struct mock_chip_async *mock = (struct mock_chip_async *)self;
+    bool retval = false;
+
+    if(!mock->busy && !mock->refuse){
+
+        mock->busy = true;
+        mock->due = LDL_System_ticks(NULL) + mock->latency;
+        mock->transfer = transfer;
+        mock->count = count;
+        mock->cb = cb;
+        mock->ctx = ctx;
+
+        mock->submitted++;
+        mock->transfers += (unsigned)count;
+
+        retval = true;
+    }
+
+    return retval;
+}
+
+uint32_t mock_chip_async_ticksUntilComplete(const struct mock_chip_async *self)
+{
+    uint32_t retval = UINT32_MAX;
+    uint32_t delta;
+
+    if(self->busy){
+
+        delta = self->due - LDL_System_ticks(NULL);
+
+        retval = (delta > (uint32_t)INT32_MAX) ? 0U : delta;
+    }
+
+    return retval;
+}
+
+void mock_chip_async_process(struct mock_chip_async *self)
+{
+    if(self->busy && (mock_chip_async_ticksUntilComplete(self) == 0U)){
+
+        complete(self);
+    }
+}
+
+/* static functions ***************************************************/
+
+static void complete(struct mock_chip_async *self)
+{
+    bool ok = true;
+    size_t i;
+
+    if(self->fail){
+
+        /* the first transfer goes through and the chip gets stuck */
+        self->fail = false;
+
+        (void)self->write(self->chip, self->transfer[0].opcode, self->transfer[0].opcode_size, self->transfer[0].data, self->transfer[0].size);
+
+        ok = false;
+    }
+    else{
+
+        for(i=0U; i < self->count; i++){
+
+            ok = self->write(self->chip, self->transfer[i].opcode, self->transfer[i].opcode_size, self->transfer[i].data, self->transfer[i].size);
+            if(!ok){ break; }
+        }
+    }
+
+    self->busy = false;
+
+    self->cb(self->ctx, ok);
+}
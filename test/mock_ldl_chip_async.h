@@ -0,0 +1,66 @@
+#ifndef MOCK_LDL_CHIP_ASYNC_H
+#define MOCK_LDL_CHIP_ASYNC_H
+
+/* a chip interface that takes a while to carry out a submission
+ *
+ * Transfers are passed to the blocking chip interface it wraps once
+ * latency ticks (from LDL_System_ticks()) have passed and
+ * mock_chip_async_process() is called.
+ *
+ * Pass the mock as the chip pointer together with mock_chip_async_write,
+ * mock_chip_async_read and mock_chip_async_submit. Blocking writes and
+ * reads complete an outstanding submission first, as a real chip
+ * interface would by waiting for it.
+ *
+ * */
+
+#include "ldl_chip.h"
+
+#include <stdbool.h>
+#include <stdint.h>
+
+struct mock_chip_async {
+
+    /* the chip interface that does the work */
+    void *chip;
+    ldl_chip_write_fn write;
+    ldl_chip_read_fn read;
+
+    uint32_t latency;
+
+    /* refuse every submission */
+    bool refuse;
+
+    /* report the next submission as failed */
+    bool fail;
+
+    bool busy;
+    uint32_t due;
+    const struct ldl_chip_transfer *transfer;
+    size_t count;
+    ldl_chip_complete_fn cb;
+    void *ctx;
+
+    /* number of submissions that were accepted */
+    unsigned submitted;
+
+    /* number of transfers in accepted submissions */
+    unsigned transfers;
+
+    /* number of blocking calls that had to wait for a submission */
+    unsigned waited;
+};
+
+void mock_chip_async_init(struct mock_chip_async *self, void *chip, ldl_chip_write_fn write, ldl_chip_read_fn read, uint32_t latency);
+
+bool mock_chip_async_write(void *self, const void *opcode, size_t opcode_size, const void *data, size_t size);
+bool mock_chip_async_read(void *self, const void *opcode, size_t opcode_size, void *data, size_t size);
+bool mock_chip_async_submit(void *self, const struct ldl_chip_transfer *transfer, size_t count, ldl_chip_complete_fn cb, void *ctx);
+
+/* ticks until the outstanding submission is due (UINT32_MAX if idle) */
+uint32_t mock_chip_async_ticksUntilComplete(const struct mock_chip_async *self);
+
+/* carry out the outstanding submission if it is due */
+void mock_chip_async_process(struct mock_chip_async *self);
+
+#endif
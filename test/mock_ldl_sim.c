@@ -0,0 +1,300 @@
+#include "mock_ldl_sim.h"
+#include "mock_ldl_system.h"
+
+#include <string.h>
+
+extern uint32_t system_time;
+
+static void radioSetMode(struct ldl_radio *self, enum ldl_radio_mode mode);
+static uint32_t radioReadEntropy(struct ldl_radio *self);
+static uint8_t radioReadBuffer(struct ldl_radio *self, struct ldl_radio_packet_metadata *meta, void *data, uint8_t max);
+static void radioTransmit(struct ldl_radio *self, const struct ldl_radio_tx_setting *settings, const void *data, uint8_t len);
+static void radioReceive(struct ldl_radio *self, const struct ldl_radio_rx_setting *settings);
+static void radioReceiveEntropy(struct ldl_radio *self);
+static void radioGetStatus(struct ldl_radio *self, struct ldl_radio_status *status);
+static void radioInterrupt(struct mock_sim *self, void *arg);
+
+static void digest(struct mock_sim *self, const void *data, size_t size);
+static void digestU32(struct mock_sim *self, uint32_t value);
+static uint32_t quarterTime(const struct mock_sim *self, enum ldl_spreading_factor sf, enum ldl_signal_bandwidth bw, uint32_t quarters);
+
+static const struct ldl_radio_interface radio_interface = {
+    .set_mode = radioSetMode,
+    .read_entropy = radioReadEntropy,
+    .read_buffer = radioReadBuffer,
+    .transmit = radioTransmit,
+    .receive = radioReceive,
+    .receive_entropy = radioReceiveEntropy,
+    .get_status = radioGetStatus
+};
+
+/* the radio pointer the MAC passes back is the sim */
+#define SIM(RADIO) ((struct mock_sim *)(void *)(RADIO))
+
+/* functions **********************************************************/
+
+void mock_sim_init(struct mock_sim *self, struct ldl_mac *mac, uint32_t tps, uint32_t seed)
+{
+    (void)memset(self, 0, sizeof(*self));
+
+    self->mac = mac;
+    self->tps = tps;
+
+    /* xorshift gets stuck on zero */
+    self->seed = (seed == 0U) ? 1U : seed;
+
+    self->digest = 0x811c9dc5UL;
+
+    system_time = 0U;
+}
+
+void mock_sim_initArg(struct mock_sim *self, struct ldl_mac_init_arg *arg)
+{
+    arg->app = self;
+    arg->radio = (struct ldl_radio *)(void *)self;
+    arg->radio_interface = &radio_interface;
+    arg->ticks = mock_sim_ticks;
+    arg->rand = mock_sim_rand;
+#ifndef LDL_PARAM_TPS
+    arg->tps = self->tps;
+#endif
+}
+
+uint32_t mock_sim_ticks(void *app)
+{
+    return (uint32_t)((struct mock_sim *)app)->time;
+}
+
+uint32_t mock_sim_rand(void *app)
+{
+    struct mock_sim *self = (struct mock_sim *)app;
+
+    self->seed ^= self->seed << 13;
+    self->seed ^= self->seed >> 17;
+    self->seed ^= self->seed << 5;
+
+    return self->seed;
+}
+
+void mock_sim_schedule(struct mock_sim *self, uint32_t delay, mock_sim_event_fn fn, void *arg)
+{
+    struct mock_sim_event event;
+    uint8_t i;
+
+    LDL_PEDANTIC(self->queued < MOCK_SIM_MAX_EVENTS)
+
+    event.due = self->time + delay;
+    event.fn = fn;
+    event.arg = arg;
+
+    for(i=self->queued; (i > 0U) && (self->queue[i-1U].due > event.due); i--){
+
+        self->queue[i] = self->queue[i-1U];
+    }
+
+    self->queue[i] = event;
+    self->queued++;
+}
+
+void mock_sim_cancel(struct mock_sim *self, mock_sim_event_fn fn)
+{
+    uint8_t i;
+    uint8_t kept = 0U;
+
+    for(i=0U; i < self->queued; i++){
+
+        if(self->queue[i].fn != fn){
+
+            self->queue[kept] = self->queue[i];
+            kept++;
+        }
+    }
+
+    self->queued = kept;
+}
+
+uint32_t mock_sim_airTime(const struct mock_sim *self, enum ldl_spreading_factor sf, enum ldl_signal_bandwidth bw, uint8_t size, bool crc)
+{
+    /* low data rate optimisation */
+    uint32_t de = ((bw == LDL_BW_125) && (sf >= LDL_SF_11)) ? 1U : 0U;
+    int32_t bits = (8 * (int32_t)size) - (4 * (int32_t)sf) + 28 + (crc ? 16 : 0);
+    uint32_t per = 4U * ((uint32_t)sf - (2U * de));
+    uint32_t payload = 8U;
+
+    if(bits > 0){
+
+        /* coding rate 4/5 */
+        payload += (((uint32_t)bits + per - 1U) / per) * 5U;
+    }
+
+    /* preamble is 12.25 symbols */
+    return quarterTime(self, sf, bw, ((payload + 12U) * 4U) + 1U);
+}
+
+void mock_sim_run(struct mock_sim *self, uint64_t duration)
+{
+    uint64_t end = self->time + duration;
+    uint64_t next;
+    uint32_t ticks;
+    struct mock_sim_event event;
+
+    for(;;){
+
+        system_time = (uint32_t)self->time;
+
+        LDL_MAC_process(self->mac);
+
+        self->steps++;
+
+        ticks = LDL_MAC_ticksUntilNextEvent(self->mac);
+
+        if(ticks == 0U){
+
+            continue;
+        }
+
+        next = (ticks == UINT32_MAX) ? UINT64_MAX : (self->time + ticks);
+
+        if((self->queued > 0U) && (self->queue[0].due < next)){
+
+            next = self->queue[0].due;
+        }
+
+        if(next > end){
+
+            self->time = end;
+            system_time = (uint32_t)self->time;
+            break;
+        }
+
+        self->time = next;
+        system_time = (uint32_t)self->time;
+
+        while((self->queued > 0U) && (self->queue[0].due <= self->time)){
+
+            event = self->queue[0];
+
+            self->queued--;
+            (void)memmove(self->queue, &self->queue[1], self->queued * sizeof(*self->queue));
+
+            event.fn(self, event.arg);
+        }
+    }
+}
+
+/* static functions ***************************************************/
+
+static void radioSetMode(struct ldl_radio *self, enum ldl_radio_mode mode)
+{
+    /* anything outstanding was for the previous mode */
+    mock_sim_cancel(SIM(self), radioInterrupt);
+
+    digestU32(SIM(self), (uint32_t)mode);
+}
+
+static uint32_t radioReadEntropy(struct ldl_radio *self)
+{
+    return mock_sim_rand(SIM(self));
+}
+
+static uint8_t radioReadBuffer(struct ldl_radio *self, struct ldl_radio_packet_metadata *meta, void *data, uint8_t max)
+{
+    (void)self;
+    (void)data;
+    (void)max;
+
+    (void)memset(meta, 0, sizeof(*meta));
+
+    return 0U;
+}
+
+static void radioTransmit(struct ldl_radio *self, const struct ldl_radio_tx_setting *settings, const void *data, uint8_t len)
+{
+    struct mock_sim *sim = SIM(self);
+    uint32_t airTime = mock_sim_airTime(sim, settings->sf, settings->bw, len, true);
+
+    sim->txCount++;
+    sim->airTime += airTime;
+
+    digestU32(sim, settings->freq);
+    digestU32(sim, (uint32_t)settings->sf);
+    digestU32(sim, (uint32_t)settings->bw);
+    digest(sim, data, len);
+
+    mock_sim_cancel(sim, radioInterrupt);
+    mock_sim_schedule(sim, airTime, radioInterrupt, NULL);
+
+    (void)memset(&sim->status, 0, sizeof(sim->status));
+    sim->status.tx = true;
+}
+
+static void radioReceive(struct ldl_radio *self, const struct ldl_radio_rx_setting *settings)
+{
+    struct mock_sim *sim = SIM(self);
+
+    sim->rxCount++;
+
+    digestU32(sim, settings->freq);
+    digestU32(sim, (uint32_t)settings->sf);
+    digestU32(sim, (uint32_t)settings->bw);
+
+    /* nobody is listening to the uplinks */
+    mock_sim_cancel(sim, radioInterrupt);
+    mock_sim_schedule(sim, quarterTime(sim, settings->sf, settings->bw, (uint32_t)settings->timeout * 4U), radioInterrupt, NULL);
+
+    (void)memset(&sim->status, 0, sizeof(sim->status));
+    sim->status.timeout = true;
+}
+
+static void radioReceiveEntropy(struct ldl_radio *self)
+{
+    (void)self;
+}
+
+static void radioGetStatus(struct ldl_radio *self, struct ldl_radio_status *status)
+{
+    *status = SIM(self)->status;
+}
+
+static void radioInterrupt(struct mock_sim *self, void *arg)
+{
+    (void)arg;
+
+    digestU32(self, (uint32_t)self->time);
+    digestU32(self, (uint32_t)(self->time >> 32));
+
+    LDL_MAC_radioEvent(self->mac);
+}
+
+static void digest(struct mock_sim *self, const void *data, size_t size)
+{
+    const uint8_t *ptr = (const uint8_t *)data;
+    size_t i;
+
+    for(i=0U; i < size; i++){
+
+        self->digest ^= ptr[i];
+        self->digest *= 0x01000193UL;
+    }
+}
+
+static void digestU32(struct mock_sim *self, uint32_t value)
+{
+    uint8_t buf[4U];
+
+    buf[0] = (uint8_t)value;
+    buf[1] = (uint8_t)(value >> 8);
+    buf[2] = (uint8_t)(value >> 16);
+    buf[3] = (uint8_t)(value >> 24);
+
+    digest(self, buf, sizeof(buf));
+}
+
+/* ticks for quarter symbols (rounded up) */
+static uint32_t quarterTime(const struct mock_sim *self, enum ldl_spreading_factor sf, enum ldl_signal_bandwidth bw, uint32_t quarters)
+{
+    uint64_t chips = (uint64_t)quarters << (uint32_t)sf;
+    uint64_t hz = (uint64_t)LDL_Radio_bwToNumber(bw) * 4U;
+
+    return (uint32_t)(((chips * self->tps) + hz - 1U) / hz);
+}
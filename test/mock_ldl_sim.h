@@ -0,0 +1,89 @@
+#ifndef MOCK_LDL_SIM_H
+#define MOCK_LDL_SIM_H
+
+/* virtual time for running the MAC through hours or days of events
+ *
+ * Time only moves when mock_sim_run() jumps to whichever comes first:
+ * LDL_MAC_ticksUntilNextEvent() or the head of the event queue.
+ * Nothing depends on the host clock so a run with the same seed
+ * always produces the same result.
+ *
+ * The simulated radio completes a TX after the LoRa air time and
+ * times out every RX window after the symbol timeout it was given.
+ *
+ * Pass the sim as ldl_mac_init_arg.app and ldl_mac_init_arg.radio
+ * (mock_sim_initArg() does this).
+ *
+ * */
+
+#include "ldl_mac.h"
+#include "ldl_radio.h"
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#define MOCK_SIM_MAX_EVENTS 8U
+
+struct mock_sim;
+
+typedef void (*mock_sim_event_fn)(struct mock_sim *self, void *arg);
+
+struct mock_sim_event {
+
+    uint64_t due;
+    mock_sim_event_fn fn;
+    void *arg;
+};
+
+struct mock_sim {
+
+    struct ldl_mac *mac;
+
+    /* free for the scenario */
+    void *user;
+
+    uint32_t tps;
+
+    /* ticks since mock_sim_init() (system_time is the lower 32 bits) */
+    uint64_t time;
+
+    uint32_t seed;
+
+    /* ordered by due time (first in, first out for the same time) */
+    struct mock_sim_event queue[MOCK_SIM_MAX_EVENTS];
+    uint8_t queued;
+
+    struct ldl_radio_status status;
+
+    /* statistics */
+    unsigned steps;
+    unsigned txCount;
+    unsigned rxCount;
+    uint64_t airTime;
+
+    /* FNV-1a over every radio operation and its time */
+    uint32_t digest;
+};
+
+void mock_sim_init(struct mock_sim *self, struct ldl_mac *mac, uint32_t tps, uint32_t seed);
+
+/* fill in the parts of arg that the sim provides */
+void mock_sim_initArg(struct mock_sim *self, struct ldl_mac_init_arg *arg);
+
+/* for ldl_mac_init_arg.ticks and ldl_mac_init_arg.rand (app is the sim) */
+uint32_t mock_sim_ticks(void *app);
+uint32_t mock_sim_rand(void *app);
+
+/* call fn from mock_sim_run() after delay ticks */
+void mock_sim_schedule(struct mock_sim *self, uint32_t delay, mock_sim_event_fn fn, void *arg);
+
+/* remove every event that would call fn */
+void mock_sim_cancel(struct mock_sim *self, mock_sim_event_fn fn);
+
+/* LoRa air time in ticks */
+uint32_t mock_sim_airTime(const struct mock_sim *self, enum ldl_spreading_factor sf, enum ldl_signal_bandwidth bw, uint8_t size, bool crc);
+
+/* run the MAC and the event queue for duration ticks */
+void mock_sim_run(struct mock_sim *self, uint64_t duration);
+
+#endif
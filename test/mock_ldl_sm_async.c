@@ -0,0 +1,95 @@
+#include "mock_ldl_sm_async.h"
+#include "mock_ldl_system.h"
+
+#include <string.h>
+
+static uint32_t mic(struct ldl_sm *self, enum ldl_sm_key desc, const void *hdr, uint8_t hdrLen, const void *data, uint8_t dataLen);
+static bool beginMIC(struct ldl_sm *self, enum ldl_sm_key desc, const void *hdr, uint8_t hdrLen, const void *data, uint8_t dataLen, struct ldl_mac *mac, ldl_sm_mic_fn cb);
+
+static const struct ldl_sm_interface interface = {
+    .update_session_key = LDL_SM_updateSessionKey,
+    .mic = mic,
+    .ecb = LDL_SM_ecb,
+    .ctr = LDL_SM_ctr,
+    .begin_mic = beginMIC
+};
+
+void mock_sm_async_init(struct mock_sm_async *self, const void *key, uint32_t latency)
+{
+    size_t i;
+
+    (void)memset(self, 0, sizeof(*self));
+
+    self->latency = latency;
+
+    for(i=0U; i < sizeof(self->sm.keys)/sizeof(*self->sm.keys); i++){
+
+        (void)memcpy(self->sm.keys[i].value, key, sizeof(self->sm.keys[i].value));
+#ifdef LDL_ENABLE_SM_KEY_CACHE
+        LDL_AES_init(&self->sm.keys[i].ctx, self->sm.keys[i].value);
+        LDL_CMAC_subkeys(&self->sm.keys[i].subkeys, &self->sm.keys[i].ctx);
+#endif
+    }
+}
+
+const struct ldl_sm_interface *mock_sm_async_getInterface(void)
+{
+    return &interface;
+}
+
+uint32_t mock_sm_async_ticksUntilComplete(const struct mock_sm_async *self)
+{
+    uint32_t retval = UINT32_MAX;
+    uint32_t delta;
+
+    if(self->busy){
+
+        delta = self->due - LDL_System_ticks(NULL);
+
+        retval = (delta > (uint32_t)INT32_MAX) ? 0U : delta;
+    }
+
+    return retval;
+}
+
+void mock_sm_async_process(struct mock_sm_async *self)
+{
+    if(self->busy && (mock_sm_async_ticksUntilComplete(self) == 0U)){
+
+        self->busy = false;
+
+        self->cb(self->mac, self->mic);
+    }
+}
+
+/* static functions ***************************************************/
+
+static uint32_t mic(struct ldl_sm *self, enum ldl_sm_key desc, const void *hdr, uint8_t hdrLen, const void *data, uint8_t dataLen)
+{
+    struct mock_sm_async *mock = (struct mock_sm_async *)self;
+
+    mock->blocking++;
+
+    return LDL_SM_mic(self, desc, hdr, hdrLen, data, dataLen);
+}
+
+static bool beginMIC(struct ldl_sm *self, enum ldl_sm_key desc, const void *hdr, uint8_t hdrLen, const void *data, uint8_t dataLen, struct ldl_mac *mac, ldl_sm_mic_fn cb)
+{
+    struct mock_sm_async *mock = (struct mock_sm_async *)self;
+    bool retval = false;
+
+    if(!mock->refuse && !mock->busy){
+
+        /* hdr and data are not valid after this call returns */
+        mock->mic = LDL_SM_mic(self, desc, hdr, hdrLen, data, dataLen);
+        mock->mac = mac;
+        mock->cb = cb;
+        mock->due = LDL_System_ticks(NULL) + mock->latency;
+        mock->busy = true;
+        mock->started++;
+
+        retval = true;
+    }
+
+    return retval;
+}
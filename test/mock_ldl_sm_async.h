@@ -0,0 +1,51 @@
+#ifndef MOCK_LDL_SM_ASYNC_H
+#define MOCK_LDL_SM_ASYNC_H
+
+/* a secure element that takes a while to calculate a MIC
+ *
+ * The default SM does the work but the result is held back until
+ * latency ticks (from LDL_System_ticks()) have passed and
+ * mock_sm_async_process() is called.
+ *
+ * */
+
+#include "ldl_sm.h"
+#include "ldl_sm_internal.h"
+
+#include <stdbool.h>
+#include <stdint.h>
+
+struct mock_sm_async {
+
+    /* must be first since the interface is passed a pointer to this */
+    struct ldl_sm sm;
+
+    uint32_t latency;
+
+    /* begin_mic always returns false (as if the SE could not start) */
+    bool refuse;
+
+    bool busy;
+    uint32_t due;
+    uint32_t mic;
+    struct ldl_mac *mac;
+    ldl_sm_mic_fn cb;
+
+    /* number of begin_mic calls that were accepted */
+    unsigned started;
+
+    /* number of mic calls */
+    unsigned blocking;
+};
+
+void mock_sm_async_init(struct mock_sm_async *self, const void *key, uint32_t latency);
+
+const struct ldl_sm_interface *mock_sm_async_getInterface(void);
+
+/* ticks until the outstanding result is due (UINT32_MAX if idle) */
+uint32_t mock_sm_async_ticksUntilComplete(const struct mock_sm_async *self);
+
+/* deliver the outstanding result if it is due */
+void mock_sm_async_process(struct mock_sm_async *self);
+
+#endif
@@ -37,6 +37,35 @@ uint32_t LDL_System_getBatteryLevel(void *receiver)
     return self->battery_level;
 }
 
+static bool critical;
+
+void mock_critical_enter(void *app)
+{
+    (void)app;
+
+    if(critical){
+
+        /* the outer section won't be left so start the next test clean */
+        critical = false;
+
+        fail_msg("critical section is already held");
+    }
+
+    critical = true;
+}
+
+void mock_critical_leave(void *app)
+{
+    (void)app;
+
+    if(!critical){
+
+        fail_msg("critical section is not held");
+    }
+
+    critical = false;
+}
+
 FILE * trace_desc;
 
 void print_hex(FILE * fd, const uint8_t *data, size_t size)
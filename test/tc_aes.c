@@ -36,11 +36,31 @@ static void test_LDL_AES_encrypt(void **user)
     assert_memory_equal(ct, out, sizeof(ct));
 }
 
+static void test_LDL_AES_encrypt_fips197(void **user)
+{
+    (void)user;
+
+    /* FIPS-197 appendix C.1 */
+    static const uint8_t key[] = {0x00,0x01,0x02,0x03,0x04,0x05,0x06,0x07,0x08,0x09,0x0a,0x0b,0x0c,0x0d,0x0e,0x0f};
+    static const uint8_t pt[] = {0x00,0x11,0x22,0x33,0x44,0x55,0x66,0x77,0x88,0x99,0xaa,0xbb,0xcc,0xdd,0xee,0xff};
+    static const uint8_t ct[] = {0x69,0xc4,0xe0,0xd8,0x6a,0x7b,0x04,0x30,0xd8,0xcd,0xb7,0x80,0x70,0xb4,0xc5,0x5a};
+
+    struct ldl_aes_ctx aes;
+    uint8_t out[16U];
+
+    memcpy(out, pt, sizeof(out));
+    LDL_AES_init(&aes, key);
+    LDL_AES_encrypt(&aes, out);
+
+    assert_memory_equal(ct, out, sizeof(ct));
+}
+
 int main(void)
 {
     const struct CMUnitTest tests[] = {
         cmocka_unit_test(test_LDL_AES_init),
-        cmocka_unit_test(test_LDL_AES_encrypt)
+        cmocka_unit_test(test_LDL_AES_encrypt),
+        cmocka_unit_test(test_LDL_AES_encrypt_fips197)
     };
 
     return cmocka_run_group_tests(tests, NULL, NULL);
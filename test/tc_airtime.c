@@ -0,0 +1,216 @@
+#include <stdarg.h>
+#include <stddef.h>
+#include <setjmp.h>
+
+#include "cmocka.h"
+
+#include "debug_include.h"
+
+#include "ldl_mac.h"
+#include "ldl_frame.h"
+#include "ldl_radio.h"
+#include "ldl_region.h"
+#include "ldl_sm.h"
+#include "mock_ldl_system.h"
+
+#include <string.h>
+
+extern uint32_t system_time;
+
+/* air time compared against the formula in 4.1.1.7 of the sx1272
+ * datasheet (explicit header, CR 4/5, 8 preamble symbols)
+ *
+ * LDL_Radio_getAirTime() is checked directly and the MAC (which counts
+ * air time in quarter symbols) is checked by running an uplink up to
+ * the start of TX
+ *
+ * */
+
+static const uint8_t payload[UINT8_MAX];
+
+static struct ldl_sm sm;
+
+static struct ldl_radio_tx_setting tx_setting;
+static uint8_t tx_len;
+static bool tx_started;
+
+static void set_mode(struct ldl_radio *self, enum ldl_radio_mode mode)
+{
+    (void)self;
+    (void)mode;
+}
+
+static void transmit(struct ldl_radio *self, const struct ldl_radio_tx_setting *settings, const void *data, uint8_t len)
+{
+    (void)self;
+    (void)data;
+
+    tx_setting = *settings;
+    tx_len = len;
+    tx_started = true;
+}
+
+static const struct ldl_radio_interface radio_interface = {
+    .set_mode = set_mode,
+    .transmit = transmit
+};
+
+/* exact air time in microseconds */
+static uint32_t referenceAirTime(enum ldl_spreading_factor sf, enum ldl_signal_bandwidth bw, uint8_t size, bool crc)
+{
+    uint32_t Ts;
+    int32_t numerator;
+    int32_t denom;
+    int32_t blocks;
+    bool de;
+
+    de = (bw == LDL_BW_125) && (sf >= LDL_SF_11);
+
+    Ts = (UINT32_C(1) << sf) * UINT32_C(1000000) / LDL_Radio_bwToNumber(bw);
+
+    numerator = (8 * (int32_t)size) - (4 * (int32_t)sf) + 28 + (crc ? 16 : 0);
+    denom = 4 * ((int32_t)sf - (de ? 2 : 0));
+
+    blocks = (numerator > 0) ? ((numerator + denom - 1) / denom) : 0;
+
+    /* (12.25 + 8 + (blocks x 5)) symbols */
+    return ((UINT32_C(49) + (UINT32_C(4) * (UINT32_C(8) + ((uint32_t)blocks * UINT32_C(5))))) * Ts) / UINT32_C(4);
+}
+
+static void setup(struct ldl_mac *self, enum ldl_region region)
+{
+    struct ldl_mac_init_arg arg;
+
+    (void)memset(&arg, 0, sizeof(arg));
+
+    system_time = 0U;
+    tx_started = false;
+
+    arg.radio_interface = &radio_interface;
+    arg.sm = &sm;
+    arg.sm_interface = LDL_SM_getInterface();
+    arg.ticks = LDL_System_ticks;
+    arg.tps = 1000000UL;
+
+    LDL_MAC_init(self, region, &arg);
+
+    /* pretend to have booted, joined and waited out the startup delay */
+    self->ctx.joined = true;
+    self->band[LDL_BAND_GLOBAL] = 0U;
+    self->state = LDL_STATE_IDLE;
+}
+
+/* run an uplink until the radio is told to transmit */
+static void uplink(struct ldl_mac *self, uint8_t len)
+{
+    uint8_t i;
+
+    assert_int_equal(LDL_STATUS_OK, LDL_MAC_unconfirmedData(self, 1U, payload, len, NULL));
+
+    for(i=0U; !tx_started && (i < 10U); i++){
+
+        system_time += LDL_MAC_ticksUntilNextEvent(self);
+
+        LDL_MAC_process(self);
+    }
+
+    assert_true(tx_started);
+    assert_int_equal(LDL_STATE_TX, self->state);
+}
+
+static void check_mac(enum ldl_region region, uint8_t minRate, uint8_t maxRate)
+{
+    struct ldl_mac self;
+    enum ldl_spreading_factor sf;
+    enum ldl_signal_bandwidth bw;
+    uint8_t mtu;
+    uint8_t rate;
+    uint8_t len;
+    uint32_t exact;
+
+    for(rate=minRate; rate <= maxRate; rate++){
+
+        LDL_Region_convertRate(region, rate, &sf, &bw, &mtu);
+
+        mtu -= LDL_Frame_dataOverhead();
+        len = 0U;
+
+        do{
+
+            setup(&self, region);
+
+            assert_int_equal(LDL_STATUS_OK, LDL_MAC_setRate(&self, rate));
+
+            uplink(&self, len);
+
+            /* 'time' is 1/256 of a second and rounds up
+             *
+             * (the channel may have moved the rate into its range) */
+            exact = referenceAirTime(tx_setting.sf, tx_setting.bw, tx_len, true);
+
+            assert_true(self.tx.airTime >= ((exact * UINT32_C(256)) + UINT32_C(999999)) / UINT32_C(1000000));
+            assert_true(self.tx.airTime <= (((exact * UINT32_C(256)) + UINT32_C(999999)) / UINT32_C(1000000)) + UINT32_C(1));
+
+            len++;
+        }
+        while(len <= mtu);
+    }
+}
+
+/* LDL_Radio_getAirTime ***********************************************/
+
+static void getAirTime_shall_match_datasheet(void **user)
+{
+    enum ldl_spreading_factor sf;
+    enum ldl_signal_bandwidth bw;
+    uint32_t size;
+    uint8_t crc;
+
+    (void)user;
+
+    for(sf=LDL_SF_7; sf <= LDL_SF_12; sf++){
+
+        for(bw=LDL_BW_125; bw <= LDL_BW_500; bw++){
+
+            for(size=0U; size <= UINT8_MAX; size++){
+
+                for(crc=0U; crc < 2U; crc++){
+
+                    /* ms rounded up (and then some) */
+                    assert_int_equal((referenceAirTime(sf, bw, (uint8_t)size, crc > 0U) / UINT32_C(1000)) + UINT32_C(1), LDL_Radio_getAirTime(bw, sf, (uint8_t)size, crc > 0U));
+                }
+            }
+        }
+    }
+}
+
+/* MAC ****************************************************************/
+
+static void airTime_shall_not_be_less_than_datasheet_EU(void **user)
+{
+    (void)user;
+
+    /* SF12..SF7 at 125KHz */
+    check_mac(LDL_EU_863_870, 0U, 5U);
+}
+
+static void airTime_shall_not_be_less_than_datasheet_US(void **user)
+{
+    (void)user;
+
+    /* SF10..SF7 at 125KHz and SF8 at 500KHz */
+    check_mac(LDL_US_902_928, 0U, 4U);
+}
+
+int main(void)
+{
+    const struct CMUnitTest tests[] = {
+        cmocka_unit_test(getAirTime_shall_match_datasheet),
+        cmocka_unit_test(airTime_shall_not_be_less_than_datasheet_EU),
+        cmocka_unit_test(airTime_shall_not_be_less_than_datasheet_US),
+    };
+
+    trace_desc = stderr;
+
+    return cmocka_run_group_tests(tests, NULL, NULL);
+}
@@ -0,0 +1,204 @@
+#include <stdarg.h>
+#include <stddef.h>
+#include <setjmp.h>
+
+#include "cmocka.h"
+
+#include "debug_include.h"
+
+#include "ldl_mac.h"
+#include "ldl_radio.h"
+#include "ldl_sm.h"
+#include "mock_ldl_system.h"
+
+#include <string.h>
+
+extern uint32_t system_time;
+
+/* channel selection from the per-band channel maps
+ *
+ * an uplink is requested and the channel chosen is read back from
+ * the MAC without running the radio
+ *
+ * */
+
+static const uint8_t payload[] = "hello";
+
+static const struct ldl_radio_interface radio_interface;
+static struct ldl_sm sm;
+static uint32_t seed;
+
+/* xorshift so that every channel gets a turn */
+static uint32_t fixedRand(void *app)
+{
+    (void)app;
+
+    seed ^= seed << 13;
+    seed ^= seed >> 17;
+    seed ^= seed << 5;
+
+    return seed;
+}
+
+/* setups */
+
+static int setup(void **user, enum ldl_region region)
+{
+    static struct ldl_mac state;
+    struct ldl_mac_init_arg arg;
+
+    (void)memset(&arg, 0, sizeof(arg));
+
+    system_time = 0U;
+    seed = 1U;
+
+    arg.radio_interface = &radio_interface;
+    arg.sm = &sm;
+    arg.sm_interface = LDL_SM_getInterface();
+    arg.ticks = LDL_System_ticks;
+    arg.rand = fixedRand;
+    arg.tps = 1000000UL;
+
+    LDL_MAC_init(&state, region, &arg);
+
+    /* pretend to have booted, joined and waited out the startup delay */
+    state.ctx.joined = true;
+    state.band[LDL_BAND_GLOBAL] = 0U;
+    state.state = LDL_STATE_IDLE;
+
+    *user = (void *)&state;
+
+    return 0;
+}
+
+static int setupEU(void **user)
+{
+    return setup(user, LDL_EU_863_870);
+}
+
+static int setupUS(void **user)
+{
+    return setup(user, LDL_US_902_928);
+}
+
+/* helpers */
+
+static enum ldl_mac_status request(struct ldl_mac *self)
+{
+    enum ldl_mac_status retval;
+
+    retval = LDL_MAC_unconfirmedData(self, 1U, payload, sizeof(payload)-1U, NULL);
+
+    self->op = LDL_OP_NONE;
+
+    return retval;
+}
+
+/* selection **********************************************************/
+
+static void selectChannel_shall_only_select_unmasked_channels(void **user)
+{
+    struct ldl_mac *self = (struct ldl_mac *)(*user);
+    uint8_t seen[16U];
+    uint8_t i;
+
+    (void)memset(seen, 0, sizeof(seen));
+
+    /* large enough for payload */
+    self->ctx.rate = 3U;
+
+    for(i=0U; i < 72U; i++){
+
+        assert_true(LDL_MAC_maskChannel(self, i));
+    }
+
+    for(i=8U; i < 16U; i++){
+
+        assert_true(LDL_MAC_unmaskChannel(self, i));
+    }
+
+    for(i=0U; i < 64U; i++){
+
+        assert_int_equal(LDL_STATUS_OK, request(self));
+
+        assert_in_range(self->tx.chIndex, 8U, 15U);
+
+        seen[self->tx.chIndex] = 1U;
+    }
+
+    for(i=8U; i < 16U; i++){
+
+        assert_int_equal(1U, seen[i]);
+    }
+}
+
+static void selectChannel_shall_not_repeat_last_channel_if_there_is_a_choice(void **user)
+{
+    struct ldl_mac *self = (struct ldl_mac *)(*user);
+    uint8_t last;
+    uint8_t i;
+
+    assert_int_equal(LDL_STATUS_OK, request(self));
+
+    for(i=0U; i < 16U; i++){
+
+        last = self->tx.chIndex;
+
+        assert_int_equal(LDL_STATUS_OK, request(self));
+
+        assert_int_not_equal(last, self->tx.chIndex);
+    }
+}
+
+static void selectChannel_shall_skip_channels_in_busy_bands(void **user)
+{
+    struct ldl_mac *self = (struct ldl_mac *)(*user);
+    uint8_t i;
+
+    /* default channels are all in the 868.0-868.6 band */
+    assert_true(LDL_MAC_addChannel(self, 3U, 869525000UL, 0U, 5U));
+
+    self->band[LDL_BAND_2] = self->time.now + 1000U;
+
+    for(i=0U; i < 8U; i++){
+
+        assert_int_equal(LDL_STATUS_OK, request(self));
+
+        assert_int_equal(3U, self->tx.chIndex);
+    }
+}
+
+static void selectChannel_shall_fail_when_no_band_is_free(void **user)
+{
+    struct ldl_mac *self = (struct ldl_mac *)(*user);
+
+    assert_true(LDL_MAC_addChannel(self, 3U, 869525000UL, 0U, 5U));
+
+    self->band[LDL_BAND_2] = self->time.now + 1000U;
+
+    /* removing the channel takes it out of the map */
+    assert_true(LDL_MAC_addChannel(self, 3U, 0U, 0U, 0U));
+
+    assert_int_equal(LDL_STATUS_NOCHANNEL, request(self));
+    assert_false(LDL_MAC_ready(self));
+
+    /* deadline reached */
+    system_time += 1000000UL * 4U;
+
+    assert_true(LDL_MAC_ready(self));
+    assert_int_equal(LDL_STATUS_OK, request(self));
+}
+
+int main(void)
+{
+    const struct CMUnitTest tests[] = {
+        cmocka_unit_test_setup(selectChannel_shall_only_select_unmasked_channels, setupUS),
+        cmocka_unit_test_setup(selectChannel_shall_not_repeat_last_channel_if_there_is_a_choice, setupEU),
+        cmocka_unit_test_setup(selectChannel_shall_skip_channels_in_busy_bands, setupEU),
+        cmocka_unit_test_setup(selectChannel_shall_fail_when_no_band_is_free, setupEU),
+    };
+
+    trace_desc = stderr;
+
+    return cmocka_run_group_tests(tests, NULL, NULL);
+}
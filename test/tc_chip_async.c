@@ -0,0 +1,290 @@
+#include <stdarg.h>
+#include <stddef.h>
+#include <setjmp.h>
+
+#include "cmocka.h"
+
+#include "debug_include.h"
+
+#include "ldl_radio.h"
+#include "mock_ldl_system.h"
+#include "mock_ldl_chip.h"
+#include "mock_ldl_chip_async.h"
+
+#include <string.h>
+
+extern uint32_t system_time;
+
+/* radio drivers submit the configuration for transmit and receive
+ * in one go and leave the chip interface to carry it out
+ *
+ * */
+
+#define LATENCY     UINT32_C(100)
+
+#define OPCODE_SET_RX                       0x82
+#define OPCODE_SET_RF_FREQUENCY             0x86
+#define OPCODE_SET_PACKET_TYPE              0x8a
+
+struct radio {
+
+    struct ldl_radio radio;
+    struct mock_chip_async async;
+    struct mock_chip chip;
+};
+
+static struct radio a;
+static struct radio b;
+
+static const uint8_t payload[] = "hello world";
+
+/* helpers ************************************************************/
+
+static void init_radio(struct radio *self, enum ldl_radio_type type, bool async)
+{
+    (void)memset(self, 0, sizeof(*self));
+
+    mock_chip_init(&self->chip, (type == LDL_RADIO_SX1276));
+
+    mock_chip_async_init(&self->async, &self->chip, mock_chip_write, mock_chip_read, LATENCY);
+
+    if(type == LDL_RADIO_SX1276){
+
+        struct ldl_sx127x_init_arg arg;
+
+        (void)memset(&arg, 0, sizeof(arg));
+
+        arg.chip = &self->async;
+        arg.chip_write = mock_chip_async_write;
+        arg.chip_read = mock_chip_async_read;
+        arg.chip_set_mode = mock_chip_set_mode;
+        arg.chip_submit = async ? mock_chip_async_submit : NULL;
+
+        LDL_SX1276_init(&self->radio, &arg);
+    }
+    else{
+
+        struct ldl_sx126x_init_arg arg;
+
+        (void)memset(&arg, 0, sizeof(arg));
+
+        arg.chip = &self->async;
+        arg.chip_write = mock_chip_async_write;
+        arg.chip_read = mock_chip_async_read;
+        arg.chip_set_mode = mock_chip_set_mode;
+        arg.chip_submit = async ? mock_chip_async_submit : NULL;
+
+        LDL_SX1262_init(&self->radio, &arg);
+    }
+
+    mock_chip_go(&self->radio, LDL_RADIO_MODE_RESET);
+    mock_chip_go(&self->radio, LDL_RADIO_MODE_BOOT);
+    mock_chip_go(&self->radio, LDL_RADIO_MODE_SLEEP);
+}
+
+static void go(struct radio *self, enum ldl_radio_mode mode)
+{
+    mock_chip_go(&self->radio, mode);
+}
+
+static void receive(struct radio *self, uint32_t freq, enum ldl_spreading_factor sf)
+{
+    struct ldl_radio_rx_setting value;
+
+    mock_chip_rx_settings(&value, freq, sf);
+
+    (void)mock_chip_receive(&self->chip, &self->radio, &value);
+}
+
+static void transmit(struct radio *self, uint32_t freq, enum ldl_spreading_factor sf)
+{
+    struct ldl_radio_tx_setting value;
+
+    mock_chip_tx_settings(&value, freq, sf);
+
+    (void)mock_chip_transmit(&self->chip, &self->radio, &value, payload, sizeof(payload) - 1U);
+}
+
+static void wait(struct radio *self, uint32_t ticks)
+{
+    system_time += ticks;
+
+    mock_chip_async_process(&self->async);
+}
+
+/* setups *************************************************************/
+
+static int setup_sx126x(void **user)
+{
+    system_time = 0U;
+
+    init_radio(&a, LDL_RADIO_SX1262, true);
+
+    go(&a, LDL_RADIO_MODE_RX);
+
+    *user = &a;
+
+    return 0;
+}
+
+/* tests **************************************************************/
+
+static void receive_shall_write_nothing_until_submission_is_complete(void **user)
+{
+    struct radio *self = (struct radio *)(*user);
+
+    receive(self, 868100000UL, LDL_SF_7);
+
+    assert_int_equal(0U, self->chip.count);
+    assert_int_equal(1U, self->async.submitted);
+    assert_true(self->radio.queue.busy);
+
+    wait(self, LATENCY - 1U);
+
+    assert_int_equal(0U, self->chip.count);
+
+    wait(self, 1U);
+
+    /* packet type, calibration, 7 parameters and RX */
+    assert_int_equal(10U, self->chip.count);
+    assert_int_equal(self->async.transfers, self->chip.count);
+    assert_int_equal(OPCODE_SET_PACKET_TYPE, self->chip.writes[0]);
+    assert_int_equal(OPCODE_SET_RX, self->chip.writes[9]);
+    assert_false(self->radio.queue.busy);
+}
+
+static void blocking_access_shall_wait_for_submission(void **user)
+{
+    struct radio *self = (struct radio *)(*user);
+
+    receive(self, 868100000UL, LDL_SF_7);
+
+    (void)LDL_Radio_getInterface(&self->radio)->read_entropy(&self->radio);
+
+    assert_int_equal(1U, self->async.waited);
+    assert_int_equal(10U, self->chip.count);
+    assert_false(self->radio.queue.busy);
+}
+
+static void outstanding_submission_shall_be_followed_by_blocking_writes(void **user)
+{
+    struct radio *self = (struct radio *)(*user);
+
+    receive(self, 868100000UL, LDL_SF_7);
+    receive(self, 868300000UL, LDL_SF_7);
+
+    assert_int_equal(1U, self->async.submitted);
+    assert_int_equal(1U, self->async.waited);
+
+    /* the first write completed the outstanding submission */
+    assert_int_equal(12U, self->chip.count);
+    assert_int_equal(OPCODE_SET_RF_FREQUENCY, self->chip.writes[10]);
+    assert_int_equal(OPCODE_SET_RX, self->chip.writes[11]);
+}
+
+static void refused_submission_shall_be_written_in_order(void **user)
+{
+    struct radio *self = (struct radio *)(*user);
+
+    self->async.refuse = true;
+
+    receive(self, 868100000UL, LDL_SF_7);
+
+    assert_int_equal(0U, self->async.submitted);
+    assert_int_equal(10U, self->chip.count);
+    assert_int_equal(OPCODE_SET_PACKET_TYPE, self->chip.writes[0]);
+    assert_int_equal(OPCODE_SET_RX, self->chip.writes[9]);
+    assert_false(self->radio.queue.busy);
+}
+
+static void failed_submission_shall_be_written_again(void **user)
+{
+    struct radio *self = (struct radio *)(*user);
+
+    self->async.fail = true;
+
+    receive(self, 868100000UL, LDL_SF_7);
+
+    wait(self, LATENCY);
+
+    assert_int_equal(1U, self->chip.count);
+
+    /* nothing is assumed about the chip */
+    receive(self, 868100000UL, LDL_SF_7);
+
+    wait(self, LATENCY);
+
+    assert_int_equal(10U, self->chip.count);
+
+    /* back to normal */
+    receive(self, 868100000UL, LDL_SF_7);
+
+    wait(self, LATENCY);
+
+    assert_int_equal(1U, self->chip.count);
+}
+
+static void sx127x_shall_write_the_same_registers_as_blocking(void **user)
+{
+    size_t i;
+
+    (void)user;
+
+    system_time = 0U;
+
+    init_radio(&a, LDL_RADIO_SX1276, false);
+    init_radio(&b, LDL_RADIO_SX1276, true);
+
+    for(i=0U; i < 2U; i++){
+
+        go(&a, LDL_RADIO_MODE_TX);
+        go(&b, LDL_RADIO_MODE_TX);
+
+        transmit(&a, 868100000UL, LDL_SF_7);
+        transmit(&b, 868100000UL, LDL_SF_7);
+
+        assert_int_equal(0U, b.chip.count);
+
+        wait(&b, LATENCY);
+
+        assert_int_equal(a.chip.count, b.chip.count);
+        assert_memory_equal(a.chip.writes, b.chip.writes, a.chip.count);
+
+        go(&a, LDL_RADIO_MODE_HOLD);
+        go(&b, LDL_RADIO_MODE_HOLD);
+        go(&a, LDL_RADIO_MODE_RX);
+        go(&b, LDL_RADIO_MODE_RX);
+
+        receive(&a, 869525000UL, LDL_SF_12);
+        receive(&b, 869525000UL, LDL_SF_12);
+
+        assert_int_equal(0U, b.chip.count);
+
+        wait(&b, LATENCY);
+
+        assert_int_equal(a.chip.count, b.chip.count);
+        assert_memory_equal(a.chip.writes, b.chip.writes, a.chip.count);
+        assert_memory_equal(a.chip.regs, b.chip.regs, sizeof(a.chip.regs));
+
+        go(&a, LDL_RADIO_MODE_SLEEP);
+        go(&b, LDL_RADIO_MODE_SLEEP);
+    }
+
+    assert_int_equal(4U, b.async.submitted);
+}
+
+int main(void)
+{
+    const struct CMUnitTest tests[] = {
+        cmocka_unit_test_setup(receive_shall_write_nothing_until_submission_is_complete, setup_sx126x),
+        cmocka_unit_test_setup(blocking_access_shall_wait_for_submission, setup_sx126x),
+        cmocka_unit_test_setup(outstanding_submission_shall_be_followed_by_blocking_writes, setup_sx126x),
+        cmocka_unit_test_setup(refused_submission_shall_be_written_in_order, setup_sx126x),
+        cmocka_unit_test_setup(failed_submission_shall_be_written_again, setup_sx126x),
+        cmocka_unit_test(sx127x_shall_write_the_same_registers_as_blocking),
+    };
+
+    trace_desc = stderr;
+
+    return cmocka_run_group_tests(tests, NULL, NULL);
+}
@@ -0,0 +1,100 @@
+#include <stdarg.h>
+#include <stddef.h>
+#include <setjmp.h>
+
+#include "cmocka.h"
+
+#include "ldl_aes.h"
+#include "ldl_ctr.h"
+
+#include <string.h>
+
+static const uint8_t key[] = {0x2b,0x7e,0x15,0x16,0x28,0xae,0xd2,0xa6,0xab,0xf7,0x15,0x88,0x09,0xcf,0x4f,0x3c};
+static const uint8_t iv[] = {0x01,0x00,0x00,0x00,0x00,0x00,0x01,0x02,0x03,0x04,0x05,0x06,0x07,0x08,0x00,0x01};
+
+/* one block at a time as per the LoRaWAN specification */
+static void reference(const struct ldl_aes_ctx *ctx, const uint8_t *in, uint8_t *out, uint8_t len)
+{
+    uint8_t a[16U];
+    uint8_t s[16U];
+    size_t i;
+
+    (void)memcpy(a, iv, sizeof(a));
+
+    for(i=0U; i < len; i++){
+
+        if((i % 16U) == 0U){
+
+            (void)memcpy(s, a, sizeof(s));
+            LDL_AES_encrypt(ctx, s);
+            a[15U]++;
+        }
+
+        out[i] = in[i] ^ s[i % 16U];
+    }
+}
+
+static void test_LDL_CTR_encrypt_all_sizes(void **user)
+{
+    (void)user;
+
+    struct ldl_aes_ctx ctx;
+    uint8_t in[UINT8_MAX];
+    uint8_t out[UINT8_MAX];
+    uint8_t expected[UINT8_MAX];
+    size_t len;
+    size_t i;
+
+    for(i=0U; i < sizeof(in); i++){
+
+        in[i] = (uint8_t)i;
+    }
+
+    LDL_AES_init(&ctx, key);
+
+    for(len=0U; len <= sizeof(in); len++){
+
+        (void)memset(out, 0, sizeof(out));
+
+        reference(&ctx, in, expected, (uint8_t)len);
+        LDL_CTR_encrypt(&ctx, iv, in, out, (uint8_t)len);
+
+        assert_memory_equal(expected, out, len);
+    }
+}
+
+static void test_LDL_CTR_encrypt_in_place_unaligned(void **user)
+{
+    (void)user;
+
+    struct ldl_aes_ctx ctx;
+    uint8_t buffer[UINT8_MAX + 1U];
+    uint8_t expected[UINT8_MAX];
+    size_t len;
+    size_t i;
+
+    LDL_AES_init(&ctx, key);
+
+    for(len=0U; len < (sizeof(buffer) - 1U); len += 7U){
+
+        for(i=0U; i < len; i++){
+
+            buffer[i + 1U] = (uint8_t)(i * 3U);
+        }
+
+        reference(&ctx, &buffer[1U], expected, (uint8_t)len);
+        LDL_CTR_encrypt(&ctx, iv, &buffer[1U], &buffer[1U], (uint8_t)len);
+
+        assert_memory_equal(expected, &buffer[1U], len);
+    }
+}
+
+int main(void)
+{
+    const struct CMUnitTest tests[] = {
+        cmocka_unit_test(test_LDL_CTR_encrypt_all_sizes),
+        cmocka_unit_test(test_LDL_CTR_encrypt_in_place_unaligned)
+    };
+
+    return cmocka_run_group_tests(tests, NULL, NULL);
+}
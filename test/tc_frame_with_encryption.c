@@ -7,6 +7,7 @@
 #include "ldl_frame.h"
 #include "ldl_mac.h"
 #include "ldl_sm.h"
+#include "ldl_sm_internal.h"
 #include "ldl_ops.h"
 #include "ldl_system.h"
 
@@ -31,6 +32,10 @@ static void init_mac(struct ldl_mac *mac, const void *key, enum ldl_mac_operatio
     for(i=0; i < sizeof(sm.keys)/sizeof(*sm.keys); i++){
 
         (void)memcpy(sm.keys[i].value, key, sizeof(sm.keys[i].value));
+#ifdef LDL_ENABLE_SM_KEY_CACHE
+        LDL_AES_init(&sm.keys[i].ctx, sm.keys[i].value);
+        LDL_CMAC_subkeys(&sm.keys[i].subkeys, &sm.keys[i].ctx);
+#endif
     }
 }
 
@@ -61,6 +66,178 @@ static void encode_unconfirmed_up(void **user)
     assert_memory_equal(expected, buffer, retval);
 }
 
+/* the single pass secure_data must produce the same frame as ctr+mic */
+static void encode_single_pass_matches_separate_passes(void **user)
+{
+    (void)user;
+
+    uint8_t retval;
+    uint8_t expected_retval;
+    uint8_t buffer[UINT8_MAX];
+    uint8_t expected[UINT8_MAX];
+    uint8_t payload[200U];
+    uint8_t opts[15U];
+    const uint8_t key[] = {0x2B, 0x7E, 0x15, 0x16, 0x28, 0xAE, 0xD2, 0xA6, 0xAB, 0xF7, 0x15, 0x88, 0x09, 0xCF, 0x4F, 0x3C};
+    struct ldl_sm_interface single;
+    struct ldl_sm_interface separate;
+    struct ldl_frame_data f;
+    struct ldl_mac mac;
+    size_t i;
+    uint8_t len;
+    uint8_t optsLen;
+
+    for(i=0U; i < sizeof(payload); i++){
+
+        payload[i] = (uint8_t)i;
+    }
+
+    (void)memset(opts, 0x03, sizeof(opts));
+
+    init_mac(&mac, key, LDL_OP_DATA_UNCONFIRMED);
+
+    single = *mac.sm_interface;
+    single.secure_data = LDL_SM_secureData;
+
+    separate = *mac.sm_interface;
+    separate.secure_data = NULL;
+
+#ifdef LDL_ENABLE_L2_1_1
+    mac.ctx.version = 1U;
+#endif
+    mac.ctx.devAddr = 0x07BB778F;
+    mac.tx.counter = 42U;
+    mac.tx.rate = 3U;
+    mac.tx.chIndex = 2U;
+
+    for(optsLen=0U; optsLen <= sizeof(opts); optsLen += 5U){
+
+        for(len=0U; len <= sizeof(payload); len += 7U){
+
+            (void)memset(&f, 0, sizeof(f));
+
+            f.type = FRAME_TYPE_DATA_UNCONFIRMED_UP;
+            f.devAddr = mac.ctx.devAddr;
+            f.counter = mac.tx.counter;
+            f.opts = opts;
+            f.optsLen = optsLen;
+            f.port = 1U;
+            f.data = payload;
+            f.dataLen = len;
+
+            mac.sm_interface = &separate;
+            expected_retval = LDL_OPS_prepareData(&mac, &f, expected, sizeof(expected));
+
+            mac.sm_interface = &single;
+            retval = LDL_OPS_prepareData(&mac, &f, buffer, sizeof(buffer));
+
+            assert_int_equal(expected_retval, retval);
+            assert_memory_equal(expected, buffer, retval);
+        }
+    }
+}
+
+static void derive_with_and_without_batch(uint8_t version)
+{
+    const uint8_t appKey[] = {0x2B, 0x7E, 0x15, 0x16, 0x28, 0xAE, 0xD2, 0xA6, 0xAB, 0xF7, 0x15, 0x88, 0x09, 0xCF, 0x4F, 0x3C};
+    const uint8_t nwkKey[] = {0x00, 0x01, 0x02, 0x03, 0x04, 0x05, 0x06, 0x07, 0x08, 0x09, 0x0A, 0x0B, 0x0C, 0x0D, 0x0E, 0x0F};
+    const uint8_t joinEUI[] = {0x70, 0xB3, 0xD5, 0x7E, 0xD0, 0x00, 0x00, 0x01};
+    struct ldl_sm_interface unbatched;
+    struct ldl_sm expected;
+    struct ldl_mac mac;
+    size_t i;
+
+    init_mac(&mac, appKey, LDL_OP_NONE);
+
+#if defined(LDL_ENABLE_L2_1_1)
+    LDL_SM_init(mac.sm, appKey, nwkKey);
+    mac.ctx.version = version;
+#else
+    (void)nwkKey;
+    (void)version;
+    LDL_SM_init(mac.sm, appKey);
+#endif
+
+    (void)memcpy(mac.joinEUI, joinEUI, sizeof(mac.joinEUI));
+    mac.ctx.joinNonce = 0x123456U;
+    mac.ctx.netID = 0x000013U;
+    mac.ctx.devNonce = 0xbeefU;
+
+    (void)memcpy(&unbatched, LDL_SM_getInterface(), sizeof(unbatched));
+    unbatched.derive_session_keys = NULL;
+
+    mac.sm_interface = &unbatched;
+    LDL_OPS_deriveKeys(&mac);
+    (void)memcpy(&expected, mac.sm, sizeof(expected));
+
+    mac.sm_interface = LDL_SM_getInterface();
+    LDL_OPS_deriveKeys(&mac);
+
+    for(i=0U; i < sizeof(expected.keys)/sizeof(*expected.keys); i++){
+
+        assert_memory_equal(expected.keys[i].value, mac.sm->keys[i].value, sizeof(expected.keys[i].value));
+#ifdef LDL_ENABLE_SM_KEY_CACHE
+        assert_memory_equal(expected.keys[i].ctx.k, mac.sm->keys[i].ctx.k, sizeof(expected.keys[i].ctx.k));
+        assert_memory_equal(&expected.keys[i].subkeys, &mac.sm->keys[i].subkeys, sizeof(expected.keys[i].subkeys));
+#endif
+    }
+}
+
+/* deriving all session keys in one call must give the same keys as one call per key */
+static void derive_session_keys_matches_update_session_key(void **user)
+{
+    (void)user;
+
+    derive_with_and_without_batch(0U);
+#if defined(LDL_ENABLE_L2_1_1)
+    derive_with_and_without_batch(1U);
+#endif
+}
+
+/* a retry on another rate/channel must produce the same MIC as a full recalculation */
+static void encode_retry_remic(void **user)
+{
+    (void)user;
+
+    uint8_t retval;
+    uint8_t buffer[UINT8_MAX];
+    uint8_t expected[UINT8_MAX];
+    const uint8_t payload[] = "hello world";
+    const uint8_t key[] = {0x2B, 0x7E, 0x15, 0x16, 0x28, 0xAE, 0xD2, 0xA6, 0xAB, 0xF7, 0x15, 0x88, 0x09, 0xCF, 0x4F, 0x3C};
+    struct ldl_frame_data f;
+    struct ldl_mac mac;
+
+    init_mac(&mac, key, LDL_OP_DATA_UNCONFIRMED);
+
+#ifdef LDL_ENABLE_L2_1_1
+    mac.ctx.version = 1U;
+#endif
+    mac.ctx.devAddr = 0x07BB778F;
+    mac.tx.counter = 42U;
+    mac.tx.rate = 3U;
+    mac.tx.chIndex = 2U;
+
+    (void)memset(&f, 0, sizeof(f));
+
+    f.type = FRAME_TYPE_DATA_UNCONFIRMED_UP;
+    f.devAddr = mac.ctx.devAddr;
+    f.counter = mac.tx.counter;
+    f.port = 1U;
+    f.data = payload;
+    f.dataLen = sizeof(payload)-1;
+
+    retval = LDL_OPS_prepareData(&mac, &f, buffer, sizeof(buffer));
+
+    mac.tx.rate = 1U;
+    mac.tx.chIndex = 5U;
+
+    (void)memcpy(expected, buffer, retval);
+
+    LDL_OPS_micDataFrame(&mac, expected, retval);
+    LDL_OPS_remicDataFrame(&mac, buffer, retval);
+
+    assert_memory_equal(expected, buffer, retval);
+}
+
 static void encode_join_request(void **user)
 {
     (void)user;
@@ -220,6 +397,9 @@ int main(void)
     const struct CMUnitTest tests[] = {
 
         cmocka_unit_test(encode_unconfirmed_up),
+        cmocka_unit_test(encode_single_pass_matches_separate_passes),
+        cmocka_unit_test(encode_retry_remic),
+        cmocka_unit_test(derive_session_keys_matches_update_session_key),
         cmocka_unit_test(encode_join_request),
         cmocka_unit_test(encode_croft_example),
         cmocka_unit_test(encode_random_internet_join_request_example),
@@ -0,0 +1,248 @@
+#include <stdarg.h>
+#include <stddef.h>
+#include <setjmp.h>
+
+#include "cmocka.h"
+
+#include "debug_include.h"
+
+#include "ldl_mac.h"
+#include "ldl_sm.h"
+#include "mock_ldl_sim.h"
+
+#include <string.h>
+
+/* long running scenarios in virtual time
+ *
+ * every tick is a microsecond and nobody answers the uplinks
+ *
+ * */
+
+#define TPS             UINT32_C(1000000)
+#define HOUR            (UINT64_C(3600) * TPS)
+#define DEV_ADDR        UINT32_C(0x01020304)
+#define SEED            UINT32_C(42)
+
+struct result {
+
+    unsigned txCount;
+    unsigned rxCount;
+    unsigned steps;
+    uint64_t airTime;
+    uint32_t digest;
+};
+
+static const uint8_t payload[] = "hello world";
+
+static struct ldl_mac mac;
+static struct ldl_sm sm;
+static struct mock_sim sim;
+
+/* application ********************************************************/
+
+static void send(struct mock_sim *self, void *arg)
+{
+    (void)arg;
+
+    if(LDL_MAC_ready(self->mac)){
+
+        assert_int_equal(LDL_STATUS_OK, LDL_MAC_unconfirmedData(self->mac, 1U, payload, sizeof(payload)-1U, NULL));
+    }
+}
+
+static void handler(void *app, enum ldl_mac_response_type type, const union ldl_mac_response_arg *arg)
+{
+    struct mock_sim *self = (struct mock_sim *)app;
+
+    (void)arg;
+
+    switch(type){
+    default:
+        break;
+
+    /* send again as soon as the duty cycle allows */
+    case LDL_MAC_CHANNEL_READY:
+    case LDL_MAC_DATA_COMPLETE:
+
+        if(self->user != NULL){
+
+            mock_sim_cancel(self, send);
+            mock_sim_schedule(self, 0U, send, NULL);
+        }
+        break;
+    }
+}
+
+/* helpers ************************************************************/
+
+static void start(uint32_t seed, bool uplinks)
+{
+    struct ldl_mac_init_arg arg;
+
+    (void)memset(&arg, 0, sizeof(arg));
+    (void)memset(&sm, 0, sizeof(sm));
+
+    mock_sim_init(&sim, &mac, TPS, seed);
+    mock_sim_initArg(&sim, &arg);
+
+    /* anything not NULL turns on the uplinks */
+    sim.user = uplinks ? &sim : NULL;
+
+    arg.sm = &sm;
+    arg.sm_interface = LDL_SM_getInterface();
+    arg.handler = handler;
+
+    LDL_MAC_init(&mac, LDL_EU_863_870, &arg);
+
+    /* boot the radio */
+    mock_sim_run(&sim, TPS);
+
+    if(uplinks){
+
+        /* pretend to have joined */
+        mac.ctx.joined = true;
+        mac.ctx.devAddr = DEV_ADDR;
+
+        /* slowest rate makes for the longest off times */
+        assert_int_equal(LDL_STATUS_OK, LDL_MAC_setRate(&mac, 0U));
+
+        mock_sim_schedule(&sim, 0U, send, NULL);
+    }
+}
+
+static void record(struct result *r)
+{
+    r->txCount = sim.txCount;
+    r->rxCount = sim.rxCount;
+    r->steps = sim.steps;
+    r->airTime = sim.airTime;
+    r->digest = sim.digest;
+}
+
+static void dutyCycleDay(uint32_t seed, struct result *r)
+{
+    start(seed, true);
+
+    mock_sim_run(&sim, 24U * HOUR);
+
+    record(r);
+}
+
+/* tests **************************************************************/
+
+static void uplinks_shall_keep_to_duty_cycle_limit_for_a_day(void **user)
+{
+    (void)user;
+
+    struct result r;
+    uint32_t frame;
+
+    dutyCycleDay(SEED, &r);
+
+    assert_true(r.txCount > 0U);
+
+    frame = (uint32_t)(r.airTime / r.txCount);
+
+    /* every uplink is followed by two windows */
+    assert_int_equal(r.txCount * 2U, r.rxCount);
+
+    /* the default channels share a 1% band */
+    assert_true(r.airTime <= (((24U * HOUR) / 100U) + frame));
+
+    /* and not much of it goes unused */
+    assert_true(r.airTime >= ((24U * HOUR) / 100U * 98U / 100U));
+}
+
+static void scenario_shall_repeat_exactly_with_the_same_seed(void **user)
+{
+    (void)user;
+
+    struct result first;
+    struct result second;
+    struct result other;
+
+    dutyCycleDay(SEED, &first);
+    dutyCycleDay(SEED, &second);
+    dutyCycleDay(SEED + 1U, &other);
+
+    assert_memory_equal(&first, &second, sizeof(first));
+
+    /* the seed decides the channels */
+    assert_int_not_equal(first.digest, other.digest);
+}
+
+static void otaa_shall_back_off_over_a_day(void **user)
+{
+    (void)user;
+
+    uint64_t hour;
+    uint64_t elevenHours;
+    uint32_t frame;
+
+    start(SEED, false);
+
+    frame = mock_sim_airTime(&sim, LDL_SF_12, LDL_BW_125, 23U, true);
+
+    assert_int_equal(LDL_STATUS_OK, LDL_MAC_otaa(&mac));
+
+    mock_sim_run(&sim, HOUR);
+
+    hour = sim.airTime;
+
+    mock_sim_run(&sim, 10U * HOUR);
+
+    elevenHours = sim.airTime - hour;
+
+    mock_sim_run(&sim, 13U * HOUR);
+
+    /* 36s in the first hour, 36s in the next ten, then 8.7s a day */
+    assert_true(hour <= ((UINT64_C(36) * TPS) + frame));
+    assert_true(elevenHours <= ((UINT64_C(36) * TPS) + frame));
+    assert_true((sim.airTime - hour - elevenHours) <= ((UINT64_C(87) * TPS / 10U) + frame));
+
+    assert_false(LDL_MAC_joined(&mac));
+}
+
+static void band_timer_shall_follow_global_band_reset(void **user)
+{
+    (void)user;
+
+    start(SEED, false);
+
+    assert_int_equal(UINT32_MAX, LDL_MAC_ticksUntilNextEvent(&mac));
+
+    /* an hour of global off-time (e.g. from the startup delay) */
+    mac.band[LDL_BAND_GLOBAL] = mac.time.now + (UINT32_C(3600) * UINT32_C(256));
+    LDL_MAC_timerSet(&mac, LDL_TIMER_BAND, (uint32_t)HOUR);
+
+    assert_int_equal(LDL_STATUS_OK, LDL_MAC_abp(&mac, DEV_ADDR));
+
+    /* joining clears it and so the band timer */
+    assert_int_equal(UINT32_MAX, LDL_MAC_ticksUntilNextEvent(&mac));
+
+    /* an hour of off-time from MaxDutyCycleReq */
+    mac.band[LDL_BAND_GLOBAL] = mac.time.now + (UINT32_C(3600) * UINT32_C(256));
+    LDL_MAC_timerSet(&mac, LDL_TIMER_BAND, (uint32_t)HOUR);
+
+    LDL_MAC_forget(&mac);
+
+    /* forgetting resets the radio */
+    mock_sim_run(&sim, TPS);
+
+    assert_true(LDL_MAC_ready(&mac));
+    assert_int_equal(UINT32_MAX, LDL_MAC_ticksUntilNextEvent(&mac));
+}
+
+int main(void)
+{
+    const struct CMUnitTest tests[] = {
+        cmocka_unit_test(uplinks_shall_keep_to_duty_cycle_limit_for_a_day),
+        cmocka_unit_test(scenario_shall_repeat_exactly_with_the_same_seed),
+        cmocka_unit_test(otaa_shall_back_off_over_a_day),
+        cmocka_unit_test(band_timer_shall_follow_global_band_reset),
+    };
+
+    trace_desc = stderr;
+
+    return cmocka_run_group_tests(tests, NULL, NULL);
+}
@@ -0,0 +1,572 @@
+#include <stdarg.h>
+#include <stddef.h>
+#include <setjmp.h>
+
+#include "cmocka.h"
+
+#include "debug_include.h"
+
+#include "ldl_mac.h"
+#include "ldl_radio.h"
+#include "ldl_sm.h"
+#include "ldl_sm_internal.h"
+#include "ldl_system.h"
+#include "mock_ldl_system.h"
+#include "mock_ldl_sm_async.h"
+
+#include <string.h>
+
+extern uint32_t system_time;
+
+/* drives the MAC through an unconfirmed uplink in virtual time
+ * with a secure element that is slow to check the MIC
+ *
+ * every tick is a microsecond
+ *
+ * */
+
+#define TPS             UINT32_C(1000000)
+#define DEV_ADDR        UINT32_C(0x01020304)
+
+/* how long after receive() the radio reports a frame or a timeout */
+#define FRAME_DELAY     UINT32_C(50000)
+#define WINDOW_TIMEOUT  UINT32_C(500000)
+#define AIRTIME         UINT32_C(100000)
+
+struct scenario {
+
+    /* frames to deliver in RX1 and RX2 (NULL for timeout) */
+    const uint8_t *rx1;
+    uint8_t rx1Len;
+    const uint8_t *rx2;
+    uint8_t rx2Len;
+
+    /* ticks for the SE to calculate a MIC */
+    uint32_t latency;
+
+    /* SE refuses begin_mic so every MIC is checked with mic() */
+    bool refuse;
+};
+
+struct result {
+
+    unsigned windows;
+    uint32_t txDone;
+    uint32_t rxOpened[2U];
+
+    unsigned rxCount;
+    uint8_t rxData[16U];
+    uint8_t rxSize;
+    uint32_t rxTime;
+
+    bool complete;
+};
+
+static const uint8_t key[] = {0x2B, 0x7E, 0x15, 0x16, 0x28, 0xAE, 0xD2, 0xA6, 0xAB, 0xF7, 0x15, 0x88, 0x09, 0xCF, 0x4F, 0x3C};
+static const uint8_t payload[] = "hello";
+
+static struct ldl_mac mac;
+static struct mock_sm_async se;
+static struct result result;
+static const struct scenario *scenario;
+
+/* radio event the mock radio will signal */
+static struct {
+
+    bool scheduled;
+    uint32_t due;
+    struct ldl_radio_status pending;
+    struct ldl_radio_status status;
+    const uint8_t *frame;
+    uint8_t frameLen;
+
+} radio;
+
+/* mock radio *********************************************************/
+
+static void radioSetMode(struct ldl_radio *self, enum ldl_radio_mode mode)
+{
+    (void)self;
+    (void)mode;
+
+    /* anything scheduled was for the previous mode */
+    radio.scheduled = false;
+}
+
+static uint32_t radioReadEntropy(struct ldl_radio *self)
+{
+    (void)self;
+
+    return 0U;
+}
+
+static uint8_t radioReadBuffer(struct ldl_radio *self, struct ldl_radio_packet_metadata *meta, void *data, uint8_t max)
+{
+    uint8_t retval;
+
+    (void)self;
+
+    (void)memset(meta, 0, sizeof(*meta));
+
+    retval = (radio.frameLen > max) ? max : radio.frameLen;
+
+    (void)memcpy(data, radio.frame, retval);
+
+    return retval;
+}
+
+static void radioSchedule(uint32_t delay, bool tx, bool rx, bool timeout)
+{
+    radio.scheduled = true;
+    radio.due = system_time + delay;
+    radio.pending.tx = tx;
+    radio.pending.rx = rx;
+    radio.pending.timeout = timeout;
+}
+
+static void radioTransmit(struct ldl_radio *self, const struct ldl_radio_tx_setting *settings, const void *data, uint8_t len)
+{
+    (void)self;
+    (void)settings;
+    (void)data;
+    (void)len;
+
+    radioSchedule(AIRTIME, true, false, false);
+}
+
+static void radioReceive(struct ldl_radio *self, const struct ldl_radio_rx_setting *settings)
+{
+    (void)self;
+    (void)settings;
+
+    assert_true(result.windows < 2U);
+
+    result.rxOpened[result.windows] = system_time;
+
+    if(result.windows == 0U){
+
+        radio.frame = scenario->rx1;
+        radio.frameLen = scenario->rx1Len;
+    }
+    else{
+
+        radio.frame = scenario->rx2;
+        radio.frameLen = scenario->rx2Len;
+    }
+
+    result.windows++;
+
+    if(radio.frame != NULL){
+
+        radioSchedule(FRAME_DELAY, false, true, false);
+    }
+    else{
+
+        radioSchedule(WINDOW_TIMEOUT, false, false, true);
+    }
+}
+
+static void radioReceiveEntropy(struct ldl_radio *self)
+{
+    (void)self;
+}
+
+static void radioGetStatus(struct ldl_radio *self, struct ldl_radio_status *status)
+{
+    (void)self;
+
+    *status = radio.status;
+}
+
+static const struct ldl_radio_interface radio_interface = {
+    .set_mode = radioSetMode,
+    .read_entropy = radioReadEntropy,
+    .read_buffer = radioReadBuffer,
+    .transmit = radioTransmit,
+    .receive = radioReceive,
+    .receive_entropy = radioReceiveEntropy,
+    .get_status = radioGetStatus
+};
+
+/* harness ************************************************************/
+
+static uint32_t ticks(void *app)
+{
+    (void)app;
+
+    return system_time;
+}
+
+static uint32_t fixedRand(void *app)
+{
+    (void)app;
+
+    return 0U;
+}
+
+static void handler(void *app, enum ldl_mac_response_type type, const union ldl_mac_response_arg *arg)
+{
+    (void)app;
+
+    switch(type){
+    default:
+        break;
+
+    case LDL_MAC_RX:
+
+        assert_true(arg->rx.size <= sizeof(result.rxData));
+
+        result.rxCount++;
+        result.rxTime = system_time;
+        result.rxSize = arg->rx.size;
+        (void)memcpy(result.rxData, arg->rx.data, arg->rx.size);
+        break;
+
+    case LDL_MAC_DATA_COMPLETE:
+    case LDL_MAC_DATA_TIMEOUT:
+
+        result.complete = true;
+        break;
+    }
+}
+
+static uint32_t earliest(uint32_t a, uint32_t b)
+{
+    return (a < b) ? a : b;
+}
+
+/* run until the MAC is idle with nothing left to deliver */
+static void run(uint32_t limit)
+{
+    uint32_t next;
+    uint32_t start = system_time;
+
+    for(;;){
+
+        mock_sm_async_process(&se);
+
+        LDL_MAC_process(&mac);
+
+        next = earliest(LDL_MAC_ticksUntilNextEvent(&mac), mock_sm_async_ticksUntilComplete(&se));
+
+        if(radio.scheduled){
+
+            next = earliest(next, radio.due - system_time);
+        }
+
+        if(next == 0U){
+
+            continue;
+        }
+
+        if((next == UINT32_MAX) || ((system_time - start) >= limit)){
+
+            break;
+        }
+
+        system_time += earliest(next, limit - (system_time - start));
+
+        if(radio.scheduled && (radio.due == system_time)){
+
+            radio.scheduled = false;
+            radio.status = radio.pending;
+
+            if(radio.status.tx){
+
+                result.txDone = system_time;
+            }
+
+            LDL_MAC_radioEvent(&mac);
+        }
+    }
+}
+
+static void start(const struct scenario *s)
+{
+    struct ldl_mac_init_arg arg;
+
+    (void)memset(&arg, 0, sizeof(arg));
+    (void)memset(&result, 0, sizeof(result));
+    (void)memset(&radio, 0, sizeof(radio));
+
+    system_time = 0U;
+    scenario = s;
+
+    mock_sm_async_init(&se, key, s->latency);
+
+    se.refuse = s->refuse;
+
+    arg.radio_interface = &radio_interface;
+    arg.sm = &se.sm;
+    arg.sm_interface = mock_sm_async_getInterface();
+    arg.handler = handler;
+    arg.ticks = ticks;
+    arg.rand = fixedRand;
+    arg.tps = TPS;
+
+    LDL_MAC_init(&mac, LDL_EU_863_870, &arg);
+
+    /* boot the radio */
+    run(TPS);
+
+    assert_true(LDL_MAC_ready(&mac));
+
+    /* pretend to have joined */
+    mac.ctx.joined = true;
+    mac.ctx.devAddr = DEV_ADDR;
+
+    assert_int_equal(LDL_STATUS_OK, LDL_MAC_unconfirmedData(&mac, 1U, payload, sizeof(payload)-1U, NULL));
+
+    run(UINT32_C(30) * TPS);
+
+    assert_true(result.complete);
+}
+
+static uint8_t putU32(uint8_t *buf, uint32_t value)
+{
+    buf[0] = (uint8_t)value;
+    buf[1] = (uint8_t)(value >> 8);
+    buf[2] = (uint8_t)(value >> 16);
+    buf[3] = (uint8_t)(value >> 24);
+
+    return 4U;
+}
+
+/* unconfirmed downlink carrying payload on port 1 */
+static uint8_t downlink(uint8_t *buffer, uint16_t counter, bool corrupt)
+{
+    struct ldl_sm sm;
+    uint8_t pos = 0U;
+    uint8_t block[16U];
+    uint32_t mic;
+    size_t i;
+
+    (void)memset(&sm, 0, sizeof(sm));
+
+    for(i=0U; i < sizeof(sm.keys)/sizeof(*sm.keys); i++){
+
+        (void)memcpy(sm.keys[i].value, key, sizeof(sm.keys[i].value));
+#ifdef LDL_ENABLE_SM_KEY_CACHE
+        LDL_AES_init(&sm.keys[i].ctx, sm.keys[i].value);
+        LDL_CMAC_subkeys(&sm.keys[i].subkeys, &sm.keys[i].ctx);
+#endif
+    }
+
+    buffer[pos++] = 0x60U;
+    pos += putU32(&buffer[pos], DEV_ADDR);
+    buffer[pos++] = 0x00U;
+    buffer[pos++] = (uint8_t)counter;
+    buffer[pos++] = (uint8_t)(counter >> 8);
+    buffer[pos++] = 1U;
+
+    (void)memcpy(&buffer[pos], payload, sizeof(payload)-1U);
+
+    (void)memset(block, 0, sizeof(block));
+    block[0] = 0x01U;
+    block[5] = 1U;
+    (void)putU32(&block[6], DEV_ADDR);
+    (void)putU32(&block[10], counter);
+    block[15] = 1U;
+
+    LDL_SM_ctr(&sm, LDL_SM_KEY_APPS, block, &buffer[pos], sizeof(payload)-1U);
+
+    pos += sizeof(payload)-1U;
+
+    (void)memset(block, 0, sizeof(block));
+    block[0] = 0x49U;
+    block[5] = 1U;
+    (void)putU32(&block[6], DEV_ADDR);
+    (void)putU32(&block[10], counter);
+    block[15] = pos;
+
+    mic = LDL_SM_mic(&sm, LDL_SM_KEY_SNWKSINT, block, sizeof(block), buffer, pos);
+
+    if(corrupt){
+
+        mic ^= 1U;
+    }
+
+    pos += putU32(&buffer[pos], mic);
+
+    return pos;
+}
+
+/* when RX2 opens after TX_COMPLETE if nothing arrives in RX1 */
+static uint32_t baselineRX2(void)
+{
+    static const struct scenario s = {
+        .latency = 0U
+    };
+
+    start(&s);
+
+    assert_int_equal(2U, result.windows);
+    assert_int_equal(0U, result.rxCount);
+
+    return result.rxOpened[1] - result.txDone;
+}
+
+/* tests **************************************************************/
+
+static void rx2_opened_on_time_while_rx1_mic_outstanding(void **user)
+{
+    (void)user;
+
+    uint8_t frame[32U];
+    uint32_t expected;
+    struct scenario s;
+
+    expected = baselineRX2();
+
+    (void)memset(&s, 0, sizeof(s));
+
+    s.rx1 = frame;
+    s.rx1Len = downlink(frame, 1U, false);
+
+    /* result arrives while RX2 is open */
+    s.latency = expected - result.rxOpened[0] + result.txDone + (WINDOW_TIMEOUT / 2U) - FRAME_DELAY;
+
+    start(&s);
+
+    /* mic() was only used for the uplink */
+    assert_int_equal(1U, se.started);
+    assert_int_equal(1U, se.blocking);
+
+    /* RX2 was not held up */
+    assert_int_equal(2U, result.windows);
+    assert_int_equal(expected, result.rxOpened[1] - result.txDone);
+
+    /* RX1 frame was delivered when the result came back */
+    assert_int_equal(1U, result.rxCount);
+    assert_true(result.rxTime > result.rxOpened[1]);
+    assert_int_equal(sizeof(payload)-1U, result.rxSize);
+    assert_memory_equal(payload, result.rxData, result.rxSize);
+}
+
+static void rx2_not_opened_if_rx1_mic_is_quick(void **user)
+{
+    (void)user;
+
+    uint8_t frame[32U];
+    struct scenario s;
+
+    (void)memset(&s, 0, sizeof(s));
+
+    s.rx1 = frame;
+    s.rx1Len = downlink(frame, 1U, false);
+    s.latency = UINT32_C(10000);
+
+    start(&s);
+
+    assert_int_equal(1U, se.started);
+    assert_int_equal(1U, result.windows);
+    assert_int_equal(1U, result.rxCount);
+    assert_memory_equal(payload, result.rxData, result.rxSize);
+}
+
+static void rx2_used_if_rx1_mic_fails(void **user)
+{
+    (void)user;
+
+    uint8_t bad[32U];
+    uint8_t good[32U];
+    uint32_t expected;
+    struct scenario s;
+
+    expected = baselineRX2();
+
+    (void)memset(&s, 0, sizeof(s));
+
+    s.rx1 = bad;
+    s.rx1Len = downlink(bad, 1U, true);
+    s.rx2 = good;
+    s.rx2Len = downlink(good, 1U, false);
+
+    /* result for RX1 is still outstanding when the RX2 frame arrives */
+    s.latency = UINT32_C(3) * TPS;
+
+    start(&s);
+
+    assert_int_equal(2U, result.windows);
+    assert_int_equal(expected, result.rxOpened[1] - result.txDone);
+
+    /* the SE was busy so the RX2 frame was checked with mic() */
+    assert_int_equal(1U, se.started);
+    assert_int_equal(2U, se.blocking);
+
+    assert_int_equal(1U, result.rxCount);
+    assert_true(result.rxTime > result.rxOpened[1]);
+    assert_memory_equal(payload, result.rxData, result.rxSize);
+}
+
+static void rx2_used_if_rx1_mic_fails_without_begin_mic(void **user)
+{
+    (void)user;
+
+    uint8_t bad[32U];
+    uint8_t good[32U];
+    uint32_t expected;
+    struct scenario s;
+
+    expected = baselineRX2();
+
+    (void)memset(&s, 0, sizeof(s));
+
+    s.rx1 = bad;
+    s.rx1Len = downlink(bad, 1U, true);
+    s.rx2 = good;
+    s.rx2Len = downlink(good, 1U, false);
+    s.refuse = true;
+
+    start(&s);
+
+    /* the failed RX1 frame does not end the downlink */
+    assert_int_equal(2U, result.windows);
+    assert_int_equal(expected, result.rxOpened[1] - result.txDone);
+
+    /* uplink, RX1 and RX2 were all checked with mic() */
+    assert_int_equal(0U, se.started);
+    assert_int_equal(3U, se.blocking);
+
+    assert_int_equal(1U, result.rxCount);
+    assert_true(result.rxTime > result.rxOpened[1]);
+    assert_memory_equal(payload, result.rxData, result.rxSize);
+}
+
+static void late_rx1_mic_after_rx2_timeout(void **user)
+{
+    (void)user;
+
+    uint8_t frame[32U];
+    struct scenario s;
+
+    (void)memset(&s, 0, sizeof(s));
+
+    s.rx1 = frame;
+    s.rx1Len = downlink(frame, 1U, false);
+
+    /* result arrives after RX2 has timed out */
+    s.latency = UINT32_C(5) * TPS;
+
+    start(&s);
+
+    assert_int_equal(2U, result.windows);
+    assert_int_equal(1U, result.rxCount);
+    assert_memory_equal(payload, result.rxData, result.rxSize);
+}
+
+int main(void)
+{
+    trace_desc = stderr;
+
+    const struct CMUnitTest tests[] = {
+
+        cmocka_unit_test(rx2_opened_on_time_while_rx1_mic_outstanding),
+        cmocka_unit_test(rx2_not_opened_if_rx1_mic_is_quick),
+        cmocka_unit_test(rx2_used_if_rx1_mic_fails),
+        cmocka_unit_test(rx2_used_if_rx1_mic_fails_without_begin_mic),
+        cmocka_unit_test(late_rx1_mic_after_rx2_timeout)
+    };
+
+    return cmocka_run_group_tests(tests, NULL, NULL);
+}
@@ -0,0 +1,78 @@
+#include <stdarg.h>
+#include <stddef.h>
+#include <setjmp.h>
+
+#include "cmocka.h"
+
+#include "debug_include.h"
+
+#include "ldl_mac.h"
+#include "ldl_sm.h"
+#include "mock_ldl_system.h"
+
+#include <string.h>
+
+extern uint32_t system_time;
+
+/* LDL_STARTUP_DELAY becomes the first global band deadline
+ *
+ * the makefile builds this with delays at either end of the range
+ * msToTime() has to handle
+ *
+ * */
+
+static struct ldl_sm sm;
+
+static void set_mode(struct ldl_radio *self, enum ldl_radio_mode mode)
+{
+    (void)self;
+    (void)mode;
+}
+
+static const struct ldl_radio_interface radio_interface = {
+    .set_mode = set_mode
+};
+
+/* tests **************************************************************/
+
+static void startup_delay_shall_be_converted_to_time(void **user)
+{
+    (void)user;
+
+    struct ldl_mac self;
+    struct ldl_mac_init_arg arg;
+    uint64_t exact;
+    uint64_t delay;
+
+    (void)memset(&arg, 0, sizeof(arg));
+
+    system_time = 0U;
+
+    arg.radio_interface = &radio_interface;
+    arg.sm = &sm;
+    arg.sm_interface = LDL_SM_getInterface();
+    arg.ticks = LDL_System_ticks;
+    arg.tps = 1000000UL;
+
+    LDL_MAC_init(&self, LDL_EU_863_870, &arg);
+
+    /* 'time' is 1/256 of a second, rounded up */
+    exact = (((uint64_t)LDL_STARTUP_DELAY * UINT64_C(256)) + UINT64_C(999)) / UINT64_C(1000);
+
+    delay = (uint64_t)(self.band[LDL_BAND_GLOBAL] - self.time.now);
+
+    /* never short and no more than 0.01% long */
+    assert_true(delay >= exact);
+    assert_true(delay <= (exact + (exact / UINT64_C(10000)) + UINT64_C(1)));
+}
+
+int main(void)
+{
+    const struct CMUnitTest tests[] = {
+        cmocka_unit_test(startup_delay_shall_be_converted_to_time),
+    };
+
+    trace_desc = stderr;
+
+    return cmocka_run_group_tests(tests, NULL, NULL);
+}
@@ -0,0 +1,257 @@
+#include <stdarg.h>
+#include <stddef.h>
+#include <setjmp.h>
+
+#include "cmocka.h"
+
+#include "debug_include.h"
+
+#include "ldl_sx126x.h"
+#include "mock_ldl_chip.h"
+
+#include <string.h>
+
+/* the driver only sends commands that change the chip configuration */
+
+#define OPCODE_SET_RX                       0x82
+#define OPCODE_SET_TX                       0x83
+#define OPCODE_WRITE_REGISTER               0x0d
+#define OPCODE_SET_DIO_IRQ_PARAMS           0x08
+#define OPCODE_SET_RF_FREQUENCY             0x86
+#define OPCODE_SET_PACKET_TYPE              0x8a
+#define OPCODE_SET_MODULATION_PARAMS        0x8b
+#define OPCODE_SET_PACKET_PARAMS            0x8c
+#define OPCODE_SET_BUFFER_BASE_ADDRESS      0x8f
+#define OPCODE_SET_LORA_SYMB_NUM_TIMEOUT    0xa0
+
+static struct mock_chip chip;
+
+static const uint8_t payload[] = "hello world";
+
+/* the full configuration for an RX window */
+static const uint8_t rx_sequence[] = {
+    OPCODE_SET_PACKET_TYPE,
+    OPCODE_SET_BUFFER_BASE_ADDRESS,
+    OPCODE_SET_RF_FREQUENCY,
+    OPCODE_SET_MODULATION_PARAMS,
+    OPCODE_SET_PACKET_PARAMS,
+    OPCODE_SET_DIO_IRQ_PARAMS,
+    OPCODE_WRITE_REGISTER,
+    OPCODE_SET_LORA_SYMB_NUM_TIMEOUT,
+    OPCODE_SET_RX
+};
+
+/* setups *************************************************************/
+
+static int setup(void **user)
+{
+    static struct ldl_radio radio;
+    struct ldl_sx126x_init_arg arg;
+
+    (void)memset(&arg, 0, sizeof(arg));
+
+    mock_chip_init(&chip, false);
+
+    arg.chip = &chip;
+    arg.chip_write = mock_chip_write;
+    arg.chip_read = mock_chip_read;
+    arg.chip_set_mode = mock_chip_set_mode;
+
+    LDL_SX1262_init(&radio, &arg);
+
+    mock_chip_go(&radio, LDL_RADIO_MODE_RESET);
+    mock_chip_go(&radio, LDL_RADIO_MODE_BOOT);
+    mock_chip_go(&radio, LDL_RADIO_MODE_SLEEP);
+    mock_chip_go(&radio, LDL_RADIO_MODE_RX);
+
+    *user = &radio;
+
+    return 0;
+}
+
+/* tests **************************************************************/
+
+static void receive_shall_configure_everything_the_first_time(void **user)
+{
+    struct ldl_radio *self = (struct ldl_radio *)(*user);
+    struct ldl_radio_rx_setting value;
+
+    mock_chip_rx_settings(&value, 868100000UL, LDL_SF_7);
+
+    mock_chip_receive(&chip, self, &value);
+
+    /* image calibration comes after the packet type */
+    assert_int_equal(sizeof(rx_sequence) + 1U, chip.count);
+    assert_int_equal(rx_sequence[0], chip.writes[0]);
+    assert_memory_equal(&rx_sequence[1], &chip.writes[2], sizeof(rx_sequence) - 1U);
+}
+
+static void receive_shall_skip_unchanged_parameters(void **user)
+{
+    struct ldl_radio *self = (struct ldl_radio *)(*user);
+    struct ldl_radio_rx_setting value;
+
+    mock_chip_rx_settings(&value, 868100000UL, LDL_SF_7);
+
+    (void)mock_chip_receive(&chip, self, &value);
+
+    /* same again */
+    assert_int_equal(1U, mock_chip_receive(&chip, self, &value));
+    assert_int_equal(OPCODE_SET_RX, chip.writes[0]);
+
+    /* RX2 is usually a different frequency and rate */
+    mock_chip_rx_settings(&value, 869525000UL, LDL_SF_12);
+
+    assert_int_equal(3U, mock_chip_receive(&chip, self, &value));
+    assert_int_equal(OPCODE_SET_RF_FREQUENCY, chip.writes[0]);
+    assert_int_equal(OPCODE_SET_MODULATION_PARAMS, chip.writes[1]);
+    assert_int_equal(OPCODE_SET_RX, chip.writes[2]);
+}
+
+static void warm_sleep_shall_keep_parameters(void **user)
+{
+    struct ldl_radio *self = (struct ldl_radio *)(*user);
+    struct ldl_radio_rx_setting value;
+
+    mock_chip_rx_settings(&value, 868100000UL, LDL_SF_7);
+
+    (void)mock_chip_receive(&chip, self, &value);
+
+    mock_chip_go(self, LDL_RADIO_MODE_HOLD);
+    mock_chip_go(self, LDL_RADIO_MODE_RX);
+
+    assert_int_equal(1U, mock_chip_receive(&chip, self, &value));
+}
+
+static void sleep_shall_forget_parameters_unless_warm(void **user)
+{
+    struct ldl_radio *self = (struct ldl_radio *)(*user);
+    struct ldl_radio_rx_setting value;
+
+    mock_chip_rx_settings(&value, 868100000UL, LDL_SF_7);
+
+    (void)mock_chip_receive(&chip, self, &value);
+
+    mock_chip_go(self, LDL_RADIO_MODE_SLEEP);
+    mock_chip_go(self, LDL_RADIO_MODE_RX);
+
+#ifdef LDL_ENABLE_SX126X_WARM_SLEEP
+    /* image calibration is repeated */
+    assert_int_equal(2U, mock_chip_receive(&chip, self, &value));
+#else
+    assert_int_equal(sizeof(rx_sequence) + 1U, mock_chip_receive(&chip, self, &value));
+#endif
+}
+
+static void reset_shall_forget_parameters(void **user)
+{
+    struct ldl_radio *self = (struct ldl_radio *)(*user);
+    struct ldl_radio_rx_setting value;
+
+    mock_chip_rx_settings(&value, 868100000UL, LDL_SF_7);
+
+    (void)mock_chip_receive(&chip, self, &value);
+
+    mock_chip_go(self, LDL_RADIO_MODE_RESET);
+    mock_chip_go(self, LDL_RADIO_MODE_BOOT);
+    mock_chip_go(self, LDL_RADIO_MODE_SLEEP);
+    mock_chip_go(self, LDL_RADIO_MODE_RX);
+
+    assert_int_equal(sizeof(rx_sequence) + 1U, mock_chip_receive(&chip, self, &value));
+}
+
+static void failed_write_shall_be_sent_again(void **user)
+{
+    struct ldl_radio *self = (struct ldl_radio *)(*user);
+    struct ldl_radio_rx_setting value;
+
+    mock_chip_rx_settings(&value, 868100000UL, LDL_SF_7);
+
+    (void)mock_chip_receive(&chip, self, &value);
+
+    /* the first command fails and the rest are abandoned */
+    mock_chip_rx_settings(&value, 868300000UL, LDL_SF_7);
+
+    chip.fail = true;
+
+    assert_int_equal(1U, mock_chip_receive(&chip, self, &value));
+    assert_int_equal(OPCODE_SET_RF_FREQUENCY, chip.writes[0]);
+
+    chip.fail = false;
+
+    assert_int_equal(2U, mock_chip_receive(&chip, self, &value));
+    assert_int_equal(OPCODE_SET_RF_FREQUENCY, chip.writes[0]);
+    assert_int_equal(OPCODE_SET_RX, chip.writes[1]);
+}
+
+static void start_transmit_shall_only_send_set_tx(void **user)
+{
+    struct ldl_radio *self = (struct ldl_radio *)(*user);
+    struct ldl_radio_tx_setting value;
+
+    mock_chip_tx_settings(&value, 868100000UL, LDL_SF_7);
+
+    mock_chip_go(self, LDL_RADIO_MODE_SLEEP);
+    mock_chip_go(self, LDL_RADIO_MODE_TX);
+
+    mock_chip_clear(&chip);
+
+    LDL_SX126X_prepareTransmit(self, &value, payload, sizeof(payload) - 1U);
+
+    assert_true(chip.count > 0U);
+    assert_int_not_equal(OPCODE_SET_TX, chip.writes[chip.count - 1U]);
+
+    mock_chip_clear(&chip);
+
+    LDL_SX126X_startTransmit(self);
+
+    assert_int_equal(1U, chip.count);
+    assert_int_equal(OPCODE_SET_TX, chip.writes[0]);
+}
+
+static void start_transmit_shall_do_nothing_unless_prepared(void **user)
+{
+    struct ldl_radio *self = (struct ldl_radio *)(*user);
+    struct ldl_radio_tx_setting value;
+
+    mock_chip_tx_settings(&value, 868100000UL, LDL_SF_7);
+
+    mock_chip_go(self, LDL_RADIO_MODE_SLEEP);
+    mock_chip_go(self, LDL_RADIO_MODE_TX);
+
+    mock_chip_clear(&chip);
+
+    LDL_SX126X_startTransmit(self);
+
+    assert_int_equal(0U, chip.count);
+
+    /* a change of mode discards the prepared transmission */
+    LDL_SX126X_prepareTransmit(self, &value, payload, sizeof(payload) - 1U);
+
+    mock_chip_go(self, LDL_RADIO_MODE_SLEEP);
+    mock_chip_go(self, LDL_RADIO_MODE_TX);
+
+    mock_chip_clear(&chip);
+
+    LDL_SX126X_startTransmit(self);
+
+    assert_int_equal(0U, chip.count);
+}
+
+int main(void)
+{
+    const struct CMUnitTest tests[] = {
+        cmocka_unit_test_setup(receive_shall_configure_everything_the_first_time, setup),
+        cmocka_unit_test_setup(receive_shall_skip_unchanged_parameters, setup),
+        cmocka_unit_test_setup(warm_sleep_shall_keep_parameters, setup),
+        cmocka_unit_test_setup(sleep_shall_forget_parameters_unless_warm, setup),
+        cmocka_unit_test_setup(reset_shall_forget_parameters, setup),
+        cmocka_unit_test_setup(failed_write_shall_be_sent_again, setup),
+        cmocka_unit_test_setup(start_transmit_shall_only_send_set_tx, setup),
+        cmocka_unit_test_setup(start_transmit_shall_do_nothing_unless_prepared, setup),
+    };
+
+    trace_desc = stderr;
+
+    return cmocka_run_group_tests(tests, NULL, NULL);
+}
@@ -0,0 +1,303 @@
+#include <stdarg.h>
+#include <stddef.h>
+#include <setjmp.h>
+
+#include "cmocka.h"
+
+#include "debug_include.h"
+
+#include "ldl_sx127x.h"
+#include "mock_ldl_chip.h"
+
+#include <string.h>
+
+/* the driver only writes configuration registers that change and
+ * writes neighbouring registers in one transaction
+ *
+ * */
+
+#define REG_OP_MODE         0x01U
+#define REG_FRF_MSB         0x06U
+#define REG_MODEM_CONFIG1   0x1dU
+
+static struct mock_chip chip;
+
+static const uint8_t payload[] = "hello world";
+
+/* helpers ************************************************************/
+
+static size_t transmit(struct ldl_radio *self, uint32_t freq, enum ldl_spreading_factor sf)
+{
+    struct ldl_radio_tx_setting value;
+
+    mock_chip_tx_settings(&value, freq, sf);
+
+    mock_chip_go(self, LDL_RADIO_MODE_TX);
+
+    return mock_chip_transmit(&chip, self, &value, payload, sizeof(payload) - 1U);
+}
+
+static size_t receive(struct ldl_radio *self, uint32_t freq, enum ldl_spreading_factor sf)
+{
+    struct ldl_radio_rx_setting value;
+
+    mock_chip_rx_settings(&value, freq, sf);
+
+    return mock_chip_receive(&chip, self, &value);
+}
+
+static size_t prepare(struct ldl_radio *self, uint32_t freq, enum ldl_spreading_factor sf)
+{
+    struct ldl_radio_tx_setting value;
+
+    mock_chip_tx_settings(&value, freq, sf);
+
+    mock_chip_go(self, LDL_RADIO_MODE_TX);
+
+    mock_chip_clear(&chip);
+
+    LDL_SX127X_prepareTransmit(self, &value, payload, sizeof(payload) - 1U);
+
+    return chip.transactions;
+}
+
+static size_t start(struct ldl_radio *self)
+{
+    mock_chip_clear(&chip);
+
+    LDL_SX127X_startTransmit(self);
+
+    return chip.transactions;
+}
+
+static void hold(struct ldl_radio *self)
+{
+    mock_chip_go(self, LDL_RADIO_MODE_HOLD);
+    mock_chip_go(self, LDL_RADIO_MODE_RX);
+}
+
+/* setups *************************************************************/
+
+static int setup(void **user)
+{
+    static struct ldl_radio radio;
+    struct ldl_sx127x_init_arg arg;
+
+    (void)memset(&arg, 0, sizeof(arg));
+
+    mock_chip_init(&chip, true);
+
+    arg.chip = &chip;
+    arg.chip_write = mock_chip_write;
+    arg.chip_read = mock_chip_read;
+    arg.chip_set_mode = mock_chip_set_mode;
+
+    LDL_SX1276_init(&radio, &arg);
+
+    mock_chip_go(&radio, LDL_RADIO_MODE_RESET);
+    mock_chip_go(&radio, LDL_RADIO_MODE_BOOT);
+    mock_chip_go(&radio, LDL_RADIO_MODE_SLEEP);
+
+    *user = &radio;
+
+    return 0;
+}
+
+/* tests **************************************************************/
+
+static void transactions_shall_be_fewer_for_a_tx_rx1_rx2_cycle(void **user)
+{
+    struct ldl_radio *self = (struct ldl_radio *)(*user);
+    size_t tx;
+    size_t rx1;
+    size_t rx2;
+    size_t i;
+
+    for(i=0U; i < 3U; i++){
+
+        tx = transmit(self, 868100000UL, LDL_SF_7);
+
+        hold(self);
+
+        rx1 = receive(self, 868100000UL, LDL_SF_7);
+
+        hold(self);
+
+        rx2 = receive(self, 869525000UL, LDL_SF_12);
+
+        mock_chip_go(self, LDL_RADIO_MODE_SLEEP);
+
+        /* was 18, 16 and 16 when every register was written */
+        if(i == 0U){
+
+            assert_int_equal(13U, tx);
+            assert_int_equal(8U, rx1);
+        }
+        else{
+
+            assert_int_equal(10U, tx);
+            assert_int_equal(6U, rx1);
+        }
+
+        assert_int_equal(6U, rx2);
+    }
+}
+
+static void frequency_shall_be_written_in_one_transaction(void **user)
+{
+    struct ldl_radio *self = (struct ldl_radio *)(*user);
+    size_t i;
+    size_t found = 0U;
+
+    mock_chip_go(self, LDL_RADIO_MODE_RX);
+
+    (void)receive(self, 868100000UL, LDL_SF_7);
+
+    for(i=0U; i < chip.count; i++){
+
+        found += (chip.writes[i] == REG_FRF_MSB) ? 1U : 0U;
+
+        assert_int_not_equal(REG_FRF_MSB + 1U, chip.writes[i]);
+        assert_int_not_equal(REG_FRF_MSB + 2U, chip.writes[i]);
+    }
+
+    assert_int_equal(1U, found);
+
+    /* 868.1MHz */
+    assert_int_equal(0xd9U, chip.regs[REG_FRF_MSB]);
+    assert_int_equal(0x06U, chip.regs[REG_FRF_MSB + 1U]);
+    assert_int_equal(0x66U, chip.regs[REG_FRF_MSB + 2U]);
+}
+
+static void frequency_lsb_shall_be_written_when_frequency_changes(void **user)
+{
+    struct ldl_radio *self = (struct ldl_radio *)(*user);
+    size_t i;
+    size_t found = 0U;
+
+    mock_chip_go(self, LDL_RADIO_MODE_RX);
+
+    /* US915 channel n */
+    (void)receive(self, 902300000UL, LDL_SF_7);
+
+    assert_int_equal(0xe1U, chip.regs[REG_FRF_MSB]);
+    assert_int_equal(0x93U, chip.regs[REG_FRF_MSB + 1U]);
+    assert_int_equal(0x33U, chip.regs[REG_FRF_MSB + 2U]);
+
+    /* so that a write of the same value shows */
+    chip.regs[REG_FRF_MSB + 2U] = 0U;
+
+    hold(self);
+
+    /* channel n+5 only differs in RegFrfMid but the chip only
+     * applies the new frequency when RegFrfLsb is written */
+    (void)receive(self, 903300000UL, LDL_SF_7);
+
+    for(i=0U; i < chip.count; i++){
+
+        found += (chip.writes[i] == (REG_FRF_MSB + 1U)) ? 1U : 0U;
+
+        assert_int_not_equal(REG_FRF_MSB, chip.writes[i]);
+        assert_int_not_equal(REG_FRF_MSB + 2U, chip.writes[i]);
+    }
+
+    assert_int_equal(1U, found);
+
+    assert_int_equal(0xe1U, chip.regs[REG_FRF_MSB]);
+    assert_int_equal(0xd3U, chip.regs[REG_FRF_MSB + 1U]);
+    assert_int_equal(0x33U, chip.regs[REG_FRF_MSB + 2U]);
+}
+
+static void unchanged_registers_shall_not_be_written(void **user)
+{
+    struct ldl_radio *self = (struct ldl_radio *)(*user);
+
+    mock_chip_go(self, LDL_RADIO_MODE_RX);
+
+    (void)receive(self, 868100000UL, LDL_SF_7);
+
+    /* interrupts, FIFO pointer and RX */
+    assert_int_equal(3U, receive(self, 868100000UL, LDL_SF_7));
+    assert_int_equal(REG_OP_MODE, chip.writes[chip.count - 1U]);
+}
+
+static void reset_shall_forget_registers(void **user)
+{
+    struct ldl_radio *self = (struct ldl_radio *)(*user);
+    size_t before;
+
+    mock_chip_go(self, LDL_RADIO_MODE_RX);
+
+    before = receive(self, 868100000UL, LDL_SF_7);
+
+    mock_chip_go(self, LDL_RADIO_MODE_RESET);
+    mock_chip_go(self, LDL_RADIO_MODE_BOOT);
+    mock_chip_go(self, LDL_RADIO_MODE_SLEEP);
+    mock_chip_go(self, LDL_RADIO_MODE_RX);
+
+    assert_int_equal(before, receive(self, 868100000UL, LDL_SF_7));
+    assert_int_equal(REG_MODEM_CONFIG1, chip.writes[0]);
+}
+
+static void start_transmit_shall_only_write_op_mode(void **user)
+{
+    struct ldl_radio *self = (struct ldl_radio *)(*user);
+    size_t tx;
+
+    (void)transmit(self, 868100000UL, LDL_SF_7);
+
+    mock_chip_go(self, LDL_RADIO_MODE_SLEEP);
+
+    tx = transmit(self, 868100000UL, LDL_SF_7);
+
+    mock_chip_go(self, LDL_RADIO_MODE_SLEEP);
+
+    /* the same work split in two */
+    assert_int_equal(tx - 1U, prepare(self, 868100000UL, LDL_SF_7));
+    assert_int_equal(1U, start(self));
+    assert_int_equal(REG_OP_MODE, chip.writes[0]);
+
+    /* nothing is prepared now */
+    assert_int_equal(0U, start(self));
+}
+
+static void start_transmit_shall_do_nothing_if_prepare_failed(void **user)
+{
+    struct ldl_radio *self = (struct ldl_radio *)(*user);
+    size_t tx;
+
+    tx = prepare(self, 868100000UL, LDL_SF_7);
+
+    mock_chip_go(self, LDL_RADIO_MODE_SLEEP);
+
+    chip.fail = true;
+
+    (void)prepare(self, 868100000UL, LDL_SF_7);
+
+    chip.fail = false;
+
+    assert_int_equal(0U, start(self));
+
+    /* nothing written before the failure is assumed to be there */
+    mock_chip_go(self, LDL_RADIO_MODE_SLEEP);
+
+    assert_int_equal(tx, prepare(self, 868100000UL, LDL_SF_7));
+    assert_int_equal(1U, start(self));
+}
+
+int main(void)
+{
+    const struct CMUnitTest tests[] = {
+        cmocka_unit_test_setup(transactions_shall_be_fewer_for_a_tx_rx1_rx2_cycle, setup),
+        cmocka_unit_test_setup(frequency_shall_be_written_in_one_transaction, setup),
+        cmocka_unit_test_setup(frequency_lsb_shall_be_written_when_frequency_changes, setup),
+        cmocka_unit_test_setup(unchanged_registers_shall_not_be_written, setup),
+        cmocka_unit_test_setup(reset_shall_forget_registers, setup),
+        cmocka_unit_test_setup(start_transmit_shall_only_write_op_mode, setup),
+        cmocka_unit_test_setup(start_transmit_shall_do_nothing_if_prepare_failed, setup),
+    };
+
+    trace_desc = stderr;
+
+    return cmocka_run_group_tests(tests, NULL, NULL);
+}
@@ -13,6 +13,17 @@
 
 extern uint32_t system_time;
 
+#ifdef LDL_ENABLE_TICKS_64
+static uint64_t system_time64;
+
+static uint64_t ticks64(void *app)
+{
+    (void)app;
+
+    return system_time64;
+}
+#endif
+
 /* setups */
 
 static int setup(void **user)
@@ -103,6 +114,73 @@ static void timerCheck_shall_return_true_and_error_after_time_moves_forward(void
     assert_int_equal(2, error);
 }
 
+static void timerCheck_shall_handle_counter_wrap(void **user)
+{
+    struct ldl_mac *self = (struct ldl_mac *)(*user);
+    uint32_t error;
+
+    system_time = UINT32_MAX - 1U;
+
+    LDL_MAC_timerSet(self, LDL_TIMER_WAITA, 4U);
+
+    system_time += 3U;
+
+    assert_false( LDL_MAC_timerCheck(self, LDL_TIMER_WAITA, &error) );
+    assert_int_equal( 1, LDL_MAC_timerTicksUntil(self, LDL_TIMER_WAITA, &error) );
+
+    system_time++;
+
+    assert_true( LDL_MAC_timerCheck(self, LDL_TIMER_WAITA, &error) );
+    assert_int_equal(0, error);
+}
+
+#ifdef LDL_ENABLE_TICKS_64
+static void timerCheck_shall_report_lag_beyond_int32_max(void **user)
+{
+    struct ldl_mac *self = (struct ldl_mac *)(*user);
+    uint32_t error;
+    int i;
+
+    system_time = 0U;
+
+    LDL_MAC_timerSet(self, LDL_TIMER_WAITA, 0U);
+
+    /* the counter has to be read at least once per wrap */
+    for(i=0; i < 3; i++){
+
+        system_time += 0x40000000UL;
+
+        LDL_MAC_timerSet(self, LDL_TIMER_WAITB, 0U);
+    }
+
+    assert_true( LDL_MAC_timerCheck(self, LDL_TIMER_WAITA, &error) );
+    assert_int_equal( 0xc0000000UL, error );
+}
+
+static void timerCheck_shall_use_ticks64(void **user)
+{
+    struct ldl_mac *self = (struct ldl_mac *)(*user);
+    uint32_t error;
+
+    self->ticks = NULL;
+    self->ticks64 = ticks64;
+
+    system_time64 = 0x4ffffffffULL;
+
+    LDL_MAC_timerSet(self, LDL_TIMER_WAITA, 2U);
+
+    system_time64++;
+
+    assert_false( LDL_MAC_timerCheck(self, LDL_TIMER_WAITA, &error) );
+    assert_int_equal( 1, LDL_MAC_timerTicksUntilNext(self) );
+
+    system_time64++;
+
+    assert_true( LDL_MAC_timerCheck(self, LDL_TIMER_WAITA, &error) );
+    assert_int_equal(0, error);
+}
+#endif
+
 /* timerTicksUntil ********************************************************/
 
 static void timerTicksUntil_shall_return_max_for_never(void **user)
@@ -163,6 +241,120 @@ static void timerTicksUntilNext_shall_return_positive_for_future(void **user)
     assert_int_equal( 42, LDL_MAC_timerTicksUntilNext(self) );
 }
 
+static void timerTicksUntilNext_shall_return_soonest(void **user)
+{
+    struct ldl_mac *self = (struct ldl_mac *)(*user);
+
+    LDL_MAC_timerSet(self, LDL_TIMER_WAITA, 42);
+    LDL_MAC_timerSet(self, LDL_TIMER_WAITB, 7);
+    LDL_MAC_timerSet(self, LDL_TIMER_BAND, 100);
+
+    assert_int_equal( 7, LDL_MAC_timerTicksUntilNext(self) );
+}
+
+static void timerTicksUntilNext_shall_follow_clear(void **user)
+{
+    struct ldl_mac *self = (struct ldl_mac *)(*user);
+
+    LDL_MAC_timerSet(self, LDL_TIMER_WAITA, 42);
+    LDL_MAC_timerSet(self, LDL_TIMER_WAITB, 7);
+
+    LDL_MAC_timerClear(self, LDL_TIMER_WAITB);
+
+    assert_int_equal( 42, LDL_MAC_timerTicksUntilNext(self) );
+
+    LDL_MAC_timerClear(self, LDL_TIMER_WAITA);
+
+    assert_int_equal( UINT32_MAX, LDL_MAC_timerTicksUntilNext(self) );
+}
+
+static void timerTicksUntilNext_shall_follow_append(void **user)
+{
+    struct ldl_mac *self = (struct ldl_mac *)(*user);
+
+    LDL_MAC_timerSet(self, LDL_TIMER_WAITA, 42);
+    LDL_MAC_timerSet(self, LDL_TIMER_WAITB, 7);
+
+    LDL_MAC_timerAppend(self, LDL_TIMER_WAITB, 100);
+
+    assert_int_equal( 42, LDL_MAC_timerTicksUntilNext(self) );
+}
+
+static void timerTicksUntilNext_shall_follow_check(void **user)
+{
+    struct ldl_mac *self = (struct ldl_mac *)(*user);
+    uint32_t error;
+
+    LDL_MAC_timerSet(self, LDL_TIMER_WAITA, 42);
+    LDL_MAC_timerSet(self, LDL_TIMER_WAITB, 1);
+
+    system_time++;
+
+    assert_int_equal( 0, LDL_MAC_timerTicksUntilNext(self) );
+
+    assert_true( LDL_MAC_timerCheck(self, LDL_TIMER_WAITB, &error) );
+
+    assert_int_equal( 41, LDL_MAC_timerTicksUntilNext(self) );
+}
+
+/* priority *************************************************************/
+
+static void priority_shall_be_false_when_no_window_is_pending(void **user)
+{
+    struct ldl_mac *self = (struct ldl_mac *)(*user);
+    uint32_t deadline;
+
+    self->state = LDL_STATE_WAIT_TX;
+
+    LDL_MAC_timerSet(self, LDL_TIMER_WAITA, 0U);
+
+    assert_false( LDL_MAC_priority(self, UINT8_MAX) );
+    assert_false( LDL_MAC_priorityDeadline(self, &deadline) );
+}
+
+static void priority_shall_be_true_while_waiting_on_the_radio(void **user)
+{
+    struct ldl_mac *self = (struct ldl_mac *)(*user);
+    uint32_t deadline;
+
+    self->state = LDL_STATE_TX;
+
+    assert_true( LDL_MAC_priority(self, 0U) );
+
+    assert_true( LDL_MAC_priorityDeadline(self, &deadline) );
+    assert_int_equal( system_time, deadline );
+}
+
+static void priority_shall_follow_rx_window_timers(void **user)
+{
+    struct ldl_mac *self = (struct ldl_mac *)(*user);
+    uint32_t deadline;
+    uint32_t start = system_time;
+
+    self->state = LDL_STATE_WAIT_RX1;
+
+    LDL_MAC_timerSet(self, LDL_TIMER_WAITA, 1500000UL);
+    LDL_MAC_timerSet(self, LDL_TIMER_WAITB, 2500000UL);
+
+    assert_false( LDL_MAC_priority(self, 1U) );
+    assert_true( LDL_MAC_priority(self, 2U) );
+
+    assert_true( LDL_MAC_priorityDeadline(self, &deadline) );
+    assert_int_equal( start + 1500000UL, deadline );
+
+    /* RX1 missed */
+    self->state = LDL_STATE_WAIT_RX2;
+
+    assert_false( LDL_MAC_priority(self, 2U) );
+
+    assert_true( LDL_MAC_priorityDeadline(self, &deadline) );
+    assert_int_equal( start + 2500000UL, deadline );
+
+    system_time += 500000UL;
+
+    assert_true( LDL_MAC_priority(self, 2U) );
+}
+
 /* runner */
 
 int main(void)
@@ -195,6 +387,20 @@ int main(void)
             timerCheck_shall_return_true_only_first_time_only,
             setup
         ),
+        cmocka_unit_test_setup(
+            timerCheck_shall_handle_counter_wrap,
+            setup
+        ),
+#ifdef LDL_ENABLE_TICKS_64
+        cmocka_unit_test_setup(
+            timerCheck_shall_report_lag_beyond_int32_max,
+            setup
+        ),
+        cmocka_unit_test_setup(
+            timerCheck_shall_use_ticks64,
+            setup
+        ),
+#endif
 
 
         /* timerTicksUntil *************************************************/
@@ -225,6 +431,34 @@ int main(void)
         cmocka_unit_test_setup(
             timerTicksUntilNext_shall_return_positive_for_future,
             setup
+        ),
+        cmocka_unit_test_setup(
+            timerTicksUntilNext_shall_return_soonest,
+            setup
+        ),
+        cmocka_unit_test_setup(
+            timerTicksUntilNext_shall_follow_clear,
+            setup
+        ),
+        cmocka_unit_test_setup(
+            timerTicksUntilNext_shall_follow_append,
+            setup
+        ),
+        cmocka_unit_test_setup(
+            timerTicksUntilNext_shall_follow_check,
+            setup
+        ),
+        cmocka_unit_test_setup(
+            priority_shall_be_false_when_no_window_is_pending,
+            setup
+        ),
+        cmocka_unit_test_setup(
+            priority_shall_be_true_while_waiting_on_the_radio,
+            setup
+        ),
+        cmocka_unit_test_setup(
+            priority_shall_follow_rx_window_timers,
+            setup
         )
     };
 
@@ -0,0 +1,268 @@
+#include <stdarg.h>
+#include <stddef.h>
+#include <setjmp.h>
+
+#include "cmocka.h"
+
+#include "debug_include.h"
+
+#include "ldl_mac.h"
+#include "ldl_radio.h"
+#include "ldl_region.h"
+#include "ldl_sm.h"
+#include "mock_ldl_system.h"
+
+#include <string.h>
+
+extern uint32_t system_time;
+
+/* the MAC loads the radio with prepare_transmit() while the XTAL starts
+ * and fires it with start_transmit() when TIMER_A expires
+ *
+ * the radio here behaves like the drivers: a change of mode discards
+ * whatever was prepared and start_transmit() does nothing unless
+ * something is prepared
+ *
+ * */
+
+static const uint8_t payload[] = "hello world";
+
+static struct ldl_sm sm;
+static struct ldl_mac *mac;
+
+static struct {
+
+    bool prepared;
+
+    size_t prepares;
+    enum ldl_mac_state prepare_state;
+    uint32_t prepare_time;
+    struct ldl_radio_tx_setting prepare_setting;
+    uint8_t prepare_len;
+
+    size_t starts;
+    enum ldl_mac_state start_state;
+    uint32_t start_time;
+
+    /* started with something prepared */
+    size_t started;
+
+    size_t transmits;
+
+} radio;
+
+static void set_mode(struct ldl_radio *self, enum ldl_radio_mode mode)
+{
+    (void)self;
+    (void)mode;
+
+    radio.prepared = false;
+}
+
+static void transmit(struct ldl_radio *self, const struct ldl_radio_tx_setting *settings, const void *data, uint8_t len)
+{
+    (void)self;
+    (void)settings;
+    (void)data;
+    (void)len;
+
+    radio.transmits++;
+}
+
+static void prepare_transmit(struct ldl_radio *self, const struct ldl_radio_tx_setting *settings, const void *data, uint8_t len)
+{
+    (void)self;
+    (void)data;
+
+    radio.prepared = true;
+    radio.prepares++;
+    radio.prepare_state = mac->state;
+    radio.prepare_time = system_time;
+    radio.prepare_setting = *settings;
+    radio.prepare_len = len;
+}
+
+static void start_transmit(struct ldl_radio *self)
+{
+    (void)self;
+
+    radio.starts++;
+    radio.start_state = mac->state;
+    radio.start_time = system_time;
+
+    if(radio.prepared){
+
+        radio.started++;
+    }
+
+    radio.prepared = false;
+}
+
+static const struct ldl_radio_interface radio_interface = {
+    .set_mode = set_mode,
+    .transmit = transmit,
+    .prepare_transmit = prepare_transmit,
+    .start_transmit = start_transmit
+};
+
+/* prepare_transmit without start_transmit is not two-phase */
+static const struct ldl_radio_interface radio_interface_without_start = {
+    .set_mode = set_mode,
+    .transmit = transmit,
+    .prepare_transmit = prepare_transmit
+};
+
+static void setup(struct ldl_mac *self, const struct ldl_radio_interface *interface)
+{
+    struct ldl_mac_init_arg arg;
+
+    (void)memset(&arg, 0, sizeof(arg));
+    (void)memset(&radio, 0, sizeof(radio));
+
+    system_time = 0U;
+    mac = self;
+
+    arg.radio_interface = interface;
+    arg.sm = &sm;
+    arg.sm_interface = LDL_SM_getInterface();
+    arg.ticks = LDL_System_ticks;
+    arg.tps = 1000000UL;
+
+    LDL_MAC_init(self, LDL_EU_863_870, &arg);
+
+    /* pretend to have booted, joined and waited out the startup delay */
+    self->ctx.joined = true;
+    self->band[LDL_BAND_GLOBAL] = 0U;
+    self->state = LDL_STATE_IDLE;
+}
+
+/* process events until the MAC reaches state */
+static void run_until(struct ldl_mac *self, enum ldl_mac_state state)
+{
+    uint8_t i;
+
+    for(i=0U; (self->state != state) && (i < 20U); i++){
+
+        system_time += LDL_MAC_ticksUntilNextEvent(self);
+
+        LDL_MAC_process(self);
+    }
+
+    assert_int_equal(state, self->state);
+}
+
+/* tests **************************************************************/
+
+static void prepare_shall_happen_once_while_the_radio_starts(void **user)
+{
+    struct ldl_mac self;
+
+    (void)user;
+
+    setup(&self, &radio_interface);
+
+    assert_int_equal(LDL_STATUS_OK, LDL_MAC_unconfirmedData(&self, 1U, payload, sizeof(payload) - 1U, NULL));
+
+    run_until(&self, LDL_STATE_START_RADIO_FOR_TX);
+
+    assert_int_equal(1U, radio.prepares);
+    assert_int_equal(LDL_STATE_START_RADIO_FOR_TX, radio.prepare_state);
+    assert_int_equal(self.bufferLen, radio.prepare_len);
+    assert_int_equal(0U, radio.starts);
+
+    run_until(&self, LDL_STATE_TX);
+
+    assert_int_equal(1U, radio.prepares);
+    assert_int_equal(0U, radio.transmits);
+}
+
+static void start_shall_follow_on_timer_a_with_the_same_settings(void **user)
+{
+    struct ldl_mac self;
+    enum ldl_spreading_factor sf;
+    enum ldl_signal_bandwidth bw;
+    uint8_t mtu;
+
+    (void)user;
+
+    setup(&self, &radio_interface);
+
+    assert_int_equal(LDL_STATUS_OK, LDL_MAC_unconfirmedData(&self, 1U, payload, sizeof(payload) - 1U, NULL));
+
+    run_until(&self, LDL_STATE_TX);
+
+    /* started from START_RADIO_FOR_TX once the XTAL has had time */
+    assert_int_equal(1U, radio.starts);
+    assert_int_equal(1U, radio.started);
+    assert_int_equal(LDL_STATE_START_RADIO_FOR_TX, radio.start_state);
+    assert_true((radio.start_time - radio.prepare_time) >= (LDL_PARAM_XTAL_DELAY * 1000UL));
+
+    /* what was prepared is what the MAC accounted for at TX */
+    LDL_Region_convertRate(self.ctx.region, self.tx.rate, &sf, &bw, &mtu);
+
+    assert_int_equal(self.tx.freq, radio.prepare_setting.freq);
+    assert_int_equal(sf, radio.prepare_setting.sf);
+    assert_int_equal(bw, radio.prepare_setting.bw);
+    assert_int_equal(self.bufferLen, radio.prepare_len);
+}
+
+static void mode_change_shall_discard_what_was_prepared(void **user)
+{
+    struct ldl_mac self;
+
+    (void)user;
+
+    setup(&self, &radio_interface);
+
+    assert_int_equal(LDL_STATUS_OK, LDL_MAC_unconfirmedData(&self, 1U, payload, sizeof(payload) - 1U, NULL));
+
+    run_until(&self, LDL_STATE_START_RADIO_FOR_TX);
+
+    /* the radio is reset before TIMER_A */
+    LDL_MAC_cancel(&self);
+
+    run_until(&self, LDL_STATE_IDLE);
+
+    assert_int_equal(0U, radio.starts);
+
+    /* the next uplink is prepared again rather than firing the old one */
+    assert_int_equal(LDL_STATUS_OK, LDL_MAC_unconfirmedData(&self, 1U, payload, 1U, NULL));
+
+    run_until(&self, LDL_STATE_TX);
+
+    assert_int_equal(2U, radio.prepares);
+    assert_int_equal(1U, radio.starts);
+    assert_int_equal(1U, radio.started);
+    assert_int_equal(self.bufferLen, radio.prepare_len);
+    assert_int_equal(0U, radio.transmits);
+}
+
+static void radio_without_start_shall_transmit_on_timer_a(void **user)
+{
+    struct ldl_mac self;
+
+    (void)user;
+
+    setup(&self, &radio_interface_without_start);
+
+    assert_int_equal(LDL_STATUS_OK, LDL_MAC_unconfirmedData(&self, 1U, payload, sizeof(payload) - 1U, NULL));
+
+    run_until(&self, LDL_STATE_TX);
+
+    assert_int_equal(0U, radio.prepares);
+    assert_int_equal(1U, radio.transmits);
+}
+
+int main(void)
+{
+    const struct CMUnitTest tests[] = {
+        cmocka_unit_test(prepare_shall_happen_once_while_the_radio_starts),
+        cmocka_unit_test(start_shall_follow_on_timer_a_with_the_same_settings),
+        cmocka_unit_test(mode_change_shall_discard_what_was_prepared),
+        cmocka_unit_test(radio_without_start_shall_transmit_on_timer_a),
+    };
+
+    trace_desc = stderr;
+
+    return cmocka_run_group_tests(tests, NULL, NULL);
+}
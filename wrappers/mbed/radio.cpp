@@ -46,6 +46,27 @@ Radio::_interrupt_handler(struct ldl_mac *self)
 
 /* protected **********************************************************/
 
+void
+Radio::record_busy_wait(std::chrono::microseconds elapsed, bool timeout)
+{
+    uint32_t us = (elapsed.count() > INT32_MAX) ? INT32_MAX : uint32_t(elapsed.count());
+    size_t n = 0U;
+
+    while((n < (sizeof(busy_stats.bucket)/sizeof(*busy_stats.bucket) - 1U)) && (us >= (16UL << (2U * n)))){
+
+        n++;
+    }
+
+    core_util_critical_section_enter();
+
+    busy_stats.waits++;
+    busy_stats.timeouts += timeout ? 1U : 0U;
+    busy_stats.max_us = (us > busy_stats.max_us) ? us : busy_stats.max_us;
+    busy_stats.total_us += us;
+    busy_stats.bucket[n]++;
+
+    core_util_critical_section_exit();
+}
 
 /* public *************************************************************/
 
@@ -55,6 +76,30 @@ Radio::set_event_handler(Callback<void()> handler)
     event_cb = handler;
 }
 
+BusyStats
+Radio::get_busy_stats()
+{
+    BusyStats retval;
+
+    core_util_critical_section_enter();
+
+    retval = busy_stats;
+
+    core_util_critical_section_exit();
+
+    return retval;
+}
+
+void
+Radio::reset_busy_stats()
+{
+    core_util_critical_section_enter();
+
+    busy_stats = {};
+
+    core_util_critical_section_exit();
+}
+
 Radio *
 Radio::get_state()
 {
@@ -28,6 +28,23 @@
 
 namespace LDL {
 
+    /**
+     * Time spent waiting for the transceiver BUSY line
+     *
+     * A wait is counted in bucket[n] when it was shorter than
+     * (16 << (2 * n)) microseconds. The last bucket also counts
+     * anything longer.
+     *
+     * */
+    struct BusyStats {
+
+        uint32_t waits;         /**< number of waits */
+        uint32_t timeouts;      /**< number of waits that gave up */
+        uint32_t max_us;        /**< longest wait */
+        uint64_t total_us;      /**< sum of all waits */
+        uint32_t bucket[8];     /**< distribution of waits */
+    };
+
     /**
      * Radio driver base class
      *
@@ -45,10 +62,24 @@ namespace LDL {
 
             static void _interrupt_handler(struct ldl_mac *self);
 
+            BusyStats busy_stats = {};
+
+            void record_busy_wait(std::chrono::microseconds elapsed, bool timeout);
+
         public:
 
             void set_event_handler(Callback<void()> handler);
 
+            /** Get BUSY wait statistics
+             *
+             * Use get_state()->get_busy_stats() on pre-configured
+             * radios. Radios without a BUSY line do not count anything.
+             *
+             * */
+            BusyStats get_busy_stats();
+
+            void reset_busy_stats();
+
             virtual Radio *get_state();
             virtual const struct ldl_radio_interface *get_interface() = 0;
     };
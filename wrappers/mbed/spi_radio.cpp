@@ -25,6 +25,11 @@
 
 using namespace LDL;
 
+static const uint32_t BUSY_FLAG = 1U;
+
+static const std::chrono::microseconds BUSY_SPIN(MBED_CONF_LDL_BUSY_SPIN);
+static const std::chrono::microseconds BUSY_TIMEOUT = 1s;
+
 const struct ldl_radio_interface SPIRadio::_interface = {
     .set_mode = SPIRadio::_set_mode,
     .read_entropy = SPIRadio::_read_entropy,
@@ -32,7 +37,9 @@ const struct ldl_radio_interface SPIRadio::_interface = {
     .transmit = SPIRadio::_transmit,
     .receive = SPIRadio::_receive,
     .receive_entropy = SPIRadio::_receive_entropy,
-    .get_status = SPIRadio::_get_status
+    .get_status = SPIRadio::_get_status,
+    .prepare_transmit = SPIRadio::_prepare_transmit,
+    .start_transmit = SPIRadio::_start_transmit
 };
 
 /* constructors *******************************************************/
@@ -46,9 +53,16 @@ SPIRadio::SPIRadio(
     Radio(),
     spi(spi),
     nss(nss, 1),
-    busy(busy)
+    busy(busy),
+    has_busy(busy != NC),
+    asleep(false)
 {
     timer.start();
+
+    if(has_busy){
+
+        this->busy.fall(callback(this, &SPIRadio::busy_handler));
+    }
 }
 
 /* static protected ***************************************************/
@@ -89,6 +103,18 @@ SPIRadio::_transmit(struct ldl_radio *self, const struct ldl_radio_tx_setting *s
     to_radio(self)->transmit(settings, data, len);
 }
 
+void
+SPIRadio::_prepare_transmit(struct ldl_radio *self, const struct ldl_radio_tx_setting *settings, const void *data, uint8_t len)
+{
+    to_radio(self)->prepare_transmit(settings, data, len);
+}
+
+void
+SPIRadio::_start_transmit(struct ldl_radio *self)
+{
+    to_radio(self)->start_transmit();
+}
+
 void
 SPIRadio::_receive(struct ldl_radio *self, const struct ldl_radio_rx_setting *settings)
 {
@@ -142,70 +168,112 @@ SPIRadio::chip_select(bool state)
     }
 }
 
-bool
-SPIRadio::chip_write(const void *opcode, size_t opcode_size, const void *data, size_t size)
+void
+SPIRadio::busy_handler()
 {
-    bool retval = false;
+    busy_flags.set(BUSY_FLAG);
+}
 
-    timer.reset();
+void
+SPIRadio::wake()
+{
+    /* a sleeping radio holds BUSY until it sees NSS fall */
+    if(has_busy && asleep){
 
-    chip_select(true);
+        chip_select(true);
+        chip_select(false);
 
-    while(!retval){
+        asleep = false;
+    }
+}
 
-        if(!busy || (busy.read() == 0)){
+bool
+SPIRadio::wait_busy()
+{
+    bool retval = true;
+    std::chrono::microseconds elapsed;
 
-            spi.write((const char *)opcode, opcode_size, nullptr, 0);
+    if(has_busy){
 
-            spi.write((const char *)data, size, nullptr, 0);
+        timer.reset();
 
-            retval = true;
-        }
-        else if(timer.elapsed_time() > 1s){
+        /* BUSY is often released within a few microseconds */
+        while((busy.read() == 1) && (timer.elapsed_time() < BUSY_SPIN)){
 
-            break;
+            /* loop */
         }
-        else{
 
-            /* loop */
+        /* after SetTx/SetRx or calibration it can be milliseconds
+         * so sleep until the falling edge */
+        while(busy.read() == 1){
+
+            elapsed = timer.elapsed_time();
+
+            if(elapsed > BUSY_TIMEOUT){
+
+                retval = false;
+                break;
+            }
+
+            busy_flags.clear(BUSY_FLAG);
+
+            /* the edge may have come before the flag was cleared */
+            if(busy.read() == 1){
+
+                (void)busy_flags.wait_any_for(BUSY_FLAG, std::chrono::duration_cast<Kernel::Clock::duration_u32>(BUSY_TIMEOUT - elapsed) + 1ms);
+            }
         }
-    }
 
-    chip_select(false);
+        record_busy_wait(timer.elapsed_time(), !retval);
+    }
 
     return retval;
 }
 
 bool
-SPIRadio::chip_read(const void *opcode, size_t opcode_size, void *data, size_t size)
+SPIRadio::chip_write(const void *opcode, size_t opcode_size, const void *data, size_t size)
 {
-    bool retval = false;
+    bool retval;
 
-    timer.reset();
+    wake();
 
-    chip_select(true);
+    /* wait with NSS high and the bus free for other devices */
+    retval = wait_busy();
 
-    while(!retval){
+    if(retval){
 
-        if(!busy || (busy.read() == 0)){
+        chip_select(true);
 
-            spi.write((const char *)opcode, opcode_size, nullptr, 0);
+        spi.write((const char *)opcode, opcode_size, nullptr, 0);
 
-            spi.write(nullptr, 0, (char *)data, size);
+        spi.write((const char *)data, size, nullptr, 0);
 
-            retval = true;
-        }
-        else if(timer.elapsed_time() > 1s){
+        chip_select(false);
+    }
 
-            break;
-        }
-        else{
+    return retval;
+}
 
-            /* loop */
-        }
-    }
+bool
+SPIRadio::chip_read(const void *opcode, size_t opcode_size, void *data, size_t size)
+{
+    bool retval;
 
-    chip_select(false);
+    wake();
+
+    /* wait with NSS high and the bus free for other devices */
+    retval = wait_busy();
+
+    if(retval){
+
+        chip_select(true);
+
+        spi.write((const char *)opcode, opcode_size, nullptr, 0);
+
+        spi.write(nullptr, 0, (char *)data, size);
+
+        chip_select(false);
+    }
 
     return retval;
 }
@@ -230,6 +298,18 @@ SPIRadio::transmit(const struct ldl_radio_tx_setting *settings, const void *data
     internal_if->transmit(&radio, settings, data, len);
 }
 
+void
+SPIRadio::prepare_transmit(const struct ldl_radio_tx_setting *settings, const void *data, uint8_t len)
+{
+    internal_if->prepare_transmit(&radio, settings, data, len);
+}
+
+void
+SPIRadio::start_transmit()
+{
+    internal_if->start_transmit(&radio);
+}
+
 void
 SPIRadio::receive(const struct ldl_radio_rx_setting *settings)
 {
@@ -97,9 +97,11 @@ SX126X::chip_set_mode(enum ldl_chip_mode mode)
     switch(mode){
     case LDL_CHIP_MODE_RESET:
         reset.output();
+        asleep = true;
         break;
     case LDL_CHIP_MODE_SLEEP:
         reset.input();
+        asleep = true;
         break;
     default:
         break;
@@ -38,7 +38,9 @@ const struct ldl_radio_interface WL55::_interface = {
     .transmit = WL55::_transmit,
     .receive = WL55::_receive,
     .receive_entropy = WL55::_receive_entropy,
-    .get_status = WL55::_get_status
+    .get_status = WL55::_get_status,
+    .prepare_transmit = WL55::_prepare_transmit,
+    .start_transmit = WL55::_start_transmit
 };
 
 WL55 * WL55::instance = nullptr;
@@ -71,6 +73,7 @@ WL55::WL55(
 )
     :
     Radio(),
+    asleep(false),
     chip_mode_cb(chip_mode_cb)
 {
     timer.start();
@@ -273,6 +276,18 @@ WL55::_transmit(struct ldl_radio *self, const struct ldl_radio_tx_setting *setti
     to_radio(self)->transmit(settings, data, len);
 }
 
+void
+WL55::_prepare_transmit(struct ldl_radio *self, const struct ldl_radio_tx_setting *settings, const void *data, uint8_t len)
+{
+    to_radio(self)->prepare_transmit(settings, data, len);
+}
+
+void
+WL55::_start_transmit(struct ldl_radio *self)
+{
+    to_radio(self)->start_transmit();
+}
+
 void
 WL55::_receive(struct ldl_radio *self, const struct ldl_radio_rx_setting *settings)
 {
@@ -340,70 +355,97 @@ WL55::chip_select(bool state)
     }
 }
 
-bool
-WL55::chip_write(const void *opcode, size_t opcode_size, const void *data, size_t size)
+void
+WL55::wake()
 {
-    bool retval = false;
+    /* a sleeping radio holds BUSY until it sees NSS fall */
+    if(asleep){
 
-    timer.reset();
+        lock.lock();
+
+        LL_PWR_SelectSUBGHZSPI_NSS();
+        LL_PWR_UnselectSUBGHZSPI_NSS();
+
+        lock.unlock();
+
+        asleep = false;
+    }
+}
 
-    chip_select(true);
+bool
+WL55::wait_busy()
+{
+    bool retval = true;
+    std::chrono::microseconds elapsed;
 
-    while(!retval){
+    timer.reset();
 
-        if((LL_PWR_IsActiveFlag_RFBUSYS() & LL_PWR_IsActiveFlag_RFBUSYMS()) == 0U){
+    while((LL_PWR_IsActiveFlag_RFBUSYS() & LL_PWR_IsActiveFlag_RFBUSYMS()) != 0U){
 
-            write_spi(opcode, opcode_size);
-            write_spi(data, size);
+        elapsed = timer.elapsed_time();
 
-            retval = true;
-        }
-        else if(timer.elapsed_time() > 1s){
+        if(elapsed > 1s){
 
             LDL_ERROR("RF BUSY")
+            retval = false;
             break;
         }
-        else{
 
-            /* loop */
+        /* BUSY is often released within a few microseconds but after
+         * SetTx/SetRx or calibration it can be milliseconds */
+        if(elapsed >= std::chrono::microseconds(MBED_CONF_LDL_BUSY_SPIN)){
+
+            ThisThread::sleep_for(1ms);
         }
     }
 
-    chip_select(false);
+    record_busy_wait(timer.elapsed_time(), !retval);
 
     return retval;
 }
 
 bool
-WL55::chip_read(const void *opcode, size_t opcode_size, void *data, size_t size)
+WL55::chip_write(const void *opcode, size_t opcode_size, const void *data, size_t size)
 {
-    bool retval = false;
+    bool retval;
 
-    timer.reset();
+    wake();
 
-    chip_select(true);
+    /* wait with NSS high and the lock free for other threads */
+    retval = wait_busy();
 
-    while(!retval){
+    if(retval){
 
-        if((LL_PWR_IsActiveFlag_RFBUSYS() & LL_PWR_IsActiveFlag_RFBUSYMS()) == 0U){
+        chip_select(true);
 
-            write_spi(opcode, opcode_size);
-            read_spi(data, size);
+        write_spi(opcode, opcode_size);
+        write_spi(data, size);
 
-            retval = true;
-        }
-        else if(timer.elapsed_time() > 1s){
+        chip_select(false);
+    }
 
-            LDL_ERROR("RF BUSY")
-            break;
-        }
-        else{
+    return retval;
+}
 
-            /* loop */
-        }
-    }
+bool
+WL55::chip_read(const void *opcode, size_t opcode_size, void *data, size_t size)
+{
+    bool retval;
+
+    wake();
 
-    chip_select(false);
+    /* wait with NSS high and the lock free for other threads */
+    retval = wait_busy();
+
+    if(retval){
+
+        chip_select(true);
+
+        write_spi(opcode, opcode_size);
+        read_spi(data, size);
+
+        chip_select(false);
+    }
 
     return retval;
 }
@@ -414,9 +456,11 @@ WL55::chip_set_mode(enum ldl_chip_mode mode)
     switch(mode){
     case LDL_CHIP_MODE_RESET:
         LL_RCC_RF_EnableReset();
+        asleep = true;
         break;
     case LDL_CHIP_MODE_SLEEP:
         LL_RCC_RF_DisableReset();
+        asleep = true;
         break;
     case LDL_CHIP_MODE_STANDBY:
         break;
@@ -456,6 +500,18 @@ WL55::transmit(const struct ldl_radio_tx_setting *settings, const void *data, ui
     internal_if->transmit(&radio, settings, data, len);
 }
 
+void
+WL55::prepare_transmit(const struct ldl_radio_tx_setting *settings, const void *data, uint8_t len)
+{
+    internal_if->prepare_transmit(&radio, settings, data, len);
+}
+
+void
+WL55::start_transmit()
+{
+    internal_if->start_transmit(&radio);
+}
+
 void
 WL55::receive(const struct ldl_radio_rx_setting *settings)
 {
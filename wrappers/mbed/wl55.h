@@ -42,6 +42,7 @@ namespace LDL {
         protected:
 
             LowPowerTimer timer;
+            bool asleep;
 
             struct ldl_radio radio;
             const struct ldl_radio_interface *internal_if;
@@ -56,6 +57,8 @@ namespace LDL {
             static uint32_t _read_entropy(struct ldl_radio *self);
             static uint8_t _read_buffer(struct ldl_radio *self, struct ldl_radio_packet_metadata *meta, void *data, uint8_t max);
             static void _transmit(struct ldl_radio *self, const struct ldl_radio_tx_setting *settings, const void *data, uint8_t len);
+            static void _prepare_transmit(struct ldl_radio *self, const struct ldl_radio_tx_setting *settings, const void *data, uint8_t len);
+            static void _start_transmit(struct ldl_radio *self);
             static void _receive(struct ldl_radio *self, const struct ldl_radio_rx_setting *settings);
             static void _interrupt_handler(struct ldl_mac *self);
             static void _set_mode(struct ldl_radio *self, enum ldl_radio_mode mode);
@@ -66,6 +69,9 @@ namespace LDL {
 
             void chip_select(bool state);
 
+            void wake();
+            bool wait_busy();
+
             bool chip_write(const void *opcode, size_t opcode_size, const void *data, size_t size);
             bool chip_read(const void *opcode, size_t opcode_size, void *data, size_t size);
             void chip_set_mode(enum ldl_chip_mode mode);
@@ -105,6 +111,8 @@ namespace LDL {
             uint32_t read_entropy();
             uint8_t read_buffer(struct ldl_radio_packet_metadata *meta, void *data, uint8_t max);
             void transmit(const struct ldl_radio_tx_setting *settings, const void *data, uint8_t len);
+            void prepare_transmit(const struct ldl_radio_tx_setting *settings, const void *data, uint8_t len);
+            void start_transmit();
             void receive(const struct ldl_radio_rx_setting *settings);
             void interrupt_handler();
             void set_mode(enum ldl_radio_mode mode);
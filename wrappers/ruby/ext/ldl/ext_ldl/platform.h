@@ -14,6 +14,9 @@
 
 #define LDL_ENABLE_TEST_MODE
 
+/* falls back to portable AES if the host doesn't support AES-NI */
+#define LDL_ENABLE_AES_NI
+
 void LDL_System_enterCriticalSection(void *app);
 void LDL_System_leaveCriticalSection(void *app);
 